@@ -0,0 +1,10 @@
+@echo off
+
+@echo.
+
+@call setenvvar.bat %*
+@if errorlevel 1 (goto :END)
+
+@%FB_BIN_DIR%\engine_bench %BENCH_ARGS%
+
+:END
@@ -1450,6 +1450,9 @@ int gbak(Firebird::UtilSvc* uSvc)
 		exit_code = FINI_ERROR;
 	}
 
+	// Stop the backup stream workers if they are still running
+	MVOL_cleanup(tdgbl);
+
 	// Close the gbak file handles if they still open
 	for (burp_fil* file = tdgbl->gbl_sw_backup_files; file; file = file->fil_next)
 	{
@@ -235,6 +235,7 @@ enum att_type {
 	att_backup_zip,			// zipped backup file
 	att_backup_hash,		// hash of crypt key
 	att_backup_crypt,		// name of crypt plugin
+	att_backup_frames,		// data are split into frames of given size
 
 	// Database attributes
 
@@ -282,6 +283,7 @@ enum att_type {
 	att_relation_type,
 	att_relation_sql_security_deprecated,	// can be removed later
 	att_relation_sql_security,
+	att_relation_ext_format, // FB6.0, ODS14_0
 
 	// Field attributes (used for both global and local fields)
 
@@ -519,6 +521,7 @@ enum att_type {
 	att_gen_sysflag,
 	att_gen_init_val,
 	att_gen_id_increment,
+	att_gen_cache, // FB6.0, ODS14_0
 
 	// Stored procedure attributes
 
@@ -929,6 +932,7 @@ const FB_UINT64 MIN_SPLIT_SIZE	= FB_CONST64(2048);		// bytes
 // Global switches and data
 
 struct BurpCrypt;
+class BurpFrames;
 
 
 class GblPool
@@ -1032,6 +1036,8 @@ public:
 	unsigned	gbl_network_protocol;
 	burp_act*	action;
 	BurpCrypt*	gbl_crypt;
+	BurpFrames*	gbl_frames;
+	ULONG		gbl_frame_size;
 	ULONG		io_buffer_size;
 	redirect_vals	sw_redirect;
 	bool		burp_throw;
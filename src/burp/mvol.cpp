@@ -87,6 +87,7 @@ static FB_UINT64 mvol_fini_read(BurpGlobals*);
 static void	 mvol_init_read(BurpGlobals*, const char*, USHORT*, int*, UCHAR**);
 static UCHAR mvol_write(const UCHAR, int*, UCHAR**);
 static const UCHAR*	mvol_write_block(BurpGlobals*, const UCHAR*, ULONG);
+static UCHAR*	mvol_read_block(BurpGlobals*, UCHAR*, ULONG);
 static FB_UINT64 mvol_fini_write(BurpGlobals*, int*, UCHAR**);
 static void	 mvol_init_write(BurpGlobals*, const char*, int*, UCHAR**);
 static void	 brio_fini(BurpGlobals*);
@@ -131,6 +132,9 @@ static ULONG crypt_read_block(BurpGlobals*, UCHAR*, FB_SIZE_T);
 static void	 zip_write_block(BurpGlobals*, const UCHAR*, FB_SIZE_T, bool);
 static ULONG unzip_read_block(BurpGlobals*, UCHAR*, FB_SIZE_T);
 
+class DbInfo;
+static Firebird::IDbCryptPlugin* load_crypt(BurpGlobals*, Firebird::RefPtr<DbInfo>&);
+
 // Portion of data passed to crypt plugin
 const ULONG CRYPT_STEP = 256;
 
@@ -173,6 +177,538 @@ struct BurpCrypt
 };
 
 
+// Backup data may be split into frames which are compressed and encrypted
+// independently of each other, so a few threads may process them at once.
+// Frame is stored as:
+//	4 bytes - length of original data
+//	4 bytes - length of stored data
+//	stored data (padded up to CRYPT_STEP when encrypted)
+// Frame with zero lengths marks the end of data.
+
+const ULONG FRAME_SIZE = 1024 * 1024;
+const ULONG FRAME_HEADER_SIZE = 2 * sizeof(ULONG);
+
+static inline void put_vax_long(UCHAR* ptr, ULONG value)
+{
+	for (unsigned i = 0; i < sizeof(ULONG); i++, value >>= 8)
+		*ptr++ = (UCHAR) value;
+}
+
+class BurpFrames
+{
+public:
+	BurpFrames(BurpGlobals* tdgbl, bool writing, bool zip, Firebird::IDbCryptPlugin* crypt);
+	~BurpFrames();
+
+	void write(BurpGlobals* tdgbl, const UCHAR* data, ULONG length, bool flush);
+	ULONG read(BurpGlobals* tdgbl, UCHAR* buffer, ULONG length);
+
+private:
+	enum FrameState { FRAME_QUEUED, FRAME_BUSY, FRAME_READY };
+
+	struct Frame
+	{
+		explicit Frame(MemoryPool& pool)
+			: raw(pool), stored(pool),
+			  state(FRAME_QUEUED), errCode(0), errArg(0)
+		{ }
+
+		Firebird::Array<UCHAR> raw;
+		Firebird::Array<UCHAR> stored;
+		Firebird::DynamicStatusVector status;
+		FrameState state;
+		USHORT errCode;
+		int errArg;
+	};
+
+	// Crypt plugins are not required to be thread-safe,
+	// so every worker thread uses its own plugin instance
+
+	struct Worker
+	{
+		explicit Worker(BurpFrames* frames)
+			: owner(frames), crypt(NULL)
+		{ }
+
+		BurpFrames* const owner;
+		Firebird::IDbCryptPlugin* crypt;
+		Firebird::RefPtr<DbInfo> dbInfo;
+		Thread::Handle handle;
+	};
+
+	static THREAD_ENTRY_DECLARE workerThread(THREAD_ENTRY_PARAM arg);
+	void worker(Worker* worker);
+
+	void process(Frame* frame, Firebird::IDbCryptPlugin* crypt);
+	void encode(Frame* frame, Firebird::IDbCryptPlugin* crypt);
+	void decode(Frame* frame, Firebird::IDbCryptPlugin* crypt);
+
+	Frame* getFrame();
+	void submit(Frame* frame);
+	Frame* takeHead();
+	void drain(BurpGlobals* tdgbl, bool all);
+	bool readFrame(BurpGlobals* tdgbl, Frame* frame);
+	void releaseWorkers();
+
+	MemoryPool& m_pool;
+	const bool m_writing;
+	const bool m_zip;
+	Firebird::IDbCryptPlugin* const m_crypt;
+	FB_SIZE_T m_maxQueue;
+
+	Firebird::HalfStaticArray<Worker*, 8> m_workers;
+	Firebird::HalfStaticArray<Frame*, 16> m_frames;		// all allocated frames
+	Firebird::HalfStaticArray<Frame*, 16> m_queue;		// frames in order of data
+	Firebird::HalfStaticArray<Frame*, 16> m_free;
+	Firebird::Mutex m_mutex;
+	Firebird::Condition m_workCond;
+	Firebird::Condition m_readyCond;
+	bool m_stop;
+
+	Frame* m_current;	// frame being filled on backup or consumed on restore
+	ULONG m_offset;		// consumed part of current frame
+	bool m_eof;
+};
+
+BurpFrames::BurpFrames(BurpGlobals* tdgbl, bool writing, bool zip, Firebird::IDbCryptPlugin* crypt)
+	: m_pool(tdgbl->getPool()),
+	  m_writing(writing),
+	  m_zip(zip),
+	  m_crypt(crypt),
+	  m_maxQueue(1),
+	  m_workers(m_pool),
+	  m_frames(m_pool),
+	  m_queue(m_pool),
+	  m_free(m_pool),
+	  m_stop(false),
+	  m_current(NULL),
+	  m_offset(0),
+	  m_eof(false)
+{
+	// With a single worker frames are processed by the main thread itself
+
+	const int workers = tdgbl->gbl_sw_par_workers;
+	if (workers <= 1)
+		return;
+
+	m_maxQueue = workers * 2;
+
+	try
+	{
+		for (int i = 0; i < workers; i++)
+		{
+			Worker* const worker = FB_NEW_POOL(m_pool) Worker(this);
+			m_workers.add(worker);
+
+			if (crypt)
+				worker->crypt = load_crypt(tdgbl, worker->dbInfo);
+		}
+	}
+	catch (const Firebird::Exception&)
+	{
+		releaseWorkers();
+		throw;
+	}
+
+	for (auto worker : m_workers)
+		Thread::start(workerThread, worker, THREAD_medium, &worker->handle);
+}
+
+BurpFrames::~BurpFrames()
+{
+	{	// scope
+		Firebird::MutexLockGuard guard(m_mutex, FB_FUNCTION);
+		m_stop = true;
+		m_workCond.notifyAll();
+	}
+
+	for (auto worker : m_workers)
+		Thread::waitForCompletion(worker->handle);
+
+	releaseWorkers();
+
+	for (auto frame : m_frames)
+		delete frame;
+}
+
+void BurpFrames::releaseWorkers()
+{
+	for (auto worker : m_workers)
+	{
+		if (worker->crypt)
+			Firebird::PluginManagerInterfacePtr()->releasePlugin(worker->crypt);
+
+		delete worker;
+	}
+
+	m_workers.clear();
+}
+
+THREAD_ENTRY_DECLARE BurpFrames::workerThread(THREAD_ENTRY_PARAM arg)
+{
+	Worker* const worker = static_cast<Worker*>(arg);
+	worker->owner->worker(worker);
+	return 0;
+}
+
+void BurpFrames::worker(Worker* worker)
+{
+	Firebird::MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	while (!m_stop)
+	{
+		Frame* frame = NULL;
+		for (auto queued : m_queue)
+		{
+			if (queued->state == FRAME_QUEUED)
+			{
+				frame = queued;
+				break;
+			}
+		}
+
+		if (!frame)
+		{
+			m_workCond.wait(m_mutex);
+			continue;
+		}
+
+		frame->state = FRAME_BUSY;
+
+		{	// scope
+			Firebird::MutexUnlockGuard unguard(m_mutex, FB_FUNCTION);
+			process(frame, worker->crypt);
+		}
+
+		frame->state = FRAME_READY;
+		m_readyCond.notifyAll();
+	}
+}
+
+void BurpFrames::process(Frame* frame, Firebird::IDbCryptPlugin* crypt)
+{
+	frame->errCode = 0;
+	frame->status.clear();
+
+	try
+	{
+		if (m_writing)
+			encode(frame, crypt);
+		else
+			decode(frame, crypt);
+	}
+	catch (const Firebird::Exception& ex)
+	{
+		FbLocalStatus status;
+		ex.stuffException(&status);
+		frame->status.load(&status);
+	}
+}
+
+void BurpFrames::encode(Frame* frame, Firebird::IDbCryptPlugin* crypt)
+{
+	const ULONG length = frame->raw.getCount();
+
+	if (m_zip)
+	{
+#ifdef HAVE_ZLIB_H
+		// Buffer is large enough to keep incompressible data
+		const ULONG bound = length + length / 8 + 64;
+		UCHAR* const ptr = frame->stored.getBuffer(bound);
+
+		z_stream strm;
+		memset(&strm, 0, sizeof(strm));
+		strm.zalloc = Firebird::ZLib::allocFunc;
+		strm.zfree = Firebird::ZLib::freeFunc;
+
+		int ret = zlib().deflateInit(&strm, Z_DEFAULT_COMPRESSION);
+		if (ret != Z_OK)
+		{
+			frame->errCode = 384;
+			frame->errArg = ret;
+			return;
+		}
+
+		strm.next_in = frame->raw.begin();
+		strm.avail_in = length;
+		strm.next_out = ptr;
+		strm.avail_out = bound;
+
+		ret = zlib().deflate(&strm, Z_FINISH);
+		zlib().deflateEnd(&strm);
+
+		if (ret != Z_STREAM_END)
+		{
+			frame->errCode = 380;
+			frame->errArg = ret;
+			return;
+		}
+
+		frame->stored.shrink(bound - strm.avail_out);
+#endif
+	}
+	else
+		frame->stored.assign(frame->raw);
+
+	if (crypt)
+	{
+		const ULONG tail = frame->stored.getCount() % CRYPT_STEP;
+		if (tail)
+			frame->stored.resize(frame->stored.getCount() + CRYPT_STEP - tail, 0);
+
+		FbLocalStatus status;
+		UCHAR* const ptr = frame->stored.begin();
+
+		for (ULONG offset = 0; offset < frame->stored.getCount(); offset += CRYPT_STEP)
+		{
+			crypt->encrypt(&status, CRYPT_STEP, ptr + offset, ptr + offset);
+			status.check();
+		}
+	}
+}
+
+void BurpFrames::decode(Frame* frame, Firebird::IDbCryptPlugin* crypt)
+{
+	const ULONG length = frame->raw.getCount();
+	UCHAR* const data = frame->stored.begin();
+
+	if (crypt)
+	{
+		if (frame->stored.getCount() % CRYPT_STEP)
+		{
+			frame->errCode = 50;	// unexpected end of file on backup file
+			return;
+		}
+
+		FbLocalStatus status;
+
+		for (ULONG offset = 0; offset < frame->stored.getCount(); offset += CRYPT_STEP)
+		{
+			crypt->decrypt(&status, CRYPT_STEP, data + offset, data + offset);
+			status.check();
+		}
+	}
+
+	if (m_zip)
+	{
+#ifdef HAVE_ZLIB_H
+		z_stream strm;
+		memset(&strm, 0, sizeof(strm));
+		strm.zalloc = Firebird::ZLib::allocFunc;
+		strm.zfree = Firebird::ZLib::freeFunc;
+
+		int ret = zlib().inflateInit(&strm);
+		if (ret != Z_OK)
+		{
+			frame->errCode = 383;
+			frame->errArg = ret;
+			return;
+		}
+
+		// Padding added by encryption follows the end of compressed stream
+		strm.next_in = data;
+		strm.avail_in = frame->stored.getCount();
+		strm.next_out = frame->raw.begin();
+		strm.avail_out = length;
+
+		ret = zlib().inflate(&strm, Z_FINISH);
+		zlib().inflateEnd(&strm);
+
+		if (ret != Z_STREAM_END || strm.avail_out)
+		{
+			frame->errCode = 379;
+			frame->errArg = ret;
+		}
+#endif
+	}
+	else if (frame->stored.getCount() < length)
+		frame->errCode = 50;
+	else
+		memcpy(frame->raw.begin(), data, length);
+}
+
+BurpFrames::Frame* BurpFrames::getFrame()
+{
+	if (m_free.hasData())
+		return m_free.pop();
+
+	Frame* const frame = FB_NEW_POOL(m_pool) Frame(m_pool);
+	m_frames.add(frame);
+	return frame;
+}
+
+void BurpFrames::submit(Frame* frame)
+{
+	if (m_workers.isEmpty())
+	{
+		process(frame, m_crypt);
+		frame->state = FRAME_READY;
+		m_queue.add(frame);
+		return;
+	}
+
+	Firebird::MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	frame->state = FRAME_QUEUED;
+	m_queue.add(frame);
+	m_workCond.notifyOne();
+}
+
+BurpFrames::Frame* BurpFrames::takeHead()
+{
+	fb_assert(m_queue.hasData());
+
+	Frame* frame;
+
+	{	// scope
+		Firebird::MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+		frame = m_queue[0];
+		while (frame->state != FRAME_READY)
+			m_readyCond.wait(m_mutex);
+
+		m_queue.remove((FB_SIZE_T) 0);
+	}
+
+	if (frame->errCode)
+		BURP_error(frame->errCode, true, SafeArg() << frame->errArg);
+
+	if (!frame->status.isSuccess())
+		Firebird::status_exception::raise(frame->status.value());
+
+	return frame;
+}
+
+void BurpFrames::drain(BurpGlobals* tdgbl, bool all)
+{
+	// Write the frames in order they were submitted. Wait for the first
+	// of them if the queue is full, otherwise write only ready ones.
+
+	while (m_queue.hasData())
+	{
+		if (!all && m_queue.getCount() < m_maxQueue)
+		{
+			Firebird::MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			if (m_queue[0]->state != FRAME_READY)
+				break;
+		}
+
+		Frame* const frame = takeHead();
+
+		UCHAR header[FRAME_HEADER_SIZE];
+		put_vax_long(header, frame->raw.getCount());
+		put_vax_long(header + sizeof(ULONG), frame->stored.getCount());
+
+		mvol_write_block(tdgbl, header, sizeof(header));
+		mvol_write_block(tdgbl, frame->stored.begin(), frame->stored.getCount());
+
+		frame->raw.clear();
+		frame->stored.clear();
+		m_free.push(frame);
+	}
+}
+
+void BurpFrames::write(BurpGlobals* tdgbl, const UCHAR* data, ULONG length, bool flush)
+{
+	while (length)
+	{
+		if (!m_current)
+			m_current = getFrame();
+
+		const ULONG n = MIN(length, FRAME_SIZE - m_current->raw.getCount());
+		m_current->raw.add(data, n);
+		data += n;
+		length -= n;
+
+		if (m_current->raw.getCount() == FRAME_SIZE)
+		{
+			submit(m_current);
+			m_current = NULL;
+			drain(tdgbl, false);
+		}
+	}
+
+	if (flush)
+	{
+		if (m_current)
+		{
+			submit(m_current);
+			m_current = NULL;
+		}
+
+		drain(tdgbl, true);
+
+		const UCHAR endMark[FRAME_HEADER_SIZE] = {0};
+		mvol_write_block(tdgbl, endMark, sizeof(endMark));
+	}
+}
+
+bool BurpFrames::readFrame(BurpGlobals* tdgbl, Frame* frame)
+{
+	UCHAR header[FRAME_HEADER_SIZE];
+	mvol_read_block(tdgbl, header, sizeof(header));
+
+	const ULONG rawLength = gds__vax_integer(header, sizeof(ULONG));
+	const ULONG storedLength = gds__vax_integer(header + sizeof(ULONG), sizeof(ULONG));
+
+	if (!rawLength && !storedLength)
+		return false;
+
+	if (rawLength > tdgbl->gbl_frame_size || storedLength > rawLength + rawLength / 8 + 64 + CRYPT_STEP)
+		BURP_error_redirect(NULL, 50);
+		// msg 50 unexpected end of file on backup file
+
+	frame->raw.resize(rawLength);
+	mvol_read_block(tdgbl, frame->stored.getBuffer(storedLength), storedLength);
+
+	return true;
+}
+
+ULONG BurpFrames::read(BurpGlobals* tdgbl, UCHAR* buffer, ULONG length)
+{
+	while (!m_current || m_offset == m_current->raw.getCount())
+	{
+		if (m_current)
+		{
+			m_current->raw.clear();
+			m_current->stored.clear();
+			m_free.push(m_current);
+			m_current = NULL;
+		}
+
+		// Read ahead the frames to keep the workers busy
+
+		while (!m_eof && m_queue.getCount() < m_maxQueue)
+		{
+			Frame* const frame = getFrame();
+
+			if (!readFrame(tdgbl, frame))
+			{
+				m_free.push(frame);
+				m_eof = true;
+				break;
+			}
+
+			submit(frame);
+		}
+
+		if (m_queue.isEmpty())
+			BURP_error_redirect(NULL, 50);
+			// msg 50 unexpected end of file on backup file
+
+		m_current = takeHead();
+		m_offset = 0;
+	}
+
+	const ULONG n = MIN(length, m_current->raw.getCount() - m_offset);
+	memcpy(buffer, m_current->raw.begin() + m_offset, n);
+	m_offset += n;
+
+	return n;
+}
+
+
 //____________________________________________________________
 //
 //
@@ -250,12 +786,8 @@ Firebird::ICryptKeyCallback* MVOL_get_crypt(BurpGlobals* tdgbl)
 //____________________________________________________________
 //
 //
-static void start_crypt(BurpGlobals* tdgbl)
+static Firebird::IDbCryptPlugin* load_crypt(BurpGlobals* tdgbl, Firebird::RefPtr<DbInfo>& dbInfo)
 {
-	fb_assert(tdgbl->gbl_sw_keyholder);
-	if (tdgbl->gbl_crypt && tdgbl->gbl_crypt->crypt_plugin)
-		return;
-
 	FbLocalStatus status;
 
 	// Get per-DB config
@@ -277,7 +809,7 @@ static void start_crypt(BurpGlobals* tdgbl)
 	if (!cryptControl.hasData())
 		(Firebird::Arg::Gds(isc_no_crypt_plugin) << tdgbl->mvol_crypt).raise();
 
-	Firebird::RefPtr<DbInfo> dbInfo(FB_NEW DbInfo(tdgbl));
+	dbInfo = FB_NEW DbInfo(tdgbl);
 	Firebird::IDbCryptPlugin* p = cryptControl.plugin();
 	p->setInfo(&status, dbInfo);
 	if (!status.isSuccess())
@@ -300,11 +832,26 @@ static void start_crypt(BurpGlobals* tdgbl)
 			(Firebird::Arg::Gds(isc_bad_crypt_key) << tdgbl->mvol_keyname).raise();
 	}
 
+	p->addRef();
+	return p;
+}
+
+//____________________________________________________________
+//
+//
+static void start_crypt(BurpGlobals* tdgbl)
+{
+	fb_assert(tdgbl->gbl_sw_keyholder);
+	if (tdgbl->gbl_crypt && tdgbl->gbl_crypt->crypt_plugin)
+		return;
+
+	Firebird::RefPtr<DbInfo> dbInfo;
+	Firebird::IDbCryptPlugin* p = load_crypt(tdgbl, dbInfo);
+
 	// crypt plugin is ready
 	BurpCrypt* g = tdgbl->gbl_crypt;
 	g->db_info.moveFrom(dbInfo);
 	g->crypt_plugin = p;
-	p->addRef();
 }
 
 //____________________________________________________________
@@ -425,6 +972,9 @@ static ULONG crypt_read_block(BurpGlobals* tdgbl, UCHAR* buffer, FB_SIZE_T buffe
 
 static ULONG unzip_read_block(BurpGlobals* tdgbl, UCHAR* buffer, FB_SIZE_T buffer_length)
 {
+	if (tdgbl->gbl_frames)
+		return tdgbl->gbl_frames->read(tdgbl, buffer, buffer_length);
+
 	if (!tdgbl->gbl_sw_zip)
 	{
 		return crypt_read_block(tdgbl, buffer, buffer_length);
@@ -491,6 +1041,12 @@ static ULONG unzip_read_block(BurpGlobals* tdgbl, UCHAR* buffer, FB_SIZE_T buffe
 
 static void zip_write_block(BurpGlobals* tdgbl, const UCHAR* buffer, FB_SIZE_T buffer_length, bool flash)
 {
+	if (tdgbl->gbl_frames)
+	{
+		tdgbl->gbl_frames->write(tdgbl, buffer, buffer_length, flash);
+		return;
+	}
+
 	if (!tdgbl->gbl_sw_zip)
 	{
 		crypt_write_block(tdgbl, buffer, buffer_length, flash);
@@ -564,7 +1120,7 @@ FB_UINT64 MVOL_fini_read()
 	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
 
 #ifdef HAVE_ZLIB_H
-	if (tdgbl->gbl_sw_zip)
+	if (tdgbl->gbl_sw_zip && !tdgbl->gbl_frame_size)
 	{
 		zlib().inflateEnd(&tdgbl->gbl_stream);
 	}
@@ -609,7 +1165,7 @@ FB_UINT64 MVOL_fini_write()
 	zip_write_block(tdgbl, tdgbl->gbl_compress_buffer, tdgbl->gbl_io_ptr - tdgbl->gbl_compress_buffer, true);
 
 #ifdef HAVE_ZLIB_H
-	if (tdgbl->gbl_sw_zip)
+	if (tdgbl->gbl_sw_zip && !tdgbl->gbl_frame_size)
 	{
 		zlib().deflateEnd(&tdgbl->gbl_stream);
 	}
@@ -664,8 +1220,19 @@ void MVOL_init(ULONG io_buf_size)
 }
 
 
+void MVOL_cleanup(BurpGlobals* tdgbl)
+{
+	// Stop the threads processing backup frames, if any
+
+	delete tdgbl->gbl_frames;
+	tdgbl->gbl_frames = NULL;
+}
+
+
 static void brio_fini(BurpGlobals* tdgbl)
 {
+	MVOL_cleanup(tdgbl);
+
 	delete[] tdgbl->gbl_compress_buffer;
 	tdgbl->gbl_compress_buffer = NULL;
 
@@ -702,7 +1269,27 @@ void MVOL_init_read(const char* file_name, USHORT* format)
 	tdgbl->gbl_io_cnt = 0;
 	tdgbl->gbl_io_ptr = NULL;
 
-	if (tdgbl->gbl_sw_zip)
+	if (tdgbl->gbl_frame_size)
+	{
+		Firebird::IDbCryptPlugin* crypt = NULL;
+		if (tdgbl->gbl_key_hash[0])
+		{
+			start_crypt(tdgbl);
+			crypt = tdgbl->gbl_crypt->crypt_plugin;
+		}
+
+#ifdef HAVE_ZLIB_H
+		if (tdgbl->gbl_sw_zip)
+			checkCompression();
+#else
+		if (tdgbl->gbl_sw_zip)
+			BURP_error(383, true, SafeArg() << 127);
+#endif
+
+		tdgbl->gbl_frames = FB_NEW_POOL(tdgbl->getPool())
+			BurpFrames(tdgbl, false, tdgbl->gbl_sw_zip, crypt);
+	}
+	else if (tdgbl->gbl_sw_zip)
 	{
 #ifdef HAVE_ZLIB_H
 		z_stream& strm = tdgbl->gbl_stream;
@@ -769,11 +1356,36 @@ void MVOL_init_write(const char* file_name)
 {
 	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
 
+	// Compression and encryption of parallel backup are done by a few
+	// threads, so data are split into independent frames
+
+	if ((tdgbl->gbl_sw_zip || tdgbl->gbl_sw_keyholder) && tdgbl->gbl_sw_par_workers > 1)
+		tdgbl->gbl_frame_size = FRAME_SIZE;
+
 	mvol_init_write(tdgbl, file_name, &tdgbl->blk_io_cnt, &tdgbl->blk_io_ptr);
 
 	tdgbl->gbl_io_cnt = ZC_BUFSIZE;
 	tdgbl->gbl_io_ptr = tdgbl->gbl_compress_buffer;
 
+	if (tdgbl->gbl_frame_size)
+	{
+		Firebird::IDbCryptPlugin* crypt = NULL;
+		if (tdgbl->gbl_sw_keyholder)
+		{
+			start_crypt(tdgbl);
+			crypt = tdgbl->gbl_crypt->crypt_plugin;
+		}
+
+#ifdef HAVE_ZLIB_H
+		if (tdgbl->gbl_sw_zip)
+			checkCompression();
+#endif
+
+		tdgbl->gbl_frames = FB_NEW_POOL(tdgbl->getPool())
+			BurpFrames(tdgbl, true, tdgbl->gbl_sw_zip, crypt);
+		return;
+	}
+
 #ifdef HAVE_ZLIB_H
 	if (tdgbl->gbl_sw_zip)
 	{
@@ -1412,6 +2024,36 @@ const UCHAR* mvol_write_block(BurpGlobals* tdgbl, const UCHAR* ptr, ULONG count)
 	return ptr;
 }
 
+static UCHAR* mvol_read_block(BurpGlobals* tdgbl, UCHAR* ptr, ULONG count)
+{
+	while (count)
+	{
+		// If buffer empty, reload it
+		if (tdgbl->blk_io_cnt <= 0)
+		{
+			*ptr++ = mvol_read(&tdgbl->blk_io_cnt, &tdgbl->blk_io_ptr);
+
+			// One byte was read by mvol_read
+			count--;
+		}
+
+		const ULONG n = MIN(count, (ULONG) tdgbl->blk_io_cnt);
+
+		// Copy data from the IO buffer
+
+		memcpy(ptr, tdgbl->blk_io_ptr, n);
+		ptr += n;
+
+		// Skip ahead in current buffer
+
+		count -= n;
+		tdgbl->blk_io_cnt -= n;
+		tdgbl->blk_io_ptr += n;
+	}
+
+	return ptr;
+}
+
 
 //____________________________________________________________
 //
@@ -1958,6 +2600,12 @@ static bool read_header(DESC handle, ULONG* buffer_size, USHORT* format, bool in
 				tdgbl->gbl_sw_zip = true;
 			break;
 
+		case att_backup_frames:
+			temp = get_numeric();
+			if (init_flag)
+				tdgbl->gbl_frame_size = temp;
+			break;
+
 		case att_backup_hash:
 			if (!tdgbl->gbl_sw_keyholder)
 				BURP_error(376, true);
@@ -2015,6 +2663,9 @@ static bool write_header(DESC handle, ULONG backup_buffer_size, bool full_buffer
 		if (tdgbl->gbl_sw_zip)
 			put_numeric(att_backup_zip, 1);
 
+		if (tdgbl->gbl_frame_size)
+			put_numeric(att_backup_frames, tdgbl->gbl_frame_size);
+
 		put_numeric(att_backup_blksize, backup_buffer_size);
 
 		tdgbl->mvol_io_volume = tdgbl->mvol_io_ptr + 2;
@@ -32,6 +32,7 @@ class BurpGlobals;
 FB_UINT64		MVOL_fini_read();
 FB_UINT64		MVOL_fini_write();
 void			MVOL_init(ULONG);
+void			MVOL_cleanup(BurpGlobals*);
 void			MVOL_init_read(const char*, USHORT*);
 void			MVOL_init_write(const char*);
 bool			MVOL_split_hdr_write();
@@ -104,6 +104,7 @@ PARSER_TOKEN(TOK_BOOLEAN, "BOOLEAN", false)
 PARSER_TOKEN(TOK_BOTH, "BOTH", false)
 PARSER_TOKEN(TOK_BREAK, "BREAK", true)
 PARSER_TOKEN(TOK_BY, "BY", false)
+PARSER_TOKEN(TOK_CACHE, "CACHE", true)
 PARSER_TOKEN(TOK_CALL, "CALL", false)
 PARSER_TOKEN(TOK_CALLER, "CALLER", true)
 PARSER_TOKEN(TOK_CASCADE, "CASCADE", true)
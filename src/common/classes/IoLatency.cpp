@@ -0,0 +1,44 @@
+/*
+ *	PROGRAM:	Firebird
+ *	MODULE:		IoLatency.cpp
+ *	DESCRIPTION:	Latency histograms of file I/O
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include "../common/classes/IoLatency.h"
+#include "../common/utils_proto.h"
+
+namespace Firebird {
+
+SINT64 IoLatencyStats::Timer::getCounter()
+{
+	return fb_utils::query_performance_counter();
+}
+
+IoLatencyStats::Timer::~Timer()
+{
+	const SINT64 frequency = fb_utils::query_performance_frequency();
+	const SINT64 elapsed = getCounter() - m_start;
+
+	// Avoid overflow while converting long operations to microseconds
+	const SINT64 time = elapsed / frequency * 1000000 + elapsed % frequency * 1000000 / frequency;
+
+	m_stats.m_histograms[m_operation].add(time, m_bytes);
+}
+
+} // namespace Firebird
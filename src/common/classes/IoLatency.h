@@ -0,0 +1,141 @@
+/*
+ *	PROGRAM:	Firebird
+ *	MODULE:		IoLatency.h
+ *	DESCRIPTION:	Latency histograms of file I/O
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#ifndef CLASSES_IO_LATENCY_H
+#define CLASSES_IO_LATENCY_H
+
+#include <atomic>
+
+namespace Firebird {
+
+// Histogram of operation latencies with logarithmic buckets. Bucket N counts
+// operations which took less than 2^N microseconds (and not less than 2^(N-1)),
+// the last bucket has no upper bound. Counters are updated without locking.
+
+class IoLatencyHistogram
+{
+public:
+	static const unsigned BUCKETS = 25;		// the last bounded one is ~8 seconds
+
+	IoLatencyHistogram()
+	{
+		for (unsigned i = 0; i < BUCKETS; i++)
+		{
+			m_counts[i].store(0, std::memory_order_relaxed);
+			m_bytes[i].store(0, std::memory_order_relaxed);
+			m_times[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void add(FB_UINT64 time, FB_UINT64 bytes)
+	{
+		const unsigned bucket = getBucket(time);
+
+		m_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+		m_bytes[bucket].fetch_add(bytes, std::memory_order_relaxed);
+		m_times[bucket].fetch_add(time, std::memory_order_relaxed);
+	}
+
+	FB_UINT64 getCount(unsigned bucket) const
+	{
+		return m_counts[bucket].load(std::memory_order_relaxed);
+	}
+
+	FB_UINT64 getBytes(unsigned bucket) const
+	{
+		return m_bytes[bucket].load(std::memory_order_relaxed);
+	}
+
+	FB_UINT64 getTime(unsigned bucket) const
+	{
+		return m_times[bucket].load(std::memory_order_relaxed);
+	}
+
+	// Upper bound of the bucket in microseconds, zero means no bound
+	static FB_UINT64 getBound(unsigned bucket)
+	{
+		return (bucket < BUCKETS - 1) ? (FB_UINT64(1) << bucket) : 0;
+	}
+
+	static unsigned getBucket(FB_UINT64 time)
+	{
+		unsigned bucket = 0;
+
+		while (time && bucket < BUCKETS - 1)
+		{
+			time >>= 1;
+			bucket++;
+		}
+
+		return bucket;
+	}
+
+private:
+	std::atomic<FB_UINT64> m_counts[BUCKETS];
+	std::atomic<FB_UINT64> m_bytes[BUCKETS];
+	std::atomic<FB_UINT64> m_times[BUCKETS];
+};
+
+// Latencies of reads, writes and flushes of the single file
+
+class IoLatencyStats
+{
+public:
+	enum Operation
+	{
+		IO_READ = 0,
+		IO_WRITE,
+		IO_SYNC,
+		IO_OPERATIONS
+	};
+
+	const IoLatencyHistogram& get(Operation operation) const
+	{
+		return m_histograms[operation];
+	}
+
+	// Measures the operation from the construction till the destruction
+
+	class Timer
+	{
+	public:
+		Timer(IoLatencyStats& stats, Operation operation, FB_UINT64 bytes = 0)
+			: m_stats(stats), m_operation(operation), m_bytes(bytes), m_start(getCounter())
+		{}
+
+		~Timer();
+
+	private:
+		static SINT64 getCounter();
+
+		IoLatencyStats& m_stats;
+		const Operation m_operation;
+		const FB_UINT64 m_bytes;
+		const SINT64 m_start;
+	};
+
+private:
+	IoLatencyHistogram m_histograms[IO_OPERATIONS];
+};
+
+} // namespace Firebird
+
+#endif // CLASSES_IO_LATENCY_H
@@ -0,0 +1,252 @@
+/*
+ *	PROGRAM:	Common class definition
+ *	MODULE:		Lz4.cpp
+ *	DESCRIPTION:	Fast LZ77 block compressor (LZ4 block format).
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "../common/classes/Lz4.h"
+
+#include <string.h>
+
+using namespace Firebird;
+
+namespace {
+
+const unsigned MIN_MATCH = 4;			// shortest match which may be encoded
+const unsigned LAST_LITERALS = 5;		// last bytes of block are always literals
+const unsigned MF_LIMIT = 12;			// last match must start before this distance from the end
+const unsigned MAX_DISTANCE = 65535;	// offset is stored as 2 bytes
+const unsigned RUN_MASK = 15;			// length bits in token
+
+const unsigned HASH_LOG = 12;
+const unsigned HASH_SIZE = 1 << HASH_LOG;
+
+inline ULONG read32(const UCHAR* p)
+{
+	ULONG v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline unsigned hash(ULONG sequence)
+{
+	return (sequence * 2654435761U) >> (32 - HASH_LOG);
+}
+
+inline UCHAR* putLength(UCHAR* to, ULONG length)
+{
+	for (length -= RUN_MASK; length >= 255; length -= 255)
+		*to++ = 255;
+	*to++ = (UCHAR) length;
+
+	return to;
+}
+
+inline bool getLength(const UCHAR*& from, const UCHAR* const end, ULONG& length)
+{
+	UCHAR c;
+
+	do
+	{
+		if (from >= end)
+			return false;
+
+		c = *from++;
+		length += c;
+	} while (c == 255);
+
+	return true;
+}
+
+// Worst case space needed to encode literal run plus a match
+inline ULONG sequenceSize(ULONG literals, ULONG matchLength)
+{
+	return 1 + literals + literals / 255 + 1 + 2 + matchLength / 255 + 1;
+}
+
+} // anonymous namespace
+
+
+ULONG Lz4::compress(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength)
+{
+	const UCHAR* const fromEnd = from + fromLength;
+	const UCHAR* ip = from;
+	const UCHAR* anchor = from;
+
+	UCHAR* op = to;
+	const UCHAR* const toEnd = to + toLength;
+
+	if (fromLength > MF_LIMIT)
+	{
+		const UCHAR* const matchLimit = fromEnd - LAST_LITERALS;
+		const UCHAR* const searchLimit = fromEnd - MF_LIMIT;
+
+		ULONG table[HASH_SIZE];
+		memset(table, 0, sizeof(table));
+
+		// Skip faster over incompressible data
+		unsigned misses = 0;
+
+		while (ip < searchLimit)
+		{
+			const ULONG sequence = read32(ip);
+			const unsigned h = hash(sequence);
+			const UCHAR* ref = from + table[h];
+			table[h] = (ULONG) (ip - from);
+
+			if (ref >= ip || ip - ref > MAX_DISTANCE || read32(ref) != sequence)
+			{
+				ip += 1 + (misses++ >> 6);
+				continue;
+			}
+
+			misses = 0;
+
+			while (ip > anchor && ref > from && ip[-1] == ref[-1])
+			{
+				--ip;
+				--ref;
+			}
+
+			const UCHAR* matchEnd = ip + MIN_MATCH;
+			for (const UCHAR* r = ref + MIN_MATCH; matchEnd < matchLimit && *matchEnd == *r; ++r)
+				++matchEnd;
+
+			const ULONG literals = (ULONG) (ip - anchor);
+			const ULONG matchLength = (ULONG) (matchEnd - ip) - MIN_MATCH;
+
+			if (sequenceSize(literals, matchLength) > (ULONG) (toEnd - op))
+				return 0;
+
+			UCHAR* const token = op++;
+
+			if (literals >= RUN_MASK)
+			{
+				*token = RUN_MASK << 4;
+				op = putLength(op, literals);
+			}
+			else
+				*token = (UCHAR) (literals << 4);
+
+			memcpy(op, anchor, literals);
+			op += literals;
+
+			const ULONG offset = (ULONG) (ip - ref);
+			*op++ = (UCHAR) offset;
+			*op++ = (UCHAR) (offset >> 8);
+
+			if (matchLength >= RUN_MASK)
+			{
+				*token |= RUN_MASK;
+				op = putLength(op, matchLength);
+			}
+			else
+				*token |= (UCHAR) matchLength;
+
+			ip = anchor = matchEnd;
+
+			// Remember position inside the match to improve next search
+			if (ip < searchLimit)
+				table[hash(read32(ip - 2))] = (ULONG) (ip - 2 - from);
+		}
+	}
+
+	// The rest of data is stored as literals
+	const ULONG literals = (ULONG) (fromEnd - anchor);
+
+	if (1 + literals + literals / 255 + 1 > (ULONG) (toEnd - op))
+		return 0;
+
+	if (literals >= RUN_MASK)
+	{
+		*op++ = RUN_MASK << 4;
+		op = putLength(op, literals);
+	}
+	else
+		*op++ = (UCHAR) (literals << 4);
+
+	memcpy(op, anchor, literals);
+	op += literals;
+
+	return (ULONG) (op - to);
+}
+
+
+bool Lz4::decompress(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength,
+	ULONG* resultLength)
+{
+	const UCHAR* ip = from;
+	const UCHAR* const fromEnd = from + fromLength;
+
+	UCHAR* op = to;
+	const UCHAR* const toEnd = to + toLength;
+
+	while (ip < fromEnd)
+	{
+		const unsigned token = *ip++;
+
+		ULONG length = token >> 4;
+		if (length == RUN_MASK && !getLength(ip, fromEnd, length))
+			return false;
+
+		if (length > (ULONG) (fromEnd - ip) || length > (ULONG) (toEnd - op))
+			return false;
+
+		memcpy(op, ip, length);
+		op += length;
+		ip += length;
+
+		// Last sequence has no match part
+		if (ip == fromEnd)
+			break;
+
+		if (fromEnd - ip < 2)
+			return false;
+
+		const ULONG offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+
+		if (!offset || offset > (ULONG) (op - to))
+			return false;
+
+		length = token & RUN_MASK;
+		if (length == RUN_MASK && !getLength(ip, fromEnd, length))
+			return false;
+
+		length += MIN_MATCH;
+		if (length > (ULONG) (toEnd - op))
+			return false;
+
+		const UCHAR* ref = op - offset;
+
+		if (offset >= length)
+		{
+			memcpy(op, ref, length);
+			op += length;
+		}
+		else
+		{
+			// Overlapped copy repeats the pattern
+			while (length--)
+				*op++ = *ref++;
+		}
+	}
+
+	*resultLength = (ULONG) (op - to);
+	return true;
+}
@@ -0,0 +1,52 @@
+/*
+ *	PROGRAM:	Common class definition
+ *	MODULE:		Lz4.h
+ *	DESCRIPTION:	Fast LZ77 block compressor (LZ4 block format).
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef COMMON_LZ4_H
+#define COMMON_LZ4_H
+
+#include "fb_types.h"
+
+namespace Firebird {
+
+// Stateless compressor producing blocks in the well known LZ4 block format.
+// It does not depend on any external library and trades compression ratio
+// for speed - the typical use is compressing data passed over network or
+// written to journals, where zlib CPU usage is too high.
+
+class Lz4
+{
+public:
+	// Maximum size of packed block for given size of data
+	static ULONG compressBound(ULONG length)
+	{
+		return length + length / 255 + 16;
+	}
+
+	// Returns size of packed data or 0 if it does not fit into target buffer
+	static ULONG compress(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength);
+
+	// Returns false if packed data is corrupted or does not fit into target buffer
+	static bool decompress(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength,
+		ULONG* resultLength);
+};
+
+} // namespace Firebird
+
+#endif // COMMON_LZ4_H
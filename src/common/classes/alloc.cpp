@@ -68,6 +68,8 @@
 #include "../common/os/fbsyslog.h"
 #include "iberror.h"
 
+#include <atomic>
+
 #ifdef USE_VALGRIND
 #include <valgrind/memcheck.h>
 
@@ -136,6 +138,12 @@ size_t delayedExtentsPos = 0;
 // Could slowdown pool significantly !
 //#define VALIDATE_POOL
 
+// Debugging modes need every block to pass through the pool
+#undef POOL_CACHE
+#if !defined(DELAYED_FREE) && !defined(VALIDATE_POOL)
+#define POOL_CACHE
+#endif
+
 typedef Firebird::AtomicCounter::counter_type StatInt;
 
 // We cache this amount of extents to avoid memory mapping overhead
@@ -1586,6 +1594,76 @@ private:
 };
 
 
+#ifdef POOL_CACHE
+
+// Cache of free small blocks in front of the pool free lists. Threads are spread
+// over the shards, each shard has its own lock, therefore small blocks allocated
+// and released by different threads usually do not touch the pool mutex. Blocks
+// are moved between the shard and the pool in batches. Cached blocks are free ones
+// from the point of view of memory usage accounting. Periodically all shards give
+// a half of their blocks back, so blocks are not kept by threads gone from the pool.
+
+class BlockCache
+{
+public:
+	static const unsigned SHARDS = 8;
+	static const unsigned BATCH = 8;			// blocks moved between shard and pool at once
+	static const unsigned SLOT_BYTES = 4096;	// memory of the same slot kept by the shard
+	static const unsigned TRIM_INTERVAL = 65536;	// released blocks between the trims of all shards
+
+	class Shard
+	{
+	public:
+		Shard()
+		{
+			memset(blocks, 0, sizeof(blocks));
+			memset(counts, 0, sizeof(counts));
+		}
+
+		// Do not keep too many big blocks in the shard
+		static unsigned getLimit(unsigned slot)
+		{
+			return MAX(BATCH * 2, SLOT_BYTES / LowLimits::getSize(slot));
+		}
+
+		Mutex mutex;
+		MemBlock* blocks[LowLimits::TOTAL_ELEMENTS];
+		unsigned counts[LowLimits::TOTAL_ELEMENTS];
+	};
+
+	Shard& getShard()
+	{
+		static std::atomic<unsigned> nextShard(0);
+		static thread_local unsigned threadShard = nextShard++ % SHARDS;
+
+		return shards[threadShard];
+	}
+
+	Shard& getShard(unsigned n)
+	{
+		return shards[n];
+	}
+
+	// Returns true when it's time to trim the cache
+	bool countRelease()
+	{
+		return !(++releases % TRIM_INTERVAL);
+	}
+
+private:
+	Shard shards[SHARDS];
+	std::atomic<unsigned> releases = 0;
+};
+
+// Number of contended acquisitions of the pool mutex making pool create the cache
+const unsigned CACHE_CONTENTION_THRESHOLD = 16;
+// Number of acquisitions of the pool mutex halving the count of contended ones,
+// so the pool contended rarely never gets the cache
+const unsigned CACHE_CONTENTION_DECAY = 4096;
+
+#endif // POOL_CACHE
+
+
 // Implementation of memory pool
 
 class MemPool
@@ -1626,6 +1704,12 @@ private:
 	int				blocksActive;
 	bool			pool_destroying, parent_redirect;
 
+#ifdef POOL_CACHE
+	std::atomic<BlockCache*> cache;
+	unsigned contentions;
+	unsigned acquisitions;
+#endif
+
 	MemoryStats* stats;	// Statistics group for the pool
 	MemPool* parent;	// Parent pool if present
 	ExtentsCache* extentsCache;
@@ -1677,6 +1761,21 @@ private:
 	MemBlock* allocateInternal(size_t from, size_t& length, bool flagRedirect);
 	void releaseBlock(MemBlock *block, bool flagDecr) noexcept;
 
+#ifdef POOL_CACHE
+	void lockContended(MutexEnsureUnlock& guard) noexcept;
+	void createCache();
+	MemBlock* getCachedBlock(BlockCache* blockCache, size_t& length);
+	void putCachedBlock(BlockCache* blockCache, MemBlock* block) noexcept;
+	void trimCache(BlockCache* blockCache) noexcept;
+	void returnCachedBlocks(BlockCache::Shard& shard, unsigned slot, unsigned count) noexcept;
+
+public:
+	bool isCaching() const noexcept
+	{
+		return cache.load(std::memory_order_relaxed) != nullptr;
+	}
+#endif
+
 public:
 	void* allocate(size_t size ALLOC_PARAMS);
 	MemBlock* allocateRange(size_t from, size_t& size ALLOC_PARAMS);
@@ -1992,6 +2091,12 @@ void MemPool::initialize()
 	bigHunks = NULL;
 	pool_destroying = false;
 
+#ifdef POOL_CACHE
+	cache = nullptr;
+	contentions = 0;
+	acquisitions = 0;
+#endif
+
 #ifdef MEM_DEBUG
 	next = child = NULL;
 
@@ -2011,6 +2116,12 @@ MemPool::~MemPool(void)
 	decrement_usage(used_memory.value());
 	decrement_mapping(mapped_memory.value());
 
+#ifdef POOL_CACHE
+	// Cached blocks and the cache itself live in the extents released below
+	if (BlockCache* blockCache = cache.load(std::memory_order_relaxed))
+		blockCache->~BlockCache();
+#endif
+
 #ifdef USE_VALGRIND
 	VALGRIND_DESTROY_MEMPOOL(this);
 
@@ -2149,10 +2260,33 @@ void MemoryPool::setStatsGroup(MemoryStats& newStats) noexcept
 	pool->setStatsGroup(newStats);
 }
 
+bool MemoryPool::isCaching() const noexcept
+{
+#ifdef POOL_CACHE
+	return pool->isCaching();
+#else
+	return false;
+#endif
+}
+
 MemBlock* MemPool::allocateInternal(size_t from, size_t& length, bool flagRedirect)
 {
+#ifdef POOL_CACHE
+	BlockCache* const blockCache = cache.load(std::memory_order_acquire);
+
+	if (blockCache && !from && length + LinkedList::MEM_OVERHEAD <= LowLimits::TOP_LIMIT)
+		return getCachedBlock(blockCache, length);
+#endif
+
 	MutexEnsureUnlock guard(mutex, "MemPool::allocateInternal");
+#ifdef POOL_CACHE
+	lockContended(guard);
+
+	if (contentions >= CACHE_CONTENTION_THRESHOLD && !blockCache)
+		createCache();
+#else
 	guard.enter();
+#endif
 
 	++blocksAllocated;
 	++blocksActive;
@@ -2349,8 +2483,23 @@ void MemPool::releaseBlock(MemBlock* block, bool decrUsage) noexcept
 
 	const size_t length = block->getSize();
 
+#ifdef POOL_CACHE
+	BlockCache* const blockCache = cache.load(std::memory_order_acquire);
+
+	if (blockCache && decrUsage && length <= LowLimits::TOP_LIMIT)
+	{
+		decrement_usage(length);
+		putCachedBlock(blockCache, block);
+		return;
+	}
+#endif
+
 	MutexEnsureUnlock guard(mutex, "MemPool::releaseBlock");
+#ifdef POOL_CACHE
+	lockContended(guard);
+#else
 	guard.enter();
+#endif
 
 	--blocksActive;
 
@@ -2396,6 +2545,139 @@ void MemPool::releaseBlock(MemBlock* block, bool decrUsage) noexcept
 	releaseRaw(pool_destroying, hunk, hunk->length, nullptr);
 }
 
+#ifdef POOL_CACHE
+// Enter the pool mutex counting contended acquisitions
+void MemPool::lockContended(MutexEnsureUnlock& guard) noexcept
+{
+	if (guard.tryEnter())
+	{
+		if (!(++acquisitions % CACHE_CONTENTION_DECAY))
+			contentions /= 2;
+
+		return;
+	}
+
+	guard.enter();
+	++contentions;
+}
+
+// Pool which mutex is contended often gets the cache of small blocks.
+// Called with the pool mutex locked.
+void MemPool::createCache()
+{
+	if (cache.load(std::memory_order_relaxed))
+		return;
+
+	try
+	{
+		// The cache is never released till the pool destruction, so keep it in the pool itself.
+		// Like the other pool internals it's not accounted as used memory.
+		size_t length = sizeof(BlockCache);
+		MemBlock* block = mediumObjects.allocateBlock(this, 0, length);
+		fb_assert(block);
+
+		block->pool = this;
+		++blocksAllocated;
+		++blocksActive;
+
+		cache.store(new(&block->body) BlockCache, std::memory_order_release);
+	}
+	catch (const Exception&)
+	{
+		// Cache is an optimization only, work without it
+		contentions = 0;
+	}
+}
+
+MemBlock* MemPool::getCachedBlock(BlockCache* blockCache, size_t& length)
+{
+	const unsigned slot = LowLimits::getSlot(length + LinkedList::MEM_OVERHEAD, SLOT_ALLOC);
+	BlockCache::Shard& shard = blockCache->getShard();
+
+	MutexLockGuard guard(shard.mutex, "MemPool::getCachedBlock");
+
+	if (!shard.counts[slot])
+	{
+		MutexLockGuard poolGuard(mutex, "MemPool::getCachedBlock /pool");
+
+		for (unsigned n = 0; n < BlockCache::BATCH; n++)
+		{
+			size_t size = length;
+			MemBlock* block = smallObjects.allocateBlock(this, 0, size);
+			fb_assert(block);
+
+			++blocksAllocated;
+			++blocksActive;
+
+			LinkedList::putElement(&shard.blocks[slot], block);
+			shard.counts[slot]++;
+		}
+	}
+
+	--shard.counts[slot];
+	length = LowLimits::getSize(slot) - LinkedList::MEM_OVERHEAD;
+	return LinkedList::getElement(&shard.blocks[slot]);
+}
+
+void MemPool::putCachedBlock(BlockCache* blockCache, MemBlock* block) noexcept
+{
+	const unsigned slot = LowLimits::getSlot(block->getSize(), SLOT_ALLOC);
+
+	{	// scope
+		BlockCache::Shard& shard = blockCache->getShard();
+
+		MutexLockGuard guard(shard.mutex, "MemPool::putCachedBlock");
+
+		LinkedList::putElement(&shard.blocks[slot], block);
+
+		if (++shard.counts[slot] > BlockCache::Shard::getLimit(slot))
+		{
+			// Return half of the cached blocks to the pool
+			MutexLockGuard poolGuard(mutex, "MemPool::putCachedBlock /pool");
+			returnCachedBlocks(shard, slot, shard.counts[slot] / 2);
+		}
+	}
+
+	if (blockCache->countRelease())
+		trimCache(blockCache);
+}
+
+// Give back a half of blocks of every shard, all of them when the cache is not used anymore
+void MemPool::trimCache(BlockCache* blockCache) noexcept
+{
+	for (unsigned n = 0; n < BlockCache::SHARDS; n++)
+	{
+		BlockCache::Shard& shard = blockCache->getShard(n);
+
+		MutexLockGuard guard(shard.mutex, "MemPool::trimCache");
+		MutexLockGuard poolGuard(mutex, "MemPool::trimCache /pool");
+
+		for (unsigned slot = 0; slot < LowLimits::TOTAL_ELEMENTS; slot++)
+			returnCachedBlocks(shard, slot, (shard.counts[slot] + 1) / 2);
+	}
+}
+
+// Called with both shard and pool mutexes locked
+void MemPool::returnCachedBlocks(BlockCache::Shard& shard, unsigned slot, unsigned count) noexcept
+{
+	for (; count; count--)
+	{
+		MemBlock* const block = LinkedList::getElement(&shard.blocks[slot]);
+
+		if (!smallObjects.deallocateBlock(block))
+		{
+			// Only small blocks get into the cache, keep the unexpected one there
+			fb_assert(false);
+			LinkedList::putElement(&shard.blocks[slot], block);
+			break;
+		}
+
+		--shard.counts[slot];
+		--blocksActive;
+	}
+}
+#endif // POOL_CACHE
+
 void MemPool::memoryIsExhausted(void)
 {
 	Firebird::BadAlloc::raise();
@@ -218,6 +218,9 @@ public:
 	// previously set group and added to new
 	void setStatsGroup(MemoryStats& stats) noexcept;
 
+	// True if the pool got the cache of small blocks because its mutex is contended
+	bool isCaching() const noexcept;
+
 	// Initialize and finalize global memory pool
 	static void initDefaultPool();
 	static void cleanupDefaultPool();
@@ -0,0 +1,147 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../common/classes/alloc.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Firebird;
+
+BOOST_AUTO_TEST_SUITE(CommonSuite)
+BOOST_AUTO_TEST_SUITE(AllocSuite)
+
+
+BOOST_AUTO_TEST_SUITE(MemoryPoolTests)
+
+BOOST_AUTO_TEST_CASE(UsageTest)
+{
+	MemoryStats stats;
+	MemoryPool* pool = MemoryPool::createPool(nullptr, stats);
+	const size_t initialUsage = stats.getCurrentUsage();
+
+	void* blocks[100];
+
+	for (int i = 0; i < FB_NELEM(blocks); i++)
+		blocks[i] = pool->allocate(1 + i * 17 ALLOC_ARGS);
+
+	BOOST_TEST(stats.getCurrentUsage() > initialUsage);
+
+	for (int i = 0; i < FB_NELEM(blocks); i++)
+		MemoryPool::globalFree(blocks[i]);
+
+	BOOST_TEST(stats.getCurrentUsage() == initialUsage);
+
+	MemoryPool::deletePool(pool);
+	BOOST_TEST(stats.getCurrentUsage() == 0u);
+}
+
+// Many threads working with the same pool make it cache small blocks,
+// memory usage must be accounted exactly anyway
+BOOST_AUTO_TEST_CASE(ConcurrentUsageTest)
+{
+	const unsigned THREADS = 8;
+	const unsigned ITERATIONS = 20000;
+	const unsigned KEPT = 64;
+
+	MemoryStats stats;
+	MemoryPool* pool = MemoryPool::createPool(nullptr, stats);
+	const size_t initialUsage = stats.getCurrentUsage();
+
+	std::vector<std::vector<void*>> kept(THREADS);
+	std::vector<std::thread> threads;
+
+	for (unsigned t = 0; t < THREADS; t++)
+	{
+		threads.emplace_back([pool, &kept, t]() {
+			auto& blocks = kept[t];
+			blocks.resize(KEPT);
+
+			for (unsigned i = 0; i < ITERATIONS; i++)
+			{
+				void*& block = blocks[(i * 7 + t) % KEPT];
+
+				if (block)
+					MemoryPool::globalFree(block);
+
+				block = pool->allocate(8 + (i * 13 + t * 5) % 900 ALLOC_ARGS);
+				memset(block, t, 8);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	BOOST_TEST(stats.getCurrentUsage() > initialUsage);
+
+	// Blocks allocated by the other threads are released here
+	for (auto& blocks : kept)
+	{
+		for (auto block : blocks)
+			MemoryPool::globalFree(block);
+	}
+
+	BOOST_TEST(stats.getCurrentUsage() == initialUsage);
+
+	MemoryPool::deletePool(pool);
+	BOOST_TEST(stats.getCurrentUsage() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(CacheActivationTest)
+{
+	const unsigned THREADS = 8;
+	const unsigned KEPT = 64;
+
+	MemoryStats stats;
+	MemoryPool* pool = MemoryPool::createPool(nullptr, stats);
+	const size_t initialUsage = stats.getCurrentUsage();
+
+	BOOST_TEST(!pool->isCaching());
+
+	// Work with the pool until its mutex becomes contended enough to create the cache
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+	std::vector<std::thread> threads;
+
+	for (unsigned t = 0; t < THREADS; t++)
+	{
+		threads.emplace_back([pool, deadline, t]() {
+			void* blocks[KEPT] = {};
+
+			for (unsigned i = 0; !pool->isCaching() || i < KEPT * 16; i++)
+			{
+				if (!(i % 1024) && std::chrono::steady_clock::now() > deadline)
+					break;
+
+				void*& block = blocks[(i * 7 + t) % KEPT];
+
+				if (block)
+					MemoryPool::globalFree(block);
+
+				block = pool->allocate(8 + (i * 13 + t * 5) % 900 ALLOC_ARGS);
+				memset(block, t, 8);
+			}
+
+			for (auto block : blocks)
+				MemoryPool::globalFree(block);
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	// Single CPU hardly makes the pool contended
+	if (std::thread::hardware_concurrency() > 1)
+		BOOST_TEST(pool->isCaching());
+
+	// Blocks kept by the cache are free ones
+	BOOST_TEST(stats.getCurrentUsage() == initialUsage);
+
+	MemoryPool::deletePool(pool);
+	BOOST_TEST(stats.getCurrentUsage() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// MemoryPoolTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// AllocSuite
+BOOST_AUTO_TEST_SUITE_END()	// CommonSuite
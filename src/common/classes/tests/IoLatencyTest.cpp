@@ -0,0 +1,50 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../common/classes/IoLatency.h"
+
+using namespace Firebird;
+
+BOOST_AUTO_TEST_SUITE(CommonSuite)
+BOOST_AUTO_TEST_SUITE(IoLatencySuite)
+
+
+BOOST_AUTO_TEST_CASE(BucketTest)
+{
+	BOOST_TEST(IoLatencyHistogram::getBucket(0) == 0u);
+	BOOST_TEST(IoLatencyHistogram::getBucket(1) == 1u);
+	BOOST_TEST(IoLatencyHistogram::getBucket(2) == 2u);
+	BOOST_TEST(IoLatencyHistogram::getBucket(3) == 2u);
+	BOOST_TEST(IoLatencyHistogram::getBucket(1000) == 10u);
+	BOOST_TEST(IoLatencyHistogram::getBucket(MAX_UINT64) == IoLatencyHistogram::BUCKETS - 1);
+
+	// every bounded bucket holds values below its bound
+	for (unsigned i = 0; i < IoLatencyHistogram::BUCKETS - 1; i++)
+	{
+		const FB_UINT64 bound = IoLatencyHistogram::getBound(i);
+		BOOST_TEST(IoLatencyHistogram::getBucket(bound - 1) == i);
+		BOOST_TEST(IoLatencyHistogram::getBucket(bound) == i + 1);
+	}
+
+	BOOST_TEST(IoLatencyHistogram::getBound(IoLatencyHistogram::BUCKETS - 1) == 0u);
+}
+
+
+BOOST_AUTO_TEST_CASE(AddTest)
+{
+	IoLatencyHistogram histogram;
+
+	histogram.add(5, 8192);
+	histogram.add(6, 8192);
+	histogram.add(100000000, 4096);
+
+	BOOST_TEST(histogram.getCount(3) == 2u);
+	BOOST_TEST(histogram.getBytes(3) == 16384u);
+	BOOST_TEST(histogram.getTime(3) == 11u);
+
+	BOOST_TEST(histogram.getCount(IoLatencyHistogram::BUCKETS - 1) == 1u);
+	BOOST_TEST(histogram.getCount(0) == 0u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()	// IoLatencySuite
+BOOST_AUTO_TEST_SUITE_END()	// CommonSuite
@@ -0,0 +1,101 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../common/classes/Lz4.h"
+
+using namespace Firebird;
+
+BOOST_AUTO_TEST_SUITE(CommonSuite)
+BOOST_AUTO_TEST_SUITE(Lz4Suite)
+
+
+static void testRoundTrip(const UCHAR* data, ULONG length)
+{
+	static UCHAR packed[40000], unpacked[40000];
+	BOOST_REQUIRE(Lz4::compressBound(length) <= sizeof(packed));
+
+	const ULONG packedLength = Lz4::compress(data, length, packed, Lz4::compressBound(length));
+	BOOST_TEST(packedLength > 0u);
+
+	ULONG unpackedLength = 0;
+	BOOST_TEST(Lz4::decompress(packed, packedLength, unpacked, length, &unpackedLength));
+	BOOST_TEST(unpackedLength == length);
+	BOOST_TEST(memcmp(unpacked, data, length) == 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(EmptyAndShortTest)
+{
+	const UCHAR data[] = "0123456789ab";
+
+	for (ULONG length = 0; length < sizeof(data); ++length)
+		testRoundTrip(data, length);
+}
+
+
+BOOST_AUTO_TEST_CASE(RepetitiveTest)
+{
+	UCHAR data[32768];
+
+	for (unsigned i = 0; i < sizeof(data); ++i)
+		data[i] = "FIREBIRD "[i % 9];
+
+	testRoundTrip(data, sizeof(data));
+
+	UCHAR packed[1024];
+	const ULONG packedLength = Lz4::compress(data, sizeof(data), packed, sizeof(packed));
+	BOOST_TEST(packedLength > 0u);
+	BOOST_TEST(packedLength < sizeof(data) / 64);
+}
+
+
+BOOST_AUTO_TEST_CASE(RandomTest)
+{
+	UCHAR data[20000];
+	ULONG seed = 12345;
+
+	for (unsigned i = 0; i < sizeof(data); ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		data[i] = (UCHAR) (seed >> 16);
+
+		// Make some part of data compressible
+		if (i > 100 && (seed & 0x300) == 0)
+			data[i] = data[i - 1 - (seed >> 24) % 64];
+	}
+
+	testRoundTrip(data, sizeof(data));
+
+	// Output buffer is too small
+	UCHAR packed[100];
+	BOOST_TEST(Lz4::compress(data, sizeof(data), packed, sizeof(packed)) == 0u);
+}
+
+
+BOOST_AUTO_TEST_CASE(CorruptedTest)
+{
+	UCHAR data[1000];
+
+	for (unsigned i = 0; i < sizeof(data); ++i)
+		data[i] = (UCHAR) (i % 37);
+
+	UCHAR packed[1100];
+	const ULONG packedLength = Lz4::compress(data, sizeof(data), packed, sizeof(packed));
+	BOOST_TEST(packedLength > 0u);
+
+	UCHAR unpacked[sizeof(data)];
+	ULONG unpackedLength;
+
+	// Target buffer is too small
+	BOOST_TEST(!Lz4::decompress(packed, packedLength, unpacked, sizeof(data) - 1, &unpackedLength));
+
+	// Match refers before the start of data
+	const UCHAR badOffset[] = {0x10, 'a', 0x05, 0x00, 0x00};
+	BOOST_TEST(!Lz4::decompress(badOffset, sizeof(badOffset), unpacked, sizeof(unpacked), &unpackedLength));
+
+	// Truncated literals
+	BOOST_TEST(!Lz4::decompress(packed, 3, unpacked, sizeof(unpacked), &unpackedLength));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()	// Lz4Suite
+BOOST_AUTO_TEST_SUITE_END()	// CommonSuite
@@ -396,6 +396,17 @@ void Config::checkValues()
 		}
 	}
 
+	strVal = values[KEY_WIRE_COMPRESSION_METHOD].strVal;
+	if (strVal)
+	{
+		NoCaseString method(strVal);
+		if (method != "ZLIB" && method != "LZ4")
+		{
+			// user-provided value is invalid - fail to default
+			values[KEY_WIRE_COMPRESSION_METHOD] = defaults[KEY_WIRE_COMPRESSION_METHOD];
+		}
+	}
+
 	strVal = values[KEY_SERVER_MODE].strVal;
 	if (strVal && !fb_utils::bootBuild())
 	{
@@ -423,6 +434,10 @@ void Config::checkValues()
 
 	checkIntForLoBound(KEY_INLINE_SORT_THRESHOLD, 0, true);
 
+	checkIntForLoBound(KEY_ADAPTIVE_JOIN_FACTOR, 0, true);
+
+	checkIntForLoBound(KEY_WIRE_COMPRESSION_THRESHOLD, 0, true);
+
 	checkIntForLoBound(KEY_MAX_STATEMENT_CACHE_SIZE, 0, true);
 
 	checkIntForLoBound(KEY_MAX_PARALLEL_WORKERS, 1, true);
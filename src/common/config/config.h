@@ -168,6 +168,8 @@ enum ConfigKey
 	KEY_REMOTE_ACCESS,
 	KEY_IPV6_V6ONLY,
 	KEY_WIRE_COMPRESSION,
+	KEY_WIRE_COMPRESSION_METHOD,
+	KEY_WIRE_COMPRESSION_THRESHOLD,
 	KEY_ENCRYPT_SECURITY_DATABASE,
 	KEY_STMT_TIMEOUT,
 	KEY_CONN_IDLE_TIMEOUT,
@@ -187,6 +189,7 @@ enum ConfigKey
 	KEY_PARALLEL_WORKERS,
 	KEY_MAX_PARALLEL_WORKERS,
 	KEY_OPTIMIZE_FOR_FIRST_ROWS,
+	KEY_ADAPTIVE_JOIN_FACTOR,
 	MAX_CONFIG_KEY		// keep it last
 };
 
@@ -274,6 +277,8 @@ constexpr ConfigEntry entries[MAX_CONFIG_KEY] =
 	{TYPE_BOOLEAN,	"RemoteAccess",				false,	true},
 	{TYPE_BOOLEAN,	"IPv6V6Only",				false,	false},
 	{TYPE_BOOLEAN,	"WireCompression",			false,	false},
+	{TYPE_STRING,	"WireCompressionMethod",	false,	"zlib"},
+	{TYPE_INTEGER,	"WireCompressionThreshold",	false,	128},		// bytes
 	{TYPE_BOOLEAN,	"AllowEncryptedSecurityDatabase",	false,	false},
 	{TYPE_INTEGER,	"StatementTimeout",			false,	0},
 	{TYPE_INTEGER,	"ConnectionIdleTimeout",	false,	0},
@@ -300,7 +305,8 @@ constexpr ConfigEntry entries[MAX_CONFIG_KEY] =
 	{TYPE_INTEGER,	"MaxStatementCacheSize",	false,	2 * 1048576},	// bytes
 	{TYPE_INTEGER,	"ParallelWorkers",			true,	1},
 	{TYPE_INTEGER,	"MaxParallelWorkers",		true,	1},
-	{TYPE_BOOLEAN,	"OptimizeForFirstRows",		false,	false}
+	{TYPE_BOOLEAN,	"OptimizeForFirstRows",		false,	false},
+	{TYPE_INTEGER,	"AdaptiveJoinFactor",		false,	0}
 };
 
 
@@ -584,6 +590,10 @@ public:
 
 	CONFIG_GET_PER_DB_BOOL(getWireCompression, KEY_WIRE_COMPRESSION);
 
+	CONFIG_GET_PER_DB_STR(getWireCompressionMethod, KEY_WIRE_COMPRESSION_METHOD);
+
+	CONFIG_GET_PER_DB_KEY(ULONG, getWireCompressionThreshold, KEY_WIRE_COMPRESSION_THRESHOLD, getInt);
+
 	CONFIG_GET_PER_DB_BOOL(getCryptSecurityDatabase, KEY_ENCRYPT_SECURITY_DATABASE);
 
 	// set in seconds
@@ -624,6 +634,8 @@ public:
 	CONFIG_GET_GLOBAL_INT(getMaxParallelWorkers, KEY_MAX_PARALLEL_WORKERS);
 
 	CONFIG_GET_PER_DB_BOOL(getOptimizeForFirstRows, KEY_OPTIMIZE_FOR_FIRST_ROWS);
+
+	CONFIG_GET_PER_DB_KEY(ULONG, getAdaptiveJoinFactor, KEY_ADAPTIVE_JOIN_FACTOR, getInt);
 };
 
 // Implementation of interface to access master configuration file
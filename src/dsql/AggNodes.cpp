@@ -435,6 +435,25 @@ bool AggNode::aggPass(thread_db* tdbb, Request* request) const
 	return true;
 }
 
+bool AggNode::aggRemove(thread_db* tdbb, Request* request) const
+{
+	if (distinct)
+		return false;
+
+	dsc* desc = NULL;
+
+	if (arg)
+	{
+		desc = EVL_expr(tdbb, request, arg);
+
+		// NULLs were not passed, so there is nothing to remove.
+		if (request->req_flags & req_null)
+			return true;
+	}
+
+	return aggRemove(tdbb, request, desc);
+}
+
 void AggNode::aggFinish(thread_db* /*tdbb*/, Request* request) const
 {
 	if (asb)
@@ -806,6 +825,24 @@ void AvgAggNode::aggPass(thread_db* tdbb, Request* request, dsc* desc) const
 		ArithmeticNode::add2(tdbb, desc, impure, this, blr_add);
 }
 
+bool AvgAggNode::aggRemove(thread_db* tdbb, Request* request, dsc* desc) const
+{
+	// Subtraction of approximate values does not restore the previous sum exactly.
+	if (nodFlags & (FLAG_DOUBLE | FLAG_DECFLOAT))
+		return false;
+
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+	fb_assert(impure->vlux_count > 0);
+	--impure->vlux_count;
+
+	if (dialect1)
+		ArithmeticNode::add(tdbb, desc, impure, this, blr_subtract);
+	else
+		ArithmeticNode::add2(tdbb, desc, impure, this, blr_subtract);
+
+	return true;
+}
+
 dsc* AvgAggNode::aggExecute(thread_db* tdbb, Request* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
@@ -1104,6 +1141,18 @@ void CountAggNode::aggPass(thread_db* /*tdbb*/, Request* request, dsc* /*desc*/)
 		++impure->vlu_misc.vlu_int64;
 }
 
+bool CountAggNode::aggRemove(thread_db* /*tdbb*/, Request* request, dsc* /*desc*/) const
+{
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+
+	if (dialect1)
+		--impure->vlu_misc.vlu_long;
+	else
+		--impure->vlu_misc.vlu_int64;
+
+	return true;
+}
+
 dsc* CountAggNode::aggExecute(thread_db* /*tdbb*/, Request* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
@@ -1366,6 +1415,24 @@ void SumAggNode::aggPass(thread_db* tdbb, Request* request, dsc* desc) const
 		ArithmeticNode::add2(tdbb, desc, impure, this, blr_add);
 }
 
+bool SumAggNode::aggRemove(thread_db* tdbb, Request* request, dsc* desc) const
+{
+	// Subtraction of approximate values does not restore the previous sum exactly.
+	if (nodFlags & (FLAG_DOUBLE | FLAG_DECFLOAT))
+		return false;
+
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+	fb_assert(impure->vlux_count > 0);
+	--impure->vlux_count;
+
+	if (dialect1)
+		ArithmeticNode::add(tdbb, desc, impure, this, blr_subtract);
+	else
+		ArithmeticNode::add2(tdbb, desc, impure, this, blr_subtract);
+
+	return true;
+}
+
 dsc* SumAggNode::aggExecute(thread_db* /*tdbb*/, Request* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
@@ -1456,6 +1523,20 @@ void MaxMinAggNode::aggPass(thread_db* tdbb, Request* request, dsc* desc) const
 		EVL_make_value(tdbb, desc, impure);
 }
 
+bool MaxMinAggNode::aggRemove(thread_db* tdbb, Request* request, dsc* desc) const
+{
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+
+	// Removal of the current max/min value requires to look for the next one.
+	if (!impure->vlu_desc.dsc_dtype || MOV_compare(tdbb, desc, &impure->vlu_desc) == 0)
+		return false;
+
+	fb_assert(impure->vlux_count > 0);
+	--impure->vlux_count;
+
+	return true;
+}
+
 dsc* MaxMinAggNode::aggExecute(thread_db* /*tdbb*/, Request* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
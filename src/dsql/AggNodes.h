@@ -71,7 +71,7 @@ public:
 
 	virtual unsigned getCapabilities() const
 	{
-		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS;
+		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS | CAP_SUPPORTS_REMOVE;
 	}
 
 	virtual Firebird::string internalPrint(NodePrinter& printer) const;
@@ -82,6 +82,7 @@ public:
 
 	virtual void aggInit(thread_db* tdbb, Request* request) const;
 	virtual void aggPass(thread_db* tdbb, Request* request, dsc* desc) const;
+	virtual bool aggRemove(thread_db* tdbb, Request* request, dsc* desc) const;
 	virtual dsc* aggExecute(thread_db* tdbb, Request* request) const;
 
 protected:
@@ -138,7 +139,7 @@ public:
 
 	virtual unsigned getCapabilities() const
 	{
-		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS;
+		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS | CAP_SUPPORTS_REMOVE;
 	}
 
 	virtual Firebird::string internalPrint(NodePrinter& printer) const;
@@ -149,6 +150,7 @@ public:
 
 	virtual void aggInit(thread_db* tdbb, Request* request) const;
 	virtual void aggPass(thread_db* tdbb, Request* request, dsc* desc) const;
+	virtual bool aggRemove(thread_db* tdbb, Request* request, dsc* desc) const;
 	virtual dsc* aggExecute(thread_db* tdbb, Request* request) const;
 
 protected:
@@ -169,7 +171,7 @@ public:
 
 	virtual unsigned getCapabilities() const
 	{
-		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS;
+		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS | CAP_SUPPORTS_REMOVE;
 	}
 
 	virtual Firebird::string internalPrint(NodePrinter& printer) const;
@@ -179,6 +181,7 @@ public:
 
 	virtual void aggInit(thread_db* tdbb, Request* request) const;
 	virtual void aggPass(thread_db* tdbb, Request* request, dsc* desc) const;
+	virtual bool aggRemove(thread_db* tdbb, Request* request, dsc* desc) const;
 	virtual dsc* aggExecute(thread_db* tdbb, Request* request) const;
 
 protected:
@@ -200,7 +203,7 @@ public:
 
 	virtual unsigned getCapabilities() const
 	{
-		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS;
+		return CAP_RESPECTS_WINDOW_FRAME | CAP_WANTS_AGG_CALLS | CAP_SUPPORTS_REMOVE;
 	}
 
 	virtual Firebird::string internalPrint(NodePrinter& printer) const;
@@ -210,6 +213,7 @@ public:
 
 	virtual void aggInit(thread_db* tdbb, Request* request) const;
 	virtual void aggPass(thread_db* tdbb, Request* request, dsc* desc) const;
+	virtual bool aggRemove(thread_db* tdbb, Request* request, dsc* desc) const;
 	virtual dsc* aggExecute(thread_db* tdbb, Request* request) const;
 
 protected:
@@ -721,6 +721,40 @@ void ComparativeBoolNode::pass2Boolean(thread_db* tdbb, CompilerScratch* csb, st
 	else if (DTYPE_IS_DATE(descriptor_b.dsc_dtype))
 		arg1->nodFlags |= FLAG_DATE;
 
+	// Choose a specialized comparison when both operand types are known to allow it.
+	// It's still verified at runtime, so a different descriptor just falls back to MOV_compare.
+
+	switch (blrOp)
+	{
+		case blr_eql:
+		case blr_equiv:
+		case blr_gtr:
+		case blr_geq:
+		case blr_lss:
+		case blr_leq:
+		case blr_neq:
+		case blr_between:
+			if (descriptor_a.isExact() && descriptor_b.isExact() &&
+				descriptor_a.dsc_dtype != dtype_int128 && descriptor_b.dsc_dtype != dtype_int128 &&
+				descriptor_a.dsc_scale == descriptor_b.dsc_scale)
+			{
+				specialization = SPEC_EXACT;
+			}
+			else if (descriptor_a.dsc_dtype == dtype_text && descriptor_b.dsc_dtype == dtype_text &&
+				descriptor_a.getTextType() == descriptor_b.getTextType())
+			{
+				switch (descriptor_a.getTextType())
+				{
+					case ttype_none:
+					case ttype_ascii:
+					case ttype_binary:
+						specialization = SPEC_BYTES;
+						break;
+				}
+			}
+			break;
+	}
+
 	if (nodFlags & FLAG_INVARIANT)
 		impureOffset = csb->allocImpure<impure_value>();
 	// Do not use FLAG_PATTERN_MATCHER_CACHE for blr_starting as it has very fast compilation.
@@ -856,13 +890,13 @@ bool ComparativeBoolNode::execute(thread_db* tdbb, Request* request) const
 		case blr_lss:
 		case blr_leq:
 		case blr_neq:
-			comparison = MOV_compare(tdbb, desc[0], desc[1]);
+			comparison = compare(tdbb, desc[0], desc[1]);
 			break;
 
 		case blr_between:
 			if (!null2)
 			{
-				comparison = MOV_compare(tdbb, desc[0], desc[1]);
+				comparison = compare(tdbb, desc[0], desc[1]);
 				if (comparison < 0)
 					return false;
 			}
@@ -912,7 +946,7 @@ bool ComparativeBoolNode::execute(thread_db* tdbb, Request* request) const
 			}
 			{
 				// arg1 <= arg3
-				const bool cmp1_3 = (MOV_compare(tdbb, desc[0], desc[1]) <= 0);
+				const bool cmp1_3 = (compare(tdbb, desc[0], desc[1]) <= 0);
 				if (null2)
 				{
 					if (cmp1_3)
@@ -936,6 +970,58 @@ bool ComparativeBoolNode::execute(thread_db* tdbb, Request* request) const
 	return false;
 }
 
+// Compare two values, using the comparison specialized in pass2 when the descriptors allow it.
+int ComparativeBoolNode::compare(thread_db* tdbb, const dsc* desc1, const dsc* desc2) const
+{
+	switch (specialization)
+	{
+		case SPEC_EXACT:
+		{
+			SINT64 value1, value2;
+
+			if (desc1->dsc_scale == desc2->dsc_scale &&
+				EVL_get_exact(desc1, value1) && EVL_get_exact(desc2, value2))
+			{
+				return (value1 == value2) ? 0 : (value1 > value2) ? 1 : -1;
+			}
+
+			break;
+		}
+
+		case SPEC_BYTES:
+			if (desc1->dsc_dtype == dtype_text && desc2->dsc_dtype == dtype_text &&
+				desc1->getTextType() == desc2->getTextType())
+			{
+				// Same rules as CVT2_compare uses for these character sets:
+				// compare the common part, then the rest of the longer one against the pad.
+
+				const USHORT length = MIN(desc1->dsc_length, desc2->dsc_length);
+				const int result = memcmp(desc1->dsc_address, desc2->dsc_address, length);
+
+				if (result)
+					return (result > 0) ? 1 : -1;
+
+				const UCHAR pad = (desc1->getTextType() == ttype_binary) ? '\0' : ' ';
+				const bool first = (desc1->dsc_length > length);
+				const UCHAR* p = (first ? desc1 : desc2)->dsc_address + length;
+				const UCHAR* const end = (first ? desc1 : desc2)->dsc_address +
+					(first ? desc1 : desc2)->dsc_length;
+
+				for (; p < end; ++p)
+				{
+					if (*p != pad)
+						return ((*p > pad) == first) ? 1 : -1;
+				}
+
+				return 0;
+			}
+
+			break;
+	}
+
+	return MOV_compare(tdbb, desc1, desc2);
+}
+
 // Perform one of the complex string functions CONTAINING, MATCHES, or STARTS WITH.
 bool ComparativeBoolNode::stringBoolean(thread_db* tdbb, Request* request, dsc* desc1,
 	dsc* desc2, bool computedInvariant) const
@@ -84,6 +84,14 @@ public:
 		DFLAG_ANSI_ANY
 	};
 
+	// Comparison specialized in pass2 by the data types of the operands.
+	enum Specialization : UCHAR
+	{
+		SPEC_NONE,
+		SPEC_EXACT,		// SMALLINT, INTEGER or BIGINT values of the same scale
+		SPEC_BYTES		// CHAR values of the same byte ordered character set
+	};
+
 	ComparativeBoolNode(MemoryPool& pool, UCHAR aBlrOp, ValueExprNode* aArg1 = nullptr,
 		ValueExprNode* aArg2 = nullptr, ValueExprNode* aArg3 = nullptr);
 
@@ -124,6 +132,7 @@ public:
 	virtual bool execute(thread_db* tdbb, Request* request) const;
 
 private:
+	int compare(thread_db* tdbb, const dsc* desc1, const dsc* desc2) const;
 	bool stringBoolean(thread_db* tdbb, Request* request, dsc* desc1, dsc* desc2,
 		bool computedInvariant) const;
 	bool sleuth(thread_db* tdbb, Request* request, const dsc* desc1, const dsc* desc2) const;
@@ -134,6 +143,7 @@ public:
 	UCHAR blrOp;
 	bool dsqlCheckBoolean;
 	DsqlFlag dsqlFlag;
+	Specialization specialization = SPEC_NONE;
 	NestConst<ValueExprNode> arg1;
 	NestConst<ValueExprNode> arg2;
 	NestConst<ValueExprNode> arg3;
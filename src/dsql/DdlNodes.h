@@ -1134,7 +1134,7 @@ public:
 	}
 
 	static SSHORT store(thread_db* tdbb, jrd_tra* transaction, const MetaName& name,
-		fb_sysflag sysFlag, SINT64 value, SLONG step);
+		fb_sysflag sysFlag, SINT64 value, SLONG step, SLONG cache = 0);
 
 public:
 	virtual Firebird::string internalPrint(NodePrinter& printer) const;
@@ -1164,6 +1164,7 @@ public:
 	const MetaName name;
 	std::optional<SINT64> value;
 	std::optional<SLONG> step;
+	std::optional<SLONG> cache;
 };
 
 
@@ -1602,6 +1603,7 @@ private:
 
 public:
 	const Firebird::string* externalFile;
+	const Firebird::string* externalFormat = nullptr;
 	std::optional<rel_t> relationType = rel_persistent;
 	bool preserveRowsOpt;
 	bool deleteRowsOpt;
@@ -24,6 +24,7 @@
 #include <ctype.h>
 #include "../common/TimeZoneUtil.h"
 #include "../common/classes/FpeControl.h"
+#include "../common/classes/GenericMap.h"
 #include "../common/classes/VaryStr.h"
 #include "../common/CvtFormat.h"
 #include "../dsql/ExprNodes.h"
@@ -197,6 +198,29 @@ namespace
 				(*node)->nodFlags &= ~ExprNode::FLAG_INVARIANT;
 		}
 	}
+
+	// Set the value from the output message of a PSQL or UDR function. Returns false for NULL.
+	bool getFunctionResult(Request* request, const Function* function, UCHAR* outMsg,
+		impure_value* value)
+	{
+		const dsc* fmtDesc = function->getOutputFormat()->fmt_desc.begin();
+		const ULONG nullOffset = (IPTR) fmtDesc[1].dsc_address;
+		SSHORT* const nullPtr = reinterpret_cast<SSHORT*>(outMsg + nullOffset);
+
+		if (*nullPtr)
+		{
+			request->req_flags |= req_null;
+			return false;
+		}
+
+		request->req_flags &= ~req_null;
+
+		const ULONG argOffset = (IPTR) fmtDesc[0].dsc_address;
+		value->vlu_desc = *fmtDesc;
+		value->vlu_desc.dsc_address = outMsg + argOffset;
+
+		return true;
+	}
 }
 
 namespace Jrd {
@@ -1978,6 +2002,36 @@ ValueExprNode* ArithmeticNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 	getDesc(tdbb, csb, &desc);
 	impureOffset = csb->allocImpure<impure_value>();
 
+	// Choose a specialized operation when both operand types are known to allow it.
+	// It's still verified at runtime, so a different descriptor just falls back to the generic code.
+
+	if (!dialect1 && blrOp != blr_divide)
+	{
+		dsc desc1, desc2;
+		arg1->getDesc(tdbb, csb, &desc1);
+		arg2->getDesc(tdbb, csb, &desc2);
+
+		const bool exact1 = desc1.isExact() && !desc1.isInt128();
+		const bool exact2 = desc2.isExact() && !desc2.isInt128();
+
+		if (!(nodFlags & (FLAG_DATE | FLAG_DECFLOAT | FLAG_INT128 | FLAG_DOUBLE)))
+		{
+			if (exact1 && exact2 && desc.dsc_dtype == dtype_int64 &&
+				(blrOp == blr_multiply || desc1.dsc_scale == desc2.dsc_scale))
+			{
+				specialization = SPEC_EXACT;
+			}
+		}
+		else if ((nodFlags & FLAG_DATE) && blrOp != blr_multiply && desc1.dsc_dtype == dtype_sql_date)
+		{
+			if ((exact2 && desc2.dsc_scale == 0) ||
+				(blrOp == blr_subtract && desc2.dsc_dtype == dtype_sql_date))
+			{
+				specialization = SPEC_DATE;
+			}
+		}
+	}
+
 	return this;
 }
 
@@ -2005,6 +2059,12 @@ dsc* ArithmeticNode::execute(thread_db* tdbb, Request* request) const
 	if (request->req_flags & req_null)
 		return NULL;
 
+	if (specialization != SPEC_NONE)
+	{
+		if (const auto result = executeSpecialized(desc1, desc2, impure))
+			return result;
+	}
+
 	EVL_make_value(tdbb, desc1, impure);
 
 	if (dialect1)	// dialect-1 semantics
@@ -2064,6 +2124,105 @@ dsc* ArithmeticNode::execute(thread_db* tdbb, Request* request) const
 	return NULL;
 }
 
+// Perform the operation specialized in pass2 without converting the operands.
+// Return NULL if the actual descriptors don't match the specialization.
+dsc* ArithmeticNode::executeSpecialized(const dsc* desc1, const dsc* desc2, impure_value* impure) const
+{
+	SINT64 i1, i2;
+
+	switch (specialization)
+	{
+		case SPEC_EXACT:
+		{
+			if (!EVL_get_exact(desc1, i1) || !EVL_get_exact(desc2, i2))
+				return NULL;
+
+			SINT64 result;
+
+			if (blrOp == blr_multiply)
+			{
+				if (desc1->dsc_scale + desc2->dsc_scale != nodScale)
+					return NULL;
+
+				// See multiply2() for the overflow check
+				const FB_UINT64 u1 = (i1 >= 0) ? i1 : -i1;
+				const FB_UINT64 u2 = (i2 >= 0) ? i2 : -i2;
+				const FB_UINT64 u_limit = ((i1 ^ i2) >= 0) ? MAX_SINT64 : (FB_UINT64) MAX_SINT64 + 1;
+
+				if ((u1 != 0) && ((u_limit / u1) < u2))
+					ERR_post(Arg::Gds(isc_exception_integer_overflow));
+
+				result = i1 * i2;
+			}
+			else
+			{
+				if (desc1->dsc_scale != nodScale || desc2->dsc_scale != nodScale)
+					return NULL;
+
+				// See add2() for the overflow check
+				if (blrOp == blr_subtract)
+				{
+					result = i1 - i2;
+					i2 ^= MIN_SINT64;
+				}
+				else
+					result = i1 + i2;
+
+				if ((i1 ^ i2) >= 0 && (i1 ^ result) < 0)
+					ERR_post(Arg::Gds(isc_exception_integer_overflow));
+			}
+
+			// Produce the same descriptor as the generic code does
+			impure->vlu_desc = *desc1;
+			impure->vlu_desc.dsc_dtype = dtype_int64;
+			impure->vlu_desc.dsc_length = sizeof(SINT64);
+			impure->vlu_desc.dsc_scale = nodScale;
+			impure->vlu_desc.dsc_address = (UCHAR*) &impure->vlu_misc.vlu_int64;
+			impure->vlu_misc.vlu_int64 = result;
+
+			if (blrOp != blr_multiply)
+				setFixedSubType(&impure->vlu_desc, *desc2, *desc1);
+
+			return &impure->vlu_desc;
+		}
+
+		case SPEC_DATE:
+		{
+			if (desc1->dsc_dtype != dtype_sql_date)
+				return NULL;
+
+			i1 = *(GDS_DATE*) desc1->dsc_address;
+
+			if (desc2->dsc_dtype == dtype_sql_date && blrOp == blr_subtract)
+			{
+				impure->vlu_desc = *desc1;
+				impure->make_int64(i1 - *(GDS_DATE*) desc2->dsc_address);
+				return &impure->vlu_desc;
+			}
+
+			if (desc2->dsc_scale != 0 || !EVL_get_exact(desc2, i2))
+				return NULL;
+
+			if (fb_utils::abs64Compare(i2, TimeStamp::MAX_DATE - TimeStamp::MIN_DATE) > 0)
+				ERR_post(Arg::Gds(isc_date_range_exceeded));
+
+			impure->vlu_misc.vlu_sql_date = (blrOp == blr_subtract) ? i1 - i2 : i1 + i2;
+
+			if (!TimeStamp::isValidDate(impure->vlu_misc.vlu_sql_date))
+				ERR_post(Arg::Gds(isc_date_range_exceeded));
+
+			impure->vlu_desc = *desc1;
+			impure->vlu_desc.dsc_scale = 0;
+			impure->vlu_desc.dsc_sub_type = 0;
+			impure->vlu_desc.dsc_address = (UCHAR*) &impure->vlu_misc.vlu_sql_date;
+
+			return &impure->vlu_desc;
+		}
+	}
+
+	return NULL;
+}
+
 // Add (or subtract) the contents of a descriptor to value block, with dialect-1 semantics.
 // This function can be removed when dialect-3 becomes the lowest supported dialect. (Version 7.0?)
 dsc* ArithmeticNode::add(thread_db* tdbb, const dsc* desc, impure_value* value, const ValueExprNode* node,
@@ -2192,8 +2351,17 @@ dsc* ArithmeticNode::add2(thread_db* tdbb, const dsc* desc, impure_value* value,
 
 	if (node->nodFlags & FLAG_INT128)
 	{
-		const Int128 d1 = MOV_get_int128(tdbb, desc, node->nodScale);
-		const Int128 d2 = MOV_get_int128(tdbb, &value->vlu_desc, node->nodScale);
+		// SUM of BIGINT values ends up here for every row, so avoid converting
+		// the operands when they already have the result scale.
+
+		SINT64 i1;
+		const bool exact = value->vlu_desc.dsc_dtype == dtype_int128 &&
+			value->vlu_desc.dsc_scale == node->nodScale && desc->dsc_scale == node->nodScale &&
+			EVL_get_exact(desc, i1);
+
+		const Int128 d1 = exact ? Int128().set(i1, 0) : MOV_get_int128(tdbb, desc, node->nodScale);
+		const Int128 d2 = exact ? value->vlu_misc.vlu_int128 :
+			MOV_get_int128(tdbb, &value->vlu_desc, node->nodScale);
 
 		value->vlu_misc.vlu_int128 = (blrOp == blr_subtract) ? d2.sub(d1) : d1.add(d2);
 
@@ -3707,6 +3875,21 @@ ValueExprNode* CastNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 {
 	ValueExprNode::pass2(tdbb, csb);
 
+	// Without validation, perform() returns the value "as is" when it already has the desired
+	// data type. When the source descriptor is known to not change at runtime, this can be
+	// decided here and the cast removed. Text is excluded, as its length may be adjusted
+	// at runtime depending on the character set.
+
+	if (!itemInfo && format.isEmpty() && !DTYPE_IS_TEXT(castDesc.dsc_dtype) &&
+		(nodeIs<LiteralNode>(source) || nodeIs<ParameterNode>(source) || nodeIs<VariableNode>(source)))
+	{
+		dsc sourceDesc;
+		source->getDesc(tdbb, csb, &sourceDesc);
+
+		if (DSC_EQUIV(&sourceDesc, &castDesc, true))
+			return source;
+	}
+
 	dsc desc;
 	getDesc(tdbb, csb, &desc);
 	impureOffset = csb->allocImpure<impure_value>();
@@ -5130,7 +5313,7 @@ ValueExprNode* DefaultNode::createFromField(thread_db* tdbb, CompilerScratch* cs
 			csb->csb_pool, (csb->blrVersion == 4), fld->fld_generator_name, NULL, true, true);
 
 		bool sysGen = false;
-		if (!MET_load_generator(tdbb, genNode->generator, &sysGen, &genNode->step))
+		if (!MET_load_generator(tdbb, genNode->generator, &sysGen, &genNode->step, &genNode->cache))
 			status_exception::raise(Arg::Gds(isc_gennotdef) << Arg::Str(fld->fld_generator_name));
 
 		if (sysGen)
@@ -7054,6 +7237,7 @@ GenIdNode::GenIdNode(MemoryPool& pool, bool aDialect1,
 	  generator(pool, name),
 	  arg(aArg),
 	  step(0),
+	  cache(0),
 	  dialect1(aDialect1),
 	  sysGen(false),
 	  implicit(aImplicit),
@@ -7080,7 +7264,7 @@ DmlNode* GenIdNode::parse(thread_db* tdbb, MemoryPool& pool, CompilerScratch* cs
 
 		node->generator.id = 0;
 	}
-	else if (!MET_load_generator(tdbb, node->generator, &node->sysGen, &node->step))
+	else if (!MET_load_generator(tdbb, node->generator, &node->sysGen, &node->step, &node->cache))
 		PAR_error(csb, Arg::Gds(isc_gennotdef) << Arg::Str(name));
 
 	if (csb->collectingDependencies())
@@ -7101,6 +7285,7 @@ string GenIdNode::internalPrint(NodePrinter& printer) const
 	NODE_PRINT(printer, generator);
 	NODE_PRINT(printer, arg);
 	NODE_PRINT(printer, step);
+	NODE_PRINT(printer, cache);
 	NODE_PRINT(printer, sysGen);
 	NODE_PRINT(printer, implicit);
 	NODE_PRINT(printer, identity);
@@ -7114,6 +7299,7 @@ ValueExprNode* GenIdNode::dsqlPass(DsqlCompilerScratch* dsqlScratch)
 		dialect1, generator.name, doDsqlPass(dsqlScratch, arg), implicit, identity);
 	node->generator = generator;
 	node->step = step;
+	node->cache = cache;
 	node->sysGen = sysGen;
 	return node;
 }
@@ -7175,6 +7361,7 @@ ValueExprNode* GenIdNode::copy(thread_db* tdbb, NodeCopier& copier) const
 				  copier.copy(tdbb, arg), implicit, identity);
 	node->generator = generator;
 	node->step = step;
+	node->cache = cache;
 	node->sysGen = sysGen;
 	return node;
 }
@@ -7254,7 +7441,10 @@ dsc* GenIdNode::execute(thread_db* tdbb, Request* request) const
 			status_exception::raise(Arg::Gds(isc_cant_modify_sysobj) << "generator" << generator.name);
 	}
 
-	const SINT64 new_val = DPM_gen_id(tdbb, generator.id, false, change);
+	// NEXT VALUE FOR may take the value from the range cached by the attachment
+	const SINT64 new_val = implicit ?
+		tdbb->getAttachment()->getGeneratorValue(tdbb, generator.id, step, cache) :
+		DPM_gen_id(tdbb, generator.id, false, change);
 
 	if (dialect1)
 		impure->make_long((SLONG) new_val);
@@ -12917,6 +13107,47 @@ dsc* TrimNode::execute(thread_db* tdbb, Request* request) const
 
 static RegisterNode<UdfCallNode> regUdfCallNode({blr_function, blr_function2, blr_subfunc, blr_invoke_function});
 
+// Results of a deterministic function evaluated by the request, keyed by the input message.
+// Its size is limited, the cache starts over when the limit is reached.
+class UdfCallNode::Memo
+{
+public:
+	static const FB_SIZE_T MAX_ENTRIES = 1024;
+	static const ULONG MAX_SIZE = 1024 * 1024;
+
+	explicit Memo(MemoryPool& pool)
+		: results(pool),
+		  size(0)
+	{
+	}
+
+	void clear()
+	{
+		results.clear();
+		size = 0;
+	}
+
+	const string* get(const UCHAR* inMsg, ULONG inMsgLength) const
+	{
+		const string key((const char*) inMsg, inMsgLength);
+		return results.get(key);
+	}
+
+	void put(const UCHAR* inMsg, ULONG inMsgLength, const UCHAR* outMsg, ULONG outMsgLength)
+	{
+		if (results.count() >= MAX_ENTRIES || size + inMsgLength + outMsgLength > MAX_SIZE)
+			clear();
+
+		const string key((const char*) inMsg, inMsgLength);
+		results.put(key, string((const char*) outMsg, outMsgLength));
+		size += inMsgLength + outMsgLength;
+	}
+
+private:
+	GenericMap<Pair<Full<string, string> > > results;
+	ULONG size;
+};
+
 UdfCallNode::UdfCallNode(MemoryPool& pool, const QualifiedName& aName,
 		ValueListNode* aArgs, ObjectsArray<MetaName>* aDsqlArgNames)
 	: TypedNode<ValueExprNode, ExprNode::TYPE_UDF_CALL>(pool),
@@ -13399,6 +13630,30 @@ ValueExprNode* UdfCallNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 		nodFlags |= FLAG_INVARIANT;
 		csb->csb_invariants.push(&impureOffset);
 	}
+	else if (function->fun_deterministic && function->isDefined() && !function->fun_entrypoint)
+	{
+		// Deterministic function with input arguments is expected to be returning the same
+		// result for the same arguments, so its results are remembered during the request
+		// execution. Blobs and arrays are passed by their ids, so they are not cached.
+
+		memoize = true;
+
+		for (const auto format : {function->getInputFormat(), function->getOutputFormat()})
+		{
+			if (!format)
+				continue;
+
+			for (const auto& desc : format->fmt_desc)
+			{
+				if (desc.isBlob() || desc.dsc_dtype == dtype_array)
+					memoize = false;
+			}
+		}
+
+		// The cache is invalidated at the request start, as the invariants are
+		if (memoize)
+			csb->csb_invariants.push(&impureOffset);
+	}
 
 	ValueExprNode::pass2(tdbb, csb);
 
@@ -13513,9 +13768,14 @@ dsc* UdfCallNode::execute(thread_db* tdbb, Request* request) const
 
 		const ULONG inMsgLength = function->getInputFormat() ? function->getInputFormat()->fmt_length : 0;
 		const ULONG outMsgLength = function->getOutputFormat()->fmt_length;
-		UCHAR* const inMsg = FB_ALIGN(impure + sizeof(impure_value), FB_ALIGNMENT);
+		UCHAR* const inMsg = FB_ALIGN(impure + sizeof(Impure), FB_ALIGNMENT);
 		UCHAR* const outMsg = FB_ALIGN(inMsg + inMsgLength, FB_ALIGNMENT);
 
+		// Clear the padding and unused string tails of the arguments, as the input message is
+		// the key of the results cache
+		if (memoize)
+			memset(inMsg, 0, inMsgLength);
+
 		if (function->fun_inputs != 0)
 		{
 			const dsc* fmtDesc = function->getInputFormat()->fmt_desc.begin();
@@ -13543,6 +13803,38 @@ dsc* UdfCallNode::execute(thread_db* tdbb, Request* request) const
 			}
 		}
 
+		Memo* memo = NULL;
+
+		if (memoize)
+		{
+			if (!impureArea->memo)
+			{
+				impureArea->memo =
+					FB_NEW_POOL(*tdbb->getDefaultPool()) Memo(*tdbb->getDefaultPool());
+			}
+			else if (!(invariantFlags & VLU_computed))
+				impureArea->memo->clear();	// left from the previous request execution
+
+			invariantFlags |= VLU_computed;
+			memo = impureArea->memo;
+
+			if (const string* const result = memo->get(inMsg, inMsgLength))
+			{
+				tdbb->bumpStats(RuntimeStatistics::FUNC_CACHE_HITS);
+
+				fb_assert(result->length() == outMsgLength);
+				memcpy(outMsg, result->c_str(), outMsgLength);
+				getFunctionResult(request, function, outMsg, value);
+
+				if (!(request->req_flags & req_null))
+					INTL_adjust_text_descriptor(tdbb, &value->vlu_desc);
+
+				return (request->req_flags & req_null) ? NULL : &value->vlu_desc;
+			}
+
+			tdbb->bumpStats(RuntimeStatistics::FUNC_CACHE_MISSES);
+		}
+
 		jrd_tra* transaction = request->req_transaction;
 
 		const SavNumber savNumber = transaction->tra_save_point ?
@@ -13588,31 +13880,19 @@ dsc* UdfCallNode::execute(thread_db* tdbb, Request* request) const
 			throw;
 		}
 
-		const dsc* fmtDesc = function->getOutputFormat()->fmt_desc.begin();
-		const ULONG nullOffset = (IPTR) fmtDesc[1].dsc_address;
-		SSHORT* const nullPtr = reinterpret_cast<SSHORT*>(outMsg + nullOffset);
-
-		if (*nullPtr)
-		{
-			request->req_flags |= req_null;
-			trace.finish(ITracePlugin::RESULT_SUCCESS);
-		}
-		else
-		{
-			request->req_flags &= ~req_null;
-
-			const ULONG argOffset = (IPTR) fmtDesc[0].dsc_address;
-			value->vlu_desc = *fmtDesc;
-			value->vlu_desc.dsc_address = outMsg + argOffset;
-
+		if (getFunctionResult(request, function, outMsg, value))
 			trace.finish(ITracePlugin::RESULT_SUCCESS, &value->vlu_desc);
-		}
+		else
+			trace.finish(ITracePlugin::RESULT_SUCCESS);
 
 		EXE_unwind(tdbb, funcRequest);
 
 		funcRequest->req_attachment = NULL;
 		funcRequest->req_flags &= ~(req_in_use | req_proc_fetch);
 		funcRequest->invalidateTimeStamp();
+
+		if (memo)
+			memo->put(inMsg, inMsgLength, outMsg, outMsgLength);
 	}
 
 	if (!(request->req_flags & req_null))
@@ -45,6 +45,14 @@ class ValueListNode;
 class ArithmeticNode final : public TypedNode<ValueExprNode, ExprNode::TYPE_ARITHMETIC>
 {
 public:
+	// Operation specialized in pass2 by the data types of the operands.
+	enum Specialization : UCHAR
+	{
+		SPEC_NONE,
+		SPEC_EXACT,		// SMALLINT, INTEGER or BIGINT operands with a BIGINT result
+		SPEC_DATE		// DATE +/- integer or DATE - DATE
+	};
+
 	ArithmeticNode(MemoryPool& pool, UCHAR aBlrOp, bool aDialect1,
 		ValueExprNode* aArg1 = NULL, ValueExprNode* aArg2 = NULL);
 
@@ -102,6 +110,7 @@ public:
 		const UCHAR blrOp);
 
 private:
+	dsc* executeSpecialized(const dsc* desc1, const dsc* desc2, impure_value* impure) const;
 	dsc* multiply(const dsc* desc, impure_value* value) const;
 	dsc* multiply2(const dsc* desc, impure_value* value) const;
 	dsc* divide2(const dsc* desc, impure_value* value) const;
@@ -123,6 +132,7 @@ public:
 	NestConst<ValueExprNode> arg2;
 	const UCHAR blrOp;
 	bool dialect1;
+	Specialization specialization = SPEC_NONE;
 };
 
 
@@ -887,6 +897,7 @@ public:
 	GeneratorItem generator;
 	NestConst<ValueExprNode> arg;
 	SLONG step;
+	SLONG cache;
 	const bool dialect1;
 
 private:
@@ -2140,10 +2151,13 @@ public:
 class UdfCallNode final : public TypedNode<ValueExprNode, ExprNode::TYPE_UDF_CALL>
 {
 private:
+	class Memo;
+
 	struct Impure
 	{
 		impure_value value;	// must be first
 		Firebird::Array<UCHAR>* temp;
+		Memo* memo;
 	};
 
 public:
@@ -2192,6 +2206,7 @@ public:
 private:
 	dsql_udf* dsqlFunction = nullptr;
 	bool isSubRoutine = false;
+	bool memoize = false;
 };
 
 
@@ -919,6 +919,8 @@ public:
 	static const unsigned CAP_WANTS_AGG_CALLS		= 0x04;
 	// wants winPass call in a window
 	static const unsigned CAP_WANTS_WIN_PASS_CALL	= 0x08;
+	// may remove values from the aggregation with aggRemove
+	static const unsigned CAP_SUPPORTS_REMOVE		= 0x10;
 
 protected:
 	struct AggInfo
@@ -1071,12 +1073,20 @@ public:
 	virtual void aggInit(thread_db* tdbb, Request* request) const = 0;	// pure, but defined
 	virtual void aggFinish(thread_db* tdbb, Request* request) const;
 	virtual bool aggPass(thread_db* tdbb, Request* request) const;
+	virtual bool aggRemove(thread_db* tdbb, Request* request) const;
 	virtual dsc* execute(thread_db* tdbb, Request* request) const;
 
 	virtual unsigned getCapabilities() const = 0;
 	virtual void aggPass(thread_db* tdbb, Request* request, dsc* desc) const = 0;
 	virtual dsc* aggExecute(thread_db* tdbb, Request* request) const = 0;
 
+	// Reverts a previous aggPass of the same value. Returns false if the aggregation
+	// cannot be reverted and should be started again.
+	virtual bool aggRemove(thread_db* /*tdbb*/, Request* /*request*/, dsc* /*desc*/) const
+	{
+		return false;
+	}
+
 	virtual AggNode* dsqlPass(DsqlCompilerScratch* dsqlScratch);
 
 protected:
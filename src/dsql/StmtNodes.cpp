@@ -9309,6 +9309,7 @@ const StmtNode* SetGeneratorNode::execute(thread_db* tdbb, Request* request, Exe
 
 		dsc* const desc = EVL_expr(tdbb, request, value);
 		DPM_gen_id(tdbb, generator.id, true, MOV_get_int64(tdbb, desc, 0));
+		tdbb->getAttachment()->invalidateGenRanges(tdbb, true);
 
 		DdlNode::executeDdlTrigger(tdbb, transaction, DdlNode::DTW_AFTER,
 			DDL_TRIGGER_ALTER_SEQUENCE, generator.name, NULL, *request->getStatement()->sqlText);
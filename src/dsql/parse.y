@@ -701,6 +701,7 @@ using namespace Firebird;
 
 %token <metaNamePtr> ANY_VALUE
 %token <metaNamePtr> BTRIM
+%token <metaNamePtr> CACHE
 %token <metaNamePtr> CALL
 %token <metaNamePtr> FORMAT
 %token <metaNamePtr> LTRIM
@@ -1935,6 +1936,7 @@ create_sequence_options($seqNode)
 create_seq_option($seqNode)
 	: start_with_opt($seqNode)
 	| step_option($seqNode)
+	| cache_option($seqNode)
 	;
 
 %type start_with_opt(<createAlterSequenceNode>)
@@ -1956,6 +1958,14 @@ by_noise
 	: // nothing
 	| BY
 
+%type cache_option(<createAlterSequenceNode>)
+cache_option($seqNode)
+	: CACHE signed_long_integer
+		{ setClause($seqNode->cache, "CACHE", $2); }
+	| NO CACHE
+		{ setClause($seqNode->cache, "CACHE", (SLONG) 1); }
+	;
+
 %type <createAlterSequenceNode> replace_sequence_clause
 replace_sequence_clause
 	: symbol_generator_name
@@ -1967,7 +1977,7 @@ replace_sequence_clause
 	  replace_sequence_options($2)
 		{
 			// Remove this to implement CORE-5137
-			if (!$2->restartSpecified && !$2->step.has_value())
+			if (!$2->restartSpecified && !$2->step.has_value() && !$2->cache.has_value())
 				yyerrorIncompleteCmd(YYPOSNARG(3));
 			$$ = $2;
 		}
@@ -1987,6 +1997,7 @@ replace_seq_option($seqNode)
 		}
 	| start_with_opt($seqNode)
 	| step_option($seqNode)
+	| cache_option($seqNode)
 	;
 
 %type <createAlterSequenceNode> alter_sequence_clause
@@ -2000,8 +2011,11 @@ alter_sequence_clause
 		}
 	  alter_sequence_options($2)
 		{
-			if (!$2->restartSpecified && !$2->value.has_value() && !$2->step.has_value())
+			if (!$2->restartSpecified && !$2->value.has_value() && !$2->step.has_value() &&
+				!$2->cache.has_value())
+			{
 				yyerrorIncompleteCmd(YYPOSNARG(3));
+			}
 			$$ = $2;
 		}
 
@@ -2015,6 +2029,7 @@ alter_sequence_options($seqNode)
 alter_seq_option($seqNode)
 	: restart_option($seqNode)
 	| step_option($seqNode)
+	| cache_option($seqNode)
 	;
 
 
@@ -2348,13 +2363,18 @@ page_noise
 
 %type <createRelationNode> table_clause
 table_clause
-	: simple_table_name external_file
+	: simple_table_name external_file external_format
 			{
-				$<createRelationNode>$ = newNode<CreateRelationNode>($1, $2);
+				if ($3 && !$2)
+					yyabandon(YYPOSNARG(3), -901, isc_ext_format_no_file);
+
+				CreateRelationNode* node = newNode<CreateRelationNode>($1, $2);
+				node->externalFormat = $3;
+				$<createRelationNode>$ = node;
 			}
-		'(' table_elements($3) ')' table_attributes($3)
+		'(' table_elements($4) ')' table_attributes($4)
 			{
-				$$ = $3;
+				$$ = $4;
 			}
 	;
 
@@ -2429,6 +2449,12 @@ external_file
 	| EXTERNAL utf_string			{ $$ = $2; }
 	;
 
+%type <stringPtr> external_format
+external_format
+	: /* nothing */					{ $$ = NULL; }
+	| FORMAT utf_string				{ $$ = $2; }
+	;
+
 %type table_elements(<createRelationNode>)
 table_elements($createRelationNode)
 	: table_element($createRelationNode)
@@ -9735,6 +9761,7 @@ non_reserved_word
 	| UNICODE_VAL
 	// added in FB 6.0
 	| ANY_VALUE
+	| CACHE
 	| FORMAT
 	| OWNER
 	;
@@ -84,6 +84,44 @@ struct PerformanceInfo
 		WRITES
 	};
 
+	// Wait counters, must correspond to RuntimeStatistics::StatType
+	// between WAIT_FIRST_ITEM and WAIT_LAST_ITEM. Every wait is represented
+	// by the number of waits followed by the total wait time in microseconds.
+	enum WaitCounters
+	{
+		PAGE_READ_WAITS = 19,
+		PAGE_READ_WAIT_TIME,
+		PAGE_WRITE_WAITS,
+		PAGE_WRITE_WAIT_TIME,
+		PAGE_LATCH_WAITS,
+		PAGE_LATCH_WAIT_TIME,
+		LOCK_DATABASE_WAITS,
+		LOCK_DATABASE_WAIT_TIME,
+		LOCK_METADATA_WAITS,
+		LOCK_METADATA_WAIT_TIME,
+		LOCK_BUFFER_WAITS,
+		LOCK_BUFFER_WAIT_TIME,
+		LOCK_TRANSACTION_WAITS,
+		LOCK_TRANSACTION_WAIT_TIME,
+		RECORD_CONFLICT_WAITS,
+		RECORD_CONFLICT_WAIT_TIME,
+		GARBAGE_COLLECT_WAITS,
+		GARBAGE_COLLECT_WAIT_TIME,
+		BACKOUT_WAITS,
+		BACKOUT_WAIT_TIME,
+		SORT_SPILL_WAITS,
+		SORT_SPILL_WAIT_TIME
+	};
+
+	// Result cache counters of deterministic functions,
+	// must correspond to RuntimeStatistics::FUNC_CACHE_HITS
+	// and RuntimeStatistics::FUNC_CACHE_MISSES.
+	enum FunctionCacheCounters
+	{
+		FUNCTION_CACHE_HITS = 41,
+		FUNCTION_CACHE_MISSES
+	};
+
 	ISC_INT64 pin_time;				// Total operation time in milliseconds
 	ISC_INT64* pin_counters;		// Pointer to allow easy addition of new counters
 
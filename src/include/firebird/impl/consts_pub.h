@@ -614,6 +614,7 @@
 //#define isc_spb_sts_table			0x40
 #define isc_spb_sts_nocreation		0x80
 #define isc_spb_sts_encryption	   0x100
+#define isc_spb_sts_io_stats	   0x200
 
 /***********************************/
 /* Server configuration key values */
@@ -178,6 +178,8 @@ enum db_info_types
 
 	fb_info_parallel_workers = 149,
 
+	fb_info_wire_stats = 150,
+
 	isc_info_db_last_value   /* Leave this LAST! */
 };
 
@@ -60,3 +60,15 @@ FB_IMPL_MSG_NO_SYMBOL(GSTAT, 59, "Gstat execution time @1")
 FB_IMPL_MSG_NO_SYMBOL(GSTAT, 60, "Gstat completion time @1")
 FB_IMPL_MSG_NO_SYMBOL(GSTAT, 61, "    Expected page inventory page @1")
 FB_IMPL_MSG_NO_SYMBOL(GSTAT, 62, "Generator pages: total @1, encrypted @2, non-crypted @3")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 63, "    -sample <percent> analyze randomly chosen percentage of data and index pages")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 64, "option -sample needs a percentage of pages between 0 and 100")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 65, "    -io     print I/O latencies of database files (implies -h)")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 66, "\nFile I/O latencies:")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 67, "    @1 file @2")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 68, "    Temporary files")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 69, "        @1: operations @2, bytes @3, time @4 us")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 70, "            under @1 us: @2")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 71, "            @1 us and more: @2")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 72, "    not available for this database")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 73, "    -par <n> analyze tables and indices by n parallel readers")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 74, "option -parallel needs a number of readers between 1 and @1")
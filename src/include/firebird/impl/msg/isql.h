@@ -205,3 +205,12 @@ FB_IMPL_MSG_SYMBOL(ISQL, 205, HLP_EXPLAIN, "EXPLAIN                    -- explai
 FB_IMPL_MSG_SYMBOL(ISQL, 206, USAGE_AUTOTERM, "	-autot(erm)             use auto statement terminator (set autoterm on)")
 FB_IMPL_MSG_SYMBOL(ISQL, 207, AUTOTERM_NOT_SUPPORTED, "SET AUTOTERM ON is not supported in engine/server and has been disabled")
 FB_IMPL_MSG_SYMBOL(ISQL, 208, HLP_SETAUTOTERM, "    SET AUTOTERM           -- toggle auto statement terminator")
+FB_IMPL_MSG_SYMBOL(ISQL, 209, HLP_IMPORT, "IMPORT   <table> FROM <filename> -- load rows from CSV or NATIVE file into table")
+FB_IMPL_MSG_SYMBOL(ISQL, 210, HLP_IMPORT2, "         [FORMAT CSV|NATIVE] [HEADER] [DELIMITER <char>]")
+FB_IMPL_MSG_SYMBOL(ISQL, 211, IMPORT_REPORT, "Rows imported: @1, elapsed time: @2 sec, rows per second: @3")
+FB_IMPL_MSG_SYMBOL(ISQL, 212, IMPORT_FAILED, "Import stopped at line @1 of the input file")
+FB_IMPL_MSG_SYMBOL(ISQL, 213, IMPORT_FIELD_COUNT, "Record has @1 fields, table has @2 columns")
+FB_IMPL_MSG_SYMBOL(ISQL, 214, IMPORT_TOO_LONG, "Value is too long for column @1")
+FB_IMPL_MSG_SYMBOL(ISQL, 215, IMPORT_NATIVE_BLOB, "NATIVE format can't be used with table having BLOB columns")
+FB_IMPL_MSG_SYMBOL(ISQL, 216, IMPORT_TRUNCATED, "Unexpected end of file inside of record")
+FB_IMPL_MSG_SYMBOL(ISQL, 217, IMPORT_FAILED_NATIVE, "Import stopped at record @1 of the input file")
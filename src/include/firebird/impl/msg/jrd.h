@@ -987,3 +987,7 @@ FB_IMPL_MSG(JRD, 984, incompatible_format_patterns, -901, "HY", "000", "@1 incom
 FB_IMPL_MSG(JRD, 985, only_one_pattern_can_be_used, -901, "HY", "000", "Can use only one of these patterns @1")
 FB_IMPL_MSG(JRD, 986, can_not_use_same_pattern_twice, -901, "HY", "000", "Cannot use the same pattern twice: @1")
 FB_IMPL_MSG(JRD, 987, sysf_invalid_gen_uuid_version, -833, "42", "000", "Invalid GEN_UUID version (@1). Must be 4 or 7")
+FB_IMPL_MSG(JRD, 988, ext_format_invalid, -901, "42", "000", "Invalid format @1 of external file")
+FB_IMPL_MSG(JRD, 989, ext_format_no_file, -901, "42", "000", "FORMAT can be specified only for tables with EXTERNAL FILE")
+FB_IMPL_MSG(JRD, 990, ext_record_too_long, -901, "22", "000", "Record at position @1 of external file @2 is too long")
+FB_IMPL_MSG(JRD, 991, gen_cache_invalid, -901, "42", "000", "CACHE @1 is an illegal option for sequence @2")
@@ -4321,6 +4321,7 @@ const
 	isc_spb_sts_record_versions = $20;
 	isc_spb_sts_nocreation = $80;
 	isc_spb_sts_encryption = $100;
+	isc_spb_sts_io_stats = $200;
 	isc_spb_nbk_level = byte(5);
 	isc_spb_nbk_file = byte(6);
 	isc_spb_nbk_direct = byte(7);
@@ -4507,6 +4508,7 @@ const
 	fb_info_username = byte(147);
 	fb_info_sqlrole = byte(148);
 	fb_info_parallel_workers = byte(149);
+	fb_info_wire_stats = byte(150);
 	fb_info_crypt_encrypted = $01;
 	fb_info_crypt_process = $02;
 	fb_feature_multi_statements = byte(1);
@@ -5731,6 +5733,10 @@ const
 	 isc_only_one_pattern_can_be_used = 335545305;
 	 isc_can_not_use_same_pattern_twice = 335545306;
 	 isc_sysf_invalid_gen_uuid_version = 335545307;
+	 isc_ext_format_invalid = 335545308;
+	 isc_ext_format_no_file = 335545309;
+	 isc_ext_record_too_long = 335545310;
+	 isc_gen_cache_invalid = 335545311;
 	 isc_gfix_db_name = 335740929;
 	 isc_gfix_invalid_sw = 335740930;
 	 isc_gfix_incmp_sw = 335740932;
@@ -0,0 +1,131 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include "../isql/CsvReader.h"
+#include <string.h>
+
+
+bool CsvReader::next()
+{
+	data.clear();
+	fields.clear();
+	fieldStart = 0;
+
+	int c = getChar();
+
+	// Skip empty lines between records
+	while (c == '\n' || c == '\r')
+	{
+		if (c == '\n')
+			++line;
+		c = getChar();
+	}
+
+	if (c == EOF)
+		return false;
+
+	recordLine = line;
+
+	while (true)
+	{
+		if (c == '"')
+		{
+			while (true)
+			{
+				c = getChar();
+
+				if (c == EOF)
+					throw Error{"Unterminated quoted field", recordLine};
+
+				if (c == '"')
+				{
+					c = getChar();
+					if (c != '"')
+						break;
+				}
+				else if (c == '\n')
+					++line;
+
+				data += (char) c;
+			}
+
+			if (c == '\r')
+				c = getChar();
+
+			if (c != delimiter && c != '\n' && c != EOF)
+				throw Error{"Unexpected character after quoted field", line};
+
+			endField(true);
+		}
+		else
+		{
+			while (c != delimiter && c != '\n' && c != EOF)
+			{
+				data += (char) c;
+				c = getChar();
+			}
+
+			// CR of CRLF line end is not a part of data
+			if (c != delimiter && data.size() > fieldStart && data.back() == '\r')
+				data.pop_back();
+
+			endField(false);
+		}
+
+		if (c != delimiter)
+			break;
+
+		c = getChar();
+	}
+
+	if (c == '\n')
+		++line;
+
+	return true;
+}
+
+
+int CsvReader::getChar()
+{
+	if (bufferPos == bufferLength)
+	{
+		if (file)
+			bufferLength = fread(buffer, 1, sizeof(buffer), file);
+		else
+		{
+			bufferLength = source.copy(buffer, sizeof(buffer));
+			source.remove_prefix(bufferLength);
+		}
+
+		bufferPos = 0;
+
+		if (!bufferLength)
+			return EOF;
+	}
+
+	return (unsigned char) buffer[bufferPos++];
+}
+
+
+void CsvReader::endField(bool quoted)
+{
+	const unsigned length = (unsigned) (data.size() - fieldStart);
+
+	fields.push_back({fieldStart, length, !quoted && !length});
+	fieldStart = data.size();
+}
@@ -0,0 +1,110 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#ifndef FB_ISQL_CSV_READER_H
+#define FB_ISQL_CSV_READER_H
+
+#include <stdio.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Streaming reader of comma separated values (RFC 4180) used by IMPORT command.
+// Fields may be enclosed in double quotes, doubled quote inside quoted field
+// stands for the quote itself, quoted fields may span several lines.
+// Empty unquoted field means NULL, empty quoted field is an empty string.
+
+class CsvReader
+{
+public:
+	struct Error
+	{
+		std::string message;
+		unsigned line;
+	};
+
+	struct Field
+	{
+		const char* data;		// nullptr for NULL
+		unsigned length;
+	};
+
+public:
+	explicit CsvReader(FILE* aFile, char aDelimiter = ',')
+		: file(aFile),
+		  delimiter(aDelimiter)
+	{
+	}
+
+	explicit CsvReader(std::string_view aSource, char aDelimiter = ',')
+		: source(aSource),
+		  delimiter(aDelimiter)
+	{
+	}
+
+	CsvReader(const CsvReader&) = delete;
+	CsvReader& operator=(const CsvReader&) = delete;
+
+public:
+	// Read the next record, return false at end of input, throw Error if it's malformed
+	bool next();
+
+	unsigned getCount() const
+	{
+		return (unsigned) fields.size();
+	}
+
+	Field getField(unsigned n) const
+	{
+		const auto& field = fields[n];
+		return {field.isNull ? nullptr : data.data() + field.offset, field.length};
+	}
+
+	// Line where the last read record begins
+	unsigned getLine() const
+	{
+		return recordLine;
+	}
+
+private:
+	struct FieldPos
+	{
+		size_t offset;
+		unsigned length;
+		bool isNull;
+	};
+
+	int getChar();
+	void endField(bool quoted);
+
+private:
+	FILE* file = nullptr;
+	std::string_view source;
+	char delimiter;
+
+	char buffer[65536];
+	size_t bufferPos = 0;
+	size_t bufferLength = 0;
+
+	std::string data;
+	std::vector<FieldPos> fields;
+	size_t fieldStart = 0;
+	unsigned line = 1;
+	unsigned recordLine = 0;
+};
+
+#endif	// FB_ISQL_CSV_READER_H
@@ -0,0 +1,124 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../CsvReader.h"
+
+BOOST_AUTO_TEST_SUITE(ISqlSuite)
+BOOST_AUTO_TEST_SUITE(CsvReaderSuite)
+
+
+static std::string field(const CsvReader& reader, unsigned n)
+{
+	const auto f = reader.getField(n);
+	return f.data ? std::string(f.data, f.length) : "<null>";
+}
+
+
+BOOST_AUTO_TEST_CASE(SimpleTest)
+{
+	CsvReader reader("1,abc,\r\n\n2,,x\n3");
+
+	BOOST_TEST(reader.next());
+	BOOST_TEST(reader.getLine() == 1u);
+	BOOST_TEST(reader.getCount() == 3u);
+	BOOST_TEST(field(reader, 0) == "1");
+	BOOST_TEST(field(reader, 1) == "abc");
+	BOOST_TEST(field(reader, 2) == "<null>");
+
+	BOOST_TEST(reader.next());
+	BOOST_TEST(reader.getLine() == 3u);
+	BOOST_TEST(reader.getCount() == 3u);
+	BOOST_TEST(field(reader, 1) == "<null>");
+	BOOST_TEST(field(reader, 2) == "x");
+
+	BOOST_TEST(reader.next());
+	BOOST_TEST(reader.getCount() == 1u);
+	BOOST_TEST(field(reader, 0) == "3");
+
+	BOOST_TEST(!reader.next());
+}
+
+BOOST_AUTO_TEST_CASE(QuotedTest)
+{
+	CsvReader reader("\"a,b\",\"\",\"say \"\"hi\"\"\"\r\n\"multi\nline\";x\n", ',');
+
+	BOOST_TEST(reader.next());
+	BOOST_TEST(reader.getCount() == 3u);
+	BOOST_TEST(field(reader, 0) == "a,b");
+	BOOST_TEST(field(reader, 1) == "");
+	BOOST_TEST(field(reader, 2) == "say \"hi\"");
+
+	BOOST_CHECK_THROW(reader.next(), CsvReader::Error);
+}
+
+BOOST_AUTO_TEST_CASE(DelimiterTest)
+{
+	CsvReader reader("\"multi\nline\";x\ny;\"z\"", ';');
+
+	BOOST_TEST(reader.next());
+	BOOST_TEST(reader.getCount() == 2u);
+	BOOST_TEST(field(reader, 0) == "multi\nline");
+	BOOST_TEST(field(reader, 1) == "x");
+
+	BOOST_TEST(reader.next());
+	BOOST_TEST(reader.getLine() == 3u);
+	BOOST_TEST(field(reader, 1) == "z");
+
+	BOOST_TEST(!reader.next());
+}
+
+BOOST_AUTO_TEST_CASE(MalformedTest)
+{
+	CsvReader reader("1,\"abc");
+
+	try
+	{
+		reader.next();
+		BOOST_TEST(false);
+	}
+	catch (const CsvReader::Error& error)
+	{
+		BOOST_TEST(error.line == 1u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(LongInputTest)
+{
+	std::string source;
+
+	for (unsigned i = 0; i < 20000; ++i)
+		source += std::to_string(i) + ",\"" + std::string(i % 10, 'q') + "\"\n";
+
+	CsvReader reader(source);
+	unsigned count = 0;
+
+	while (reader.next())
+	{
+		BOOST_REQUIRE(reader.getCount() == 2u);
+		BOOST_REQUIRE(field(reader, 0) == std::to_string(count));
+		BOOST_REQUIRE(reader.getField(1).length == count % 10);
+		++count;
+	}
+
+	BOOST_TEST(count == 20000u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()	// CsvReaderSuite
+BOOST_AUTO_TEST_SUITE_END()	// ISqlSuite
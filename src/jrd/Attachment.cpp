@@ -34,6 +34,7 @@
 #include "../jrd/intl.h"
 
 #include "../jrd/blb_proto.h"
+#include "../jrd/dpm_proto.h"
 #include "../jrd/exe_proto.h"
 #include "../jrd/ext_proto.h"
 #include "../jrd/intl_proto.h"
@@ -263,6 +264,7 @@ Jrd::Attachment::Attachment(MemoryPool* pool, Database* dbb, JProvider* provider
 	  att_procedures(*pool),
 	  att_functions(*pool),
 	  att_generators(*pool),
+	  att_gen_ranges(*pool),
 	  att_internal(*pool),
 	  att_dyn_req(*pool),
 	  att_internal_cached_statements(*pool),
@@ -749,6 +751,10 @@ void Jrd::Attachment::initLocks(thread_db* tdbb)
 			Lock(tdbb, 0, LCK_repl_tables, this, blockingAstReplSet);
 		att_repl_lock = lock;
 
+		lock = FB_NEW_RPT(*att_pool, 0)
+			Lock(tdbb, 0, LCK_gen_ranges, this, blockingAstGenRanges);
+		att_gen_lock = lock;
+
 		lock = FB_NEW_RPT(*att_pool, 0)
 			Lock(tdbb, sizeof(AttNumber), LCK_profiler_listener, this, ProfilerManager::blockingAst);
 		att_profiler_listener_lock = lock;
@@ -876,6 +882,9 @@ void Jrd::Attachment::releaseLocks(thread_db* tdbb)
 	if (att_repl_lock)
 		LCK_release(tdbb, att_repl_lock);
 
+	if (att_gen_lock)
+		LCK_release(tdbb, att_gen_lock);
+
 	if (att_profiler_listener_lock)
 		LCK_release(tdbb, att_profiler_listener_lock);
 
@@ -1192,6 +1201,100 @@ int Attachment::blockingAstReplSet(void* ast_object)
 	return 0;
 }
 
+SINT64 Attachment::getGeneratorValue(thread_db* tdbb, SLONG genId, SLONG step, SLONG cache)
+{
+	// Sequences changed by the current transaction keep their values in the transaction
+	// level cache until commit, let DPM_gen_id deal with them
+
+	jrd_tra* const transaction = tdbb->getTransaction();
+	SINT64 value;
+
+	if (cache < 2 || !step || !att_gen_lock ||
+		(transaction && transaction->tra_gen_ids && transaction->tra_gen_ids->get(genId, value)))
+	{
+		return DPM_gen_id(tdbb, genId, false, step);
+	}
+
+	// The lock is released when another attachment changes any sequence,
+	// the ranges are cleared at the same time
+
+	if (att_gen_lock->lck_logical == LCK_none)
+		LCK_lock(tdbb, att_gen_lock, LCK_SR, LCK_WAIT);
+
+	if (att_gen_ranges.getValue(genId, step, value))
+		return value;
+
+	// Reserve the whole range at once, the generator page is left at its last value
+
+	const SINT64 last = DPM_gen_id(tdbb, genId, false, (SINT64) step * cache);
+
+	// The blocking AST could clear the ranges and release the lock while the page
+	// was being changed, then the sequence could be changed too and the range is not kept
+
+	if (att_gen_lock->lck_logical == LCK_none)
+		return GeneratorRangeMap::getFirstValue(last, step, cache);
+
+	return att_gen_ranges.putRange(genId, last, step, cache);
+}
+
+void Attachment::invalidateGenRanges(thread_db* tdbb, bool broadcast)
+{
+	if (!att_gen_lock)
+		return;
+
+	if (broadcast)
+	{
+		// Signal other attachments about the changed sequence
+		if (att_gen_lock->lck_logical == LCK_none)
+			LCK_lock(tdbb, att_gen_lock, LCK_EX, LCK_WAIT);
+		else
+			LCK_convert(tdbb, att_gen_lock, LCK_EX, LCK_WAIT);
+	}
+
+	att_gen_ranges.clear();
+
+	LCK_release(tdbb, att_gen_lock);
+}
+
+void Attachment::releaseGenRanges(thread_db* tdbb)
+{
+	// Give back the values left in the ranges, unless the sequence
+	// has been changed by someone else after the reservation
+
+	try
+	{
+		for (const auto& item : att_gen_ranges)
+		{
+			const GeneratorRange& range = item.second;
+
+			if (range.count)
+				DPM_gen_release(tdbb, item.first, range.last, range.next - range.step);
+		}
+	}
+	catch (const Exception&)
+	{} // no-op, the values are just lost
+
+	att_gen_ranges.clear();
+}
+
+int Attachment::blockingAstGenRanges(void* ast_object)
+{
+	Attachment* const attachment = static_cast<Attachment*>(ast_object);
+
+	try
+	{
+		Database* const dbb = attachment->att_database;
+
+		AsyncContextHolder tdbb(dbb, FB_FUNCTION, attachment->att_gen_lock);
+
+		attachment->invalidateGenRanges(tdbb, false);
+	}
+	catch (const Exception&)
+	{} // no-op
+
+	return 0;
+}
+
 ProfilerManager* Attachment::getProfilerManager(thread_db* tdbb)
 {
 	auto profilerManager = att_profiler_manager.get();
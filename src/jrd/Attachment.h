@@ -485,6 +485,62 @@ public:
 		Firebird::Array<MetaName> m_objects;
 	};
 
+	// Range of values reserved by the attachment for a sequence declared with CACHE
+	struct GeneratorRange
+	{
+		SINT64 next;	// next value to return
+		SINT64 last;	// value stored in the generator page by the reservation
+		SLONG step;		// increment the range was reserved with
+		SLONG count;	// number of values left in the range
+	};
+
+	class GeneratorRangeMap :
+		public Firebird::GenericMap<Firebird::Pair<Firebird::NonPooled<SLONG, GeneratorRange> > >
+	{
+	public:
+		explicit GeneratorRangeMap(MemoryPool& pool)
+			: GenericMap(pool)
+		{}
+
+		// First value of the range reserved by advancing the sequence up to the last one
+		static SINT64 getFirstValue(SINT64 last, SLONG step, SLONG cache)
+		{
+			return last - (SINT64) step * (cache - 1);
+		}
+
+		// Take the next value of the range reserved with the same increment, if any
+		bool getValue(SLONG genId, SLONG step, SINT64& value)
+		{
+			GeneratorRange* const range = get(genId);
+
+			if (!range || !range->count || range->step != step)
+				return false;
+
+			value = range->next;
+			range->next += step;
+			range->count--;
+			return true;
+		}
+
+		// Keep the values of the reserved range following the returned first one
+		SINT64 putRange(SLONG genId, SINT64 last, SLONG step, SLONG cache)
+		{
+			const SINT64 value = getFirstValue(last, step, cache);
+
+			GeneratorRange* range = get(genId);
+
+			if (!range)
+				range = put(genId);
+
+			range->next = value + step;
+			range->last = last;
+			range->step = step;
+			range->count = cache - 1;
+
+			return value;
+		}
+	};
+
 	class InitialOptions
 	{
 	public:
@@ -663,6 +719,7 @@ public:
 	TrigVector*						att_ddl_triggers;
 	Firebird::Array<Function*>		att_functions;			// User defined functions
 	GeneratorFinder					att_generators;
+	GeneratorRangeMap				att_gen_ranges;		// Cached ranges of sequence values
 
 	Firebird::Array<Statement*>	att_internal;			// internal statements
 	Firebird::Array<Statement*>	att_dyn_req;			// internal dyn statements
@@ -689,6 +746,7 @@ public:
 	static int blockingAstCancel(void*);
 	static int blockingAstMonitor(void*);
 	static int blockingAstReplSet(void*);
+	static int blockingAstGenRanges(void*);
 
 	Firebird::Array<MemoryPool*>	att_pools;		// pools
 
@@ -845,6 +903,10 @@ public:
 	void checkReplSetLock(thread_db* tdbb);
 	void invalidateReplSet(thread_db* tdbb, bool broadcast);
 
+	SINT64 getGeneratorValue(thread_db* tdbb, SLONG genId, SLONG step, SLONG cache);
+	void invalidateGenRanges(thread_db* tdbb, bool broadcast);
+	void releaseGenRanges(thread_db* tdbb);
+
 	ProfilerManager* getProfilerManager(thread_db* tdbb);
 	ProfilerManager* getActiveProfilerManagerForNonInternalStatement(thread_db* tdbb);
 	bool isProfilerActive();
@@ -870,6 +932,7 @@ private:
 	Firebird::AutoPtr<ProfilerManager> att_profiler_manager;	// ProfilerManager
 
 	Lock* att_repl_lock;				// Replication set lock
+	Lock* att_gen_lock;					// Cached generator ranges lock
 	JProvider* att_provider;	// Provider which created this attachment
 };
 
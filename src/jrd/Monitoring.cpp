@@ -29,7 +29,9 @@
 #include "../jrd/ids.h"
 #include "../jrd/ini.h"
 #include "../jrd/nbak.h"
+#include "../jrd/os/pio.h"
 #include "../jrd/req.h"
+#include "../jrd/sdw.h"
 #include "../jrd/tra.h"
 #include "../jrd/blb_proto.h"
 #include "../common/isc_proto.h"
@@ -465,6 +467,12 @@ MonitoringSnapshot::MonitoringSnapshot(thread_db* tdbb, MemoryPool& pool)
 	const auto ctx_var_buffer = allocBuffer(tdbb, pool, rel_mon_ctx_vars);
 	const auto mem_usage_buffer = allocBuffer(tdbb, pool, rel_mon_mem_usage);
 	const auto tab_stat_buffer = allocBuffer(tdbb, pool, rel_mon_tab_stats);
+	const auto wait_stat_buffer = dbb->getEncodedOdsVersion() >= ODS_14_0 ?
+		allocBuffer(tdbb, pool, rel_mon_wait_stats) :
+		nullptr;
+	const auto file_stat_buffer = dbb->getEncodedOdsVersion() >= ODS_14_0 ?
+		allocBuffer(tdbb, pool, rel_mon_file_io_stats) :
+		nullptr;
 
 	// Increment the global monitor generation
 
@@ -592,6 +600,12 @@ MonitoringSnapshot::MonitoringSnapshot(thread_db* tdbb, MemoryPool& pool)
 		case rel_mon_tab_stats:
 			buffer = tab_stat_buffer;
 			break;
+		case rel_mon_wait_stats:
+			buffer = wait_stat_buffer;
+			break;
+		case rel_mon_file_io_stats:
+			buffer = file_stat_buffer;
+			break;
 		default:
 			fb_assert(false);
 		}
@@ -966,6 +980,33 @@ void Monitoring::putDatabase(thread_db* tdbb, SnapshotData::DumpRecord& record)
 		putStatistics(record, zero_rt_stats, stat_id, stat_database);
 		putMemoryUsage(record, zero_mem_stats, stat_id, stat_database);
 	}
+
+	// I/O latencies of the database files, as seen by the current process
+
+	const auto pageSpace = dbb->dbb_page_manager.findPageSpace(DB_PAGE_SPACE);
+
+	for (const jrd_file* file = pageSpace->file; file; file = file->fil_next)
+		putFileStatistics(record, file->fil_io_stats, file->fil_string, io_file_database);
+
+	{	// scope
+		SyncLockGuard shadowGuard(&dbb->dbb_shadow_sync, SYNC_SHARED, FB_FUNCTION);
+
+		for (const Shadow* shadow = dbb->dbb_shadow; shadow; shadow = shadow->sdw_next)
+		{
+			for (const jrd_file* file = shadow->sdw_file; file; file = file->fil_next)
+				putFileStatistics(record, file->fil_io_stats, file->fil_string, io_file_shadow);
+		}
+	}
+
+	if (bm && !bm->isShutDown())
+	{
+		BackupManager::StateReadGuard holder(tdbb);
+
+		if (const auto file = bm->getDiffFile())
+			putFileStatistics(record, file->fil_io_stats, file->fil_string, io_file_delta);
+	}
+
+	putFileStatistics(record, TempSpace::getIoStats(), "", io_file_temporary);
 }
 
 
@@ -1387,6 +1428,70 @@ void Monitoring::putStatistics(SnapshotData::DumpRecord& record, const RuntimeSt
 		record.storeInteger(f_mon_rec_imgc, (*iter).getCounter(RuntimeStatistics::RECORD_IMGC));
 		record.write();
 	}
+
+	// wait statistics, only events that really happened
+
+	static_assert(wait_sort_spill + 1 == RuntimeStatistics::WAIT_TOTAL_EVENTS,
+		"wait types must correspond to RuntimeStatistics::StatType");
+
+	for (unsigned i = 0; i < RuntimeStatistics::WAIT_TOTAL_EVENTS; i++)
+	{
+		const auto type = RuntimeStatistics::StatType(RuntimeStatistics::WAIT_FIRST_ITEM + i * 2);
+		const auto count = statistics.getValue(type);
+
+		if (!count)
+			continue;
+
+		record.reset(rel_mon_wait_stats);
+		record.storeGlobalId(f_mon_wait_stat_id, id);
+		record.storeInteger(f_mon_wait_stat_group, stat_group);
+		record.storeInteger(f_mon_wait_type, i);
+		record.storeInteger(f_mon_wait_count, count);
+		record.storeInteger(f_mon_wait_time, statistics.getValue(RuntimeStatistics::StatType(type + 1)));
+		record.write();
+	}
+}
+
+
+void Monitoring::putFileStatistics(SnapshotData::DumpRecord& record, const IoLatencyStats& stats,
+								   const PathName& fileName, int fileType)
+{
+	static_assert(io_operation_sync + 1 == IoLatencyStats::IO_OPERATIONS,
+		"I/O operations must correspond to IoLatencyStats::Operation");
+
+	PathName name(fileName);
+	ISC_systemToUtf8(name);
+
+	for (unsigned op = 0; op < IoLatencyStats::IO_OPERATIONS; op++)
+	{
+		const auto& histogram = stats.get(IoLatencyStats::Operation(op));
+
+		// only buckets that really have something
+
+		for (unsigned bucket = 0; bucket < IoLatencyHistogram::BUCKETS; bucket++)
+		{
+			const auto count = histogram.getCount(bucket);
+
+			if (!count)
+				continue;
+
+			record.reset(rel_mon_file_io_stats);
+
+			if (name.hasData())
+				record.storeString(f_mon_fio_file_name, name);
+
+			record.storeInteger(f_mon_fio_file_type, fileType);
+			record.storeInteger(f_mon_fio_operation, op);
+
+			if (const auto bound = IoLatencyHistogram::getBound(bucket))
+				record.storeInteger(f_mon_fio_bound, bound);
+
+			record.storeInteger(f_mon_fio_count, count);
+			record.storeInteger(f_mon_fio_bytes, histogram.getBytes(bucket));
+			record.storeInteger(f_mon_fio_time, histogram.getTime(bucket));
+			record.write();
+		}
+	}
 }
 
 
@@ -415,6 +415,8 @@ private:
 	static void putStatistics(SnapshotData::DumpRecord&, const RuntimeStatistics&, int, int);
 	static void putContextVars(SnapshotData::DumpRecord&, const Firebird::StringMap&, SINT64, bool);
 	static void putMemoryUsage(SnapshotData::DumpRecord&, const Firebird::MemoryStats&, int, int);
+	static void putFileStatistics(SnapshotData::DumpRecord&, const Firebird::IoLatencyStats&,
+								  const Firebird::PathName&, int);
 };
 
 } // namespace
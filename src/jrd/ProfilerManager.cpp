@@ -104,7 +104,7 @@ namespace
 			alignas(FB_ALIGNMENT) UCHAR buffer[4096];
 		};
 
-		static const USHORT VERSION = 2;
+		static const USHORT VERSION = 3;
 
 	public:
 		ProfilerIpc(thread_db* tdbb, MemoryPool& pool, AttNumber aAttachmentId, bool server = false);
@@ -350,13 +350,16 @@ void ProfilerPackage::startSessionFunction(ThrowStatusExceptionWrapper* /*status
 	const string description(in->description.str, in->descriptionNull ? 0 : in->description.length);
 	const std::optional<SLONG> flushInterval(in->flushIntervalNull ?
 		std::nullopt : std::optional{in->flushInterval});
+	const std::optional<SLONG> samplingInterval(in->samplingIntervalNull ?
+		std::nullopt : std::optional{in->samplingInterval});
 	const PathName pluginName(in->pluginName.str, in->pluginNameNull ? 0 : in->pluginName.length);
 	const string pluginOptions(in->pluginOptions.str, in->pluginOptionsNull ? 0 : in->pluginOptions.length);
 
 	const auto profilerManager = attachment->getProfilerManager(tdbb);
 
 	out->sessionIdNull = FB_FALSE;
-	out->sessionId = profilerManager->startSession(tdbb, flushInterval, pluginName, description, pluginOptions);
+	out->sessionId = profilerManager->startSession(tdbb, flushInterval, samplingInterval,
+		pluginName, description, pluginOptions);
 }
 
 
@@ -377,11 +380,14 @@ ProfilerManager::ProfilerManager(thread_db* tdbb)
 		flush(false);
 		updateFlushTimer(false);
 	});
+
+	samplingTimer = FB_NEW SamplingTimer();
 }
 
 ProfilerManager::~ProfilerManager()
 {
 	flushTimer->stop();
+	samplingTimer->stop();
 }
 
 ProfilerManager* ProfilerManager::create(thread_db* tdbb)
@@ -415,11 +421,15 @@ int ProfilerManager::blockingAst(void* astObject)
 }
 
 SINT64 ProfilerManager::startSession(thread_db* tdbb, std::optional<SLONG> flushInterval,
-	const PathName& pluginName, const string& description, const string& options)
+	std::optional<SLONG> samplingInterval, const PathName& pluginName, const string& description,
+	const string& options)
 {
 	if (flushInterval.has_value())
 		checkFlushInterval(flushInterval.value());
 
+	if (samplingInterval.has_value())
+		checkSamplingInterval(samplingInterval.value());
+
 	AutoSetRestore<bool> pauseProfiler(&paused, true);
 
 	const auto attachment = tdbb->getAttachment();
@@ -476,6 +486,10 @@ SINT64 ProfilerManager::startSession(thread_db* tdbb, std::optional<SLONG> flush
 
 	paused = false;
 
+	currentSamplingInterval = (unsigned) samplingInterval.value_or(0);
+	samplingTicks = (SINT64) currentSamplingInterval * fb_utils::query_performance_frequency() / 1000;
+	updateSamplingTimer();
+
 	if (flushInterval.has_value())
 		setFlushInterval(flushInterval.value());
 
@@ -568,6 +582,8 @@ void ProfilerManager::cancelSession()
 		currentSession->pluginSession->cancel(&status);
 		currentSession = nullptr;
 	}
+
+	updateSamplingTimer();
 }
 
 void ProfilerManager::finishSession(thread_db* tdbb, bool flushData)
@@ -582,6 +598,8 @@ void ProfilerManager::finishSession(thread_db* tdbb, bool flushData)
 		currentSession = nullptr;
 	}
 
+	updateSamplingTimer();
+
 	if (flushData)
 		flush();
 }
@@ -589,7 +607,10 @@ void ProfilerManager::finishSession(thread_db* tdbb, bool flushData)
 void ProfilerManager::pauseSession(bool flushData)
 {
 	if (currentSession)
+	{
 		paused = true;
+		updateSamplingTimer();
+	}
 
 	if (flushData)
 		flush();
@@ -601,6 +622,7 @@ void ProfilerManager::resumeSession()
 	{
 		paused = false;
 		updateFlushTimer();
+		updateSamplingTimer();
 	}
 }
 
@@ -617,6 +639,7 @@ void ProfilerManager::discard()
 {
 	currentSession = nullptr;
 	activePlugins.clear();
+	updateSamplingTimer();
 }
 
 void ProfilerManager::flush(bool updateTimer)
@@ -652,6 +675,97 @@ void ProfilerManager::updateFlushTimer(bool canStopTimer)
 		flushTimer->stop();
 }
 
+void ProfilerManager::updateSamplingTimer()
+{
+	if (!currentSession)
+		currentSamplingInterval = 0;
+
+	if (currentSession && !paused && currentSamplingInterval)
+	{
+		samplingTimer->start(currentSamplingInterval);
+		lastSampleTicks = queryTicks();
+	}
+	else
+		samplingTimer->stop();
+}
+
+// Attribute the time passed since the previous sample to everything being executed at the moment:
+// PSQL lines of the request and its callers and all the open / fetching record sources. It's longer
+// than the sampling interval if the timer fired while no sample could be taken.
+void ProfilerManager::takeSample(Request* request)
+{
+	const SINT64 currentTicks = queryTicks();
+	Stats stats(lastSampleTicks ? currentTicks - lastSampleTicks : samplingTicks);
+	lastSampleTicks = currentTicks;
+
+	for (auto psqlRequest = request; psqlRequest; psqlRequest = psqlRequest->req_caller)
+	{
+		if (psqlRequest->req_src_line && !psqlRequest->hasInternalStatement())
+		{
+			afterPsqlLineColumn(psqlRequest, psqlRequest->req_src_line, psqlRequest->req_src_column, stats);
+
+			if (!isActive())	// the plugin failed and session is gone
+				return;
+		}
+	}
+
+	for (auto watcher = activeWatchers; watcher && isActive(); watcher = watcher->previous)
+	{
+		if (watcher->event == RecordSourceStopWatcher::Event::OPEN)
+			afterRecordSourceOpen(watcher->request, watcher->recordSource, stats);
+		else
+			afterRecordSourceGetRecord(watcher->request, watcher->recordSource, stats);
+	}
+}
+
+void ProfilerManager::SamplingTimer::handler()
+{
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	if (!interval)	// stopped while the timer was fired
+		return;
+
+	due = true;
+
+	LocalStatus ls;
+	CheckStatusWrapper s(&ls);
+	TimerInterfacePtr()->start(&s, this, (ISC_UINT64) interval * 1000);
+}
+
+void ProfilerManager::SamplingTimer::start(unsigned aInterval)
+{
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	if (interval == aInterval)
+		return;
+
+	LocalStatus ls;
+	CheckStatusWrapper s(&ls);
+	ITimerControl* timerCtrl = TimerInterfacePtr();
+
+	if (interval)
+		timerCtrl->stop(&s, this);
+
+	interval = aInterval;
+	timerCtrl->start(&s, this, (ISC_UINT64) interval * 1000);
+	check(&s);
+}
+
+void ProfilerManager::SamplingTimer::stop()
+{
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	if (!interval)
+		return;
+
+	interval = 0;
+	due = false;
+
+	LocalStatus ls;
+	CheckStatusWrapper s(&ls);
+	TimerInterfacePtr()->stop(&s, this);
+}
+
 ProfilerManager::Statement* ProfilerManager::getStatement(Request* request)
 {
 	if (!isActive())
@@ -1122,6 +1236,8 @@ void ProfilerListener::processCommand(thread_db* tdbb)
 				in->descriptionNull ? 0 : in->description.length);
 			const std::optional<SLONG> flushInterval(in->flushIntervalNull ?
 				std::nullopt : std::optional{in->flushInterval});
+			const std::optional<SLONG> samplingInterval(in->samplingIntervalNull ?
+				std::nullopt : std::optional{in->samplingInterval});
 			const PathName pluginName(in->pluginName.str,
 				in->pluginNameNull ? 0 : in->pluginName.length);
 			const string pluginOptions(in->pluginOptions.str,
@@ -1132,7 +1248,7 @@ void ProfilerListener::processCommand(thread_db* tdbb)
 			header->bufferSize = sizeof(*out);
 
 			out->sessionIdNull = FB_FALSE;
-			out->sessionId = profilerManager->startSession(tdbb, flushInterval,
+			out->sessionId = profilerManager->startSession(tdbb, flushInterval, samplingInterval,
 				pluginName, description, pluginOptions);
 
 			break;
@@ -1264,6 +1380,7 @@ ProfilerPackage::ProfilerPackage(MemoryPool& pool)
 					{"ATTACHMENT_ID", fld_att_id, true, "null", {blr_null}},
 					{"PLUGIN_NAME", fld_file_name2, true, "null", {blr_null}},
 					{"PLUGIN_OPTIONS", fld_short_description, true, "null", {blr_null}},
+					{"SAMPLING_INTERVAL", fld_integer, true, "null", {blr_null}},
 				},
 				{fld_prof_ses_id, false}
 			)
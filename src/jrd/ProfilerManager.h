@@ -25,6 +25,7 @@
 
 #include "firebird.h"
 #include "firebird/Message.h"
+#include <atomic>
 #include <optional>
 #include "../common/PerformanceStopWatch.h"
 #include "../common/classes/auto.h"
@@ -94,6 +95,14 @@ public:
 		{
 			if (profilerManager)
 			{
+				if (profilerManager->isSampling())
+				{
+					// Active record sources are only tracked, samples report them
+					profilerManager->checkSample(request);
+					profilerManager->pushWatcher(this);
+					return;
+				}
+
 				lastTicks = profilerManager->queryTicks();
 
 				if (profilerManager->currentSession->flags & Firebird::IProfilerSession::FLAG_BEFORE_EVENTS)
@@ -110,7 +119,9 @@ public:
 
 		~RecordSourceStopWatcher()
 		{
-			if (profilerManager)
+			if (sampling)
+				profilerManager->popWatcher(this);
+			else if (profilerManager)
 			{
 				const SINT64 currentTicks = profilerManager->queryTicks();
 				const SINT64 elapsedTicks = profilerManager->getElapsedTicksAndAdjustOverhead(
@@ -125,15 +136,42 @@ public:
 		}
 
 	private:
+		friend class ProfilerManager;
+
 		Request* request;
 		ProfilerManager* profilerManager;
 		const AccessPath* recordSource;
 		SINT64 lastTicks;
 		SINT64 lastAccumulatedOverhead;
 		Event event;
+		bool sampling = false;
+		RecordSourceStopWatcher* previous = nullptr;
 	};
 
 private:
+	// Timer of the sampling mode, it only marks the next sample as due
+	// and the attachment takes it at the nearest record source or PSQL event.
+	class SamplingTimer final :
+		public Firebird::RefCntIface<Firebird::ITimerImpl<SamplingTimer, Firebird::CheckStatusWrapper>>
+	{
+	public:
+		// ITimer implementation
+		void handler();
+
+		void start(unsigned aInterval);
+		void stop();
+
+		bool isDue()
+		{
+			return due.load(std::memory_order_relaxed) && due.exchange(false);
+		}
+
+	private:
+		Firebird::Mutex mutex;
+		std::atomic<bool> due = false;
+		unsigned interval = 0;	// milliseconds, zero when stopped
+	};
+
 	class Statement final
 	{
 	public:
@@ -187,7 +225,7 @@ public:
 	void operator=(const ProfilerManager&) = delete;
 
 public:
-	SINT64 startSession(thread_db* tdbb, std::optional<SLONG> flushInterval,
+	SINT64 startSession(thread_db* tdbb, std::optional<SLONG> flushInterval, std::optional<SLONG> samplingInterval,
 		const Firebird::PathName& pluginName, const Firebird::string& description, const Firebird::string& options);
 
 	void prepareCursor(thread_db* tdbb, Request* request, const Select* select);
@@ -278,6 +316,25 @@ public:
 		return listener.hasData();
 	}
 
+	// In the sampling mode the events are not measured but sampled by the timer
+	bool isSampling() const
+	{
+		return currentSamplingInterval != 0;
+	}
+
+	void checkSample(Request* request)
+	{
+		if (isActive() && samplingTimer->isDue())
+			takeSample(request);
+	}
+
+	// Time between the top level calls is not sampled
+	void resetSampling(SINT64 currentTicks)
+	{
+		lastSampleTicks = currentTicks;
+		samplingTimer->isDue();
+	}
+
 	static void checkFlushInterval(SLONG interval)
 	{
 		if (interval < 0)
@@ -289,6 +346,17 @@ public:
 		}
 	}
 
+	static void checkSamplingInterval(SLONG interval)
+	{
+		if (interval < 0)
+		{
+			Firebird::status_exception::raise(
+				Firebird::Arg::Gds(isc_not_valid_for_var) <<
+				"SAMPLING_INTERVAL" <<
+				Firebird::Arg::Num(interval));
+		}
+	}
+
 private:
 	void prepareRecSource(thread_db* tdbb, Request* request, const AccessPath* recordSource);
 
@@ -301,6 +369,30 @@ private:
 	void flush(bool updateTimer = true);
 
 	void updateFlushTimer(bool canStopTimer = true);
+	void updateSamplingTimer();
+
+	void takeSample(Request* request);
+
+	void pushWatcher(RecordSourceStopWatcher* watcher)
+	{
+		watcher->sampling = true;
+		watcher->previous = activeWatchers;
+		activeWatchers = watcher;
+	}
+
+	void popWatcher(RecordSourceStopWatcher* watcher)
+	{
+		// Usually it's the top one, but another request of the attachment
+		// may run while this one is checked out of the engine
+		for (auto ptr = &activeWatchers; *ptr; ptr = &(*ptr)->previous)
+		{
+			if (*ptr == watcher)
+			{
+				*ptr = watcher->previous;
+				break;
+			}
+		}
+	}
 
 	Statement* getStatement(Request* request);
 
@@ -344,7 +436,12 @@ private:
 	Firebird::LeftPooledMap<Firebird::PathName, Firebird::AutoPlugin<Firebird::IProfilerPlugin>> activePlugins;
 	Firebird::AutoPtr<Session> currentSession;
 	Firebird::RefPtr<Firebird::TimerImpl> flushTimer;
+	Firebird::RefPtr<SamplingTimer> samplingTimer;
+	RecordSourceStopWatcher* activeWatchers = nullptr;
+	SINT64 samplingTicks = 0;
+	SINT64 lastSampleTicks = 0;
 	unsigned currentFlushInterval = 0;
+	unsigned currentSamplingInterval = 0;
 	bool paused = false;
 };
 
@@ -431,6 +528,7 @@ private:
 		(FB_BIGINT, attachmentId)
 		(FB_INTL_VARCHAR(255 * METADATA_BYTES_PER_CHAR, CS_METADATA), pluginName)
 		(FB_INTL_VARCHAR(255 * METADATA_BYTES_PER_CHAR, CS_METADATA), pluginOptions)
+		(FB_INTEGER, samplingInterval)
 	);
 
 	FB_MESSAGE(StartSessionOutput, Firebird::ThrowStatusExceptionWrapper,
@@ -26,11 +26,20 @@
 
 #include "../jrd/RuntimeStatistics.h"
 #include "../jrd/ntrace.h"
+#include "../common/utils_proto.h"
 
 using namespace Firebird;
 
 namespace Jrd {
 
+static_assert((int) PerformanceInfo::PAGE_READ_WAITS == (int) RuntimeStatistics::WAIT_PAGE_READ &&
+	(int) PerformanceInfo::SORT_SPILL_WAIT_TIME == (int) RuntimeStatistics::WAIT_LAST_ITEM,
+	"Wait counters of PerformanceInfo must correspond to RuntimeStatistics::StatType");
+
+static_assert((int) PerformanceInfo::FUNCTION_CACHE_HITS == (int) RuntimeStatistics::FUNC_CACHE_HITS &&
+	(int) PerformanceInfo::FUNCTION_CACHE_MISSES == (int) RuntimeStatistics::FUNC_CACHE_MISSES,
+	"Function cache counters of PerformanceInfo must correspond to RuntimeStatistics::StatType");
+
 GlobalPtr<RuntimeStatistics> RuntimeStatistics::dummy;
 
 void RuntimeStatistics::findAndBumpRelValue(const StatType index, SLONG relation_id, SINT64 delta)
@@ -153,4 +162,24 @@ RuntimeStatistics::Accumulator::~Accumulator()
 		m_tdbb->bumpRelStats(m_type, m_id, m_counter);
 }
 
+SINT64 RuntimeStatistics::WaitTimer::getCounter()
+{
+	return fb_utils::query_performance_counter();
+}
+
+RuntimeStatistics::WaitTimer::~WaitTimer()
+{
+	if (!m_tdbb)
+		return;
+
+	const SINT64 frequency = fb_utils::query_performance_frequency();
+	const SINT64 elapsed = getCounter() - m_start;
+
+	// Avoid overflow while converting long waits to microseconds
+	const SINT64 time = elapsed / frequency * 1000000 + elapsed % frequency * 1000000 / frequency;
+
+	m_tdbb->bumpStats(m_type);
+	m_tdbb->bumpStats(StatType(m_type + 1), time);
+}
+
 } // namespace
@@ -74,9 +74,39 @@ public:
 		RECORD_RPT_READS,
 		RECORD_IMGC,
 		RECORD_LAST_ITEM = RECORD_IMGC,
+		// Every wait event is a pair of counters: number of waits
+		// followed by the total wait time in microseconds
+		WAIT_FIRST_ITEM,
+		WAIT_PAGE_READ = WAIT_FIRST_ITEM,
+		WAIT_PAGE_READ_TIME,
+		WAIT_PAGE_WRITE,
+		WAIT_PAGE_WRITE_TIME,
+		WAIT_PAGE_LATCH,
+		WAIT_PAGE_LATCH_TIME,
+		WAIT_LOCK_DATABASE,
+		WAIT_LOCK_DATABASE_TIME,
+		WAIT_LOCK_METADATA,
+		WAIT_LOCK_METADATA_TIME,
+		WAIT_LOCK_BUFFER,
+		WAIT_LOCK_BUFFER_TIME,
+		WAIT_LOCK_TRANSACTION,
+		WAIT_LOCK_TRANSACTION_TIME,
+		WAIT_RECORD_CONFLICT,
+		WAIT_RECORD_CONFLICT_TIME,
+		WAIT_GARBAGE_COLLECT,
+		WAIT_GARBAGE_COLLECT_TIME,
+		WAIT_BACKOUT,
+		WAIT_BACKOUT_TIME,
+		WAIT_SORT_SPILL,
+		WAIT_SORT_SPILL_TIME,
+		WAIT_LAST_ITEM = WAIT_SORT_SPILL_TIME,
+		FUNC_CACHE_HITS,
+		FUNC_CACHE_MISSES,
 		TOTAL_ITEMS		// last
 	};
 
+	static const size_t WAIT_TOTAL_EVENTS = (WAIT_LAST_ITEM - WAIT_FIRST_ITEM + 1) / 2;
+
 private:
 	static const size_t REL_BASE_OFFSET = RECORD_FIRST_ITEM;
 	static const size_t REL_TOTAL_ITEMS = RECORD_LAST_ITEM - REL_BASE_OFFSET + 1;
@@ -364,6 +394,28 @@ public:
 		SINT64 m_counter;
 	};
 
+	// Accounts the time spent in its scope as a wait of the given kind
+
+	class WaitTimer
+	{
+	public:
+		WaitTimer(thread_db* tdbb, StatType type)
+			: m_tdbb(tdbb), m_type(type), m_start(getCounter())
+		{
+			fb_assert(type >= WAIT_FIRST_ITEM && type <= WAIT_LAST_ITEM);
+			fb_assert((type - WAIT_FIRST_ITEM) % 2 == 0);
+		}
+
+		~WaitTimer();
+
+	private:
+		static SINT64 getCounter();
+
+		thread_db* m_tdbb;
+		StatType m_type;
+		SINT64 m_start;
+	};
+
 private:
 	void addRelCounts(const RelCounters& other, bool add);
 
@@ -41,6 +41,7 @@ using namespace Jrd;
 GlobalPtr<Mutex> TempSpace::initMutex;
 TempDirectoryList* TempSpace::tempDirs = NULL;
 FB_SIZE_T TempSpace::minBlockSize = 0;
+IoLatencyStats TempSpace::ioStats;
 
 namespace
 {
@@ -116,6 +117,8 @@ FB_SIZE_T TempSpace::FileBlock::read(offset_t offset, void* buffer, FB_SIZE_T le
 		length = size - offset;
 	}
 	offset += seek;
+
+	IoLatencyStats::Timer timer(ioStats, IoLatencyStats::IO_READ, length);
 	return file->read(offset, buffer, length);
 }
 
@@ -126,6 +129,8 @@ FB_SIZE_T TempSpace::FileBlock::write(offset_t offset, const void* buffer, FB_SI
 		length = size - offset;
 	}
 	offset += seek;
+
+	IoLatencyStats::Timer timer(ioStats, IoLatencyStats::IO_WRITE, length);
 	return file->write(offset, buffer, length);
 }
 
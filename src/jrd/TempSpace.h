@@ -30,6 +30,7 @@
 #include "../common/config/dir_list.h"
 #include "../common/classes/init.h"
 #include "../common/classes/tree.h"
+#include "../common/classes/IoLatency.h"
 
 class TempSpace : public Firebird::File
 {
@@ -66,6 +67,13 @@ public:
 	ULONG allocateBatch(ULONG count, FB_SIZE_T minSize, FB_SIZE_T maxSize, Segments& segments);
 
 	bool validate(offset_t& freeSize) const;
+
+	// I/O latencies of all temporary files of the process
+	static const Firebird::IoLatencyStats& getIoStats()
+	{
+		return ioStats;
+	}
+
 private:
 
 	// Generic space block
@@ -215,6 +223,7 @@ private:
 	static Firebird::GlobalPtr<Firebird::Mutex> initMutex;
 	static Firebird::TempDirectoryList* tempDirs;
 	static FB_SIZE_T minBlockSize;
+	static Firebird::IoLatencyStats ioStats;
 };
 
 #endif // JRD_TEMP_SPACE_H
@@ -0,0 +1,379 @@
+/*
+ *	PROGRAM:	Engine Benchmarks
+ *	MODULE:		Benchmark.cpp
+ *	DESCRIPTION:	Microbenchmark harness
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+
+#include "../../jrd/bench/Benchmark.h"
+#include "../../jrd/build_no.h"
+#include "../../common/classes/objects_array.h"
+#include "../../common/os/os_utils.h"
+#include "../../common/utils_proto.h"
+
+using namespace Firebird;
+
+namespace
+{
+	struct BenchmarkResult
+	{
+		explicit BenchmarkResult(MemoryPool& pool)
+			: name(pool)
+		{}
+
+		BenchmarkResult(MemoryPool& pool, const BenchmarkResult& other)
+			: name(pool, other.name), items(other.items), repetitions(other.repetitions),
+			  minTime(other.minTime), medianTime(other.medianTime),
+			  meanTime(other.meanTime), maxTime(other.maxTime)
+		{}
+
+		double getItemTime() const
+		{
+			return medianTime / (items ? items : 1);
+		}
+
+		string name;
+		FB_UINT64 items = 0;
+		unsigned repetitions = 0;
+		double minTime = 0;
+		double medianTime = 0;
+		double meanTime = 0;
+		double maxTime = 0;
+	};
+
+	typedef ObjectsArray<BenchmarkResult> BenchmarkResults;
+
+	void usage(const char* program)
+	{
+		fprintf(stderr,
+			"usage: %s [options]\n"
+			"  --list                  list benchmarks and exit\n"
+			"  --filter=<text>         run benchmarks which names contain <text>\n"
+			"  --warmup=<n>            passes not counted in the results (default 2)\n"
+			"  --repetitions=<n>       counted passes (default 10)\n"
+			"  --threads=<n>           threads of the concurrent benchmarks (default 4)\n"
+			"  --json=<file>           write results to the JSON file\n"
+			"  --baseline=<file>       compare results with JSON file of the previous run\n"
+			"  --threshold=<percent>   slowdown reported as regression (default 10)\n",
+			program);
+	}
+
+	void writeJson(const char* fileName, const BenchmarkResults& results,
+		unsigned warmup, unsigned repetitions, unsigned threads)
+	{
+		FILE* const file = os_utils::fopen(fileName, "w");
+		if (!file)
+			system_call_failed::raise("fopen");
+
+		char date[32];
+		const time_t now = time(NULL);
+		strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+		fprintf(file, "{\n");
+		fprintf(file, "  \"context\": {\n");
+		fprintf(file, "    \"version\": \"%s\",\n", PRODUCT_VER_STRING);
+#ifdef DEV_BUILD
+		fprintf(file, "    \"build\": \"debug\",\n");
+#else
+		fprintf(file, "    \"build\": \"release\",\n");
+#endif
+		fprintf(file, "    \"date\": \"%s\",\n", date);
+		fprintf(file, "    \"warmup\": %u,\n", warmup);
+		fprintf(file, "    \"repetitions\": %u,\n", repetitions);
+		fprintf(file, "    \"threads\": %u\n", threads);
+		fprintf(file, "  },\n");
+		fprintf(file, "  \"benchmarks\": [\n");
+
+		// One benchmark per line, the baseline reader relies on it
+		for (FB_SIZE_T i = 0; i < results.getCount(); i++)
+		{
+			const BenchmarkResult& result = results[i];
+
+			fprintf(file, "    {\"name\": \"%s\", \"items\": %" UQUADFORMAT ", \"repetitions\": %u, "
+				"\"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, \"max_ns\": %.1f, "
+				"\"ns_per_item\": %.3f}%s\n",
+				result.name.c_str(), result.items, result.repetitions,
+				result.minTime, result.medianTime, result.meanTime, result.maxTime,
+				result.getItemTime(), (i + 1 < results.getCount()) ? "," : "");
+		}
+
+		fprintf(file, "  ]\n");
+		fprintf(file, "}\n");
+
+		fclose(file);
+	}
+
+	// Returns number of regressions found
+	unsigned compareBaseline(const char* fileName, const BenchmarkResults& results, double threshold)
+	{
+		FILE* const file = os_utils::fopen(fileName, "r");
+		if (!file)
+			system_call_failed::raise("fopen");
+
+		const char* const NAME = "{\"name\": \"";
+		const char* const ITEM_TIME = "\"ns_per_item\": ";
+
+		unsigned regressions = 0;
+		char line[1024];
+
+		while (fgets(line, sizeof(line), file))
+		{
+			const char* name = strstr(line, NAME);
+			const char* itemTime = strstr(line, ITEM_TIME);
+			if (!name || !itemTime)
+				continue;
+
+			name += strlen(NAME);
+			const char* const nameEnd = strchr(name, '"');
+			if (!nameEnd)
+				continue;
+
+			const string baseName(name, nameEnd - name);
+			const double baseTime = atof(itemTime + strlen(ITEM_TIME));
+
+			for (const auto& result : results)
+			{
+				if (result.name != baseName || baseTime <= 0)
+					continue;
+
+				const double change = (result.getItemTime() - baseTime) * 100 / baseTime;
+
+				if (change > threshold)
+				{
+					printf("REGRESSION %s: %.3f -> %.3f ns/item (%+.1f%%)\n",
+						baseName.c_str(), baseTime, result.getItemTime(), change);
+					regressions++;
+				}
+
+				break;
+			}
+		}
+
+		fclose(file);
+		return regressions;
+	}
+}
+
+
+namespace Jrd {
+
+Benchmark* Benchmark::list = NULL;
+
+Benchmark::Benchmark(const char* name, BenchmarkRoutine* routine)
+	: m_name(name), m_routine(routine), m_next(list)
+{
+	list = this;
+}
+
+int Benchmark::runAll(int argc, char** argv)
+{
+	MemoryPool& pool = *getDefaultMemoryPool();
+
+	string filter, jsonFile, baselineFile;
+	unsigned warmup = 2, repetitions = 10, threads = 4;
+	double threshold = 10;
+	bool listOnly = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const string arg(argv[i]);
+		const FB_SIZE_T pos = arg.find('=');
+		const string key(arg.substr(0, pos));
+		const string value(pos == string::npos ? "" : arg.substr(pos + 1));
+
+		if (key == "--list")
+			listOnly = true;
+		else if (key == "--filter")
+			filter = value;
+		else if (key == "--warmup")
+			warmup = atoi(value.c_str());
+		else if (key == "--repetitions")
+			repetitions = atoi(value.c_str());
+		else if (key == "--threads")
+			threads = atoi(value.c_str());
+		else if (key == "--json")
+			jsonFile = value;
+		else if (key == "--baseline")
+			baselineFile = value;
+		else if (key == "--threshold")
+			threshold = atof(value.c_str());
+		else
+		{
+			usage(argv[0]);
+			return FINI_ERROR;
+		}
+	}
+
+	if (!repetitions || !threads)
+	{
+		usage(argv[0]);
+		return FINI_ERROR;
+	}
+
+	// Run benchmarks in the order of names
+
+	HalfStaticArray<Benchmark*, 64> benchmarks;
+
+	for (Benchmark* benchmark = list; benchmark; benchmark = benchmark->m_next)
+	{
+		if (filter.isEmpty() || strstr(benchmark->m_name, filter.c_str()))
+		{
+			FB_SIZE_T pos = 0;
+			while (pos < benchmarks.getCount() && strcmp(benchmarks[pos]->m_name, benchmark->m_name) < 0)
+				pos++;
+
+			benchmarks.insert(pos, benchmark);
+		}
+	}
+
+	if (listOnly)
+	{
+		for (const auto benchmark : benchmarks)
+			printf("%s\n", benchmark->m_name);
+
+		return FINI_OK;
+	}
+
+#ifdef DEV_BUILD
+	printf("Warning: debug build, the results are not representative\n\n");
+#endif
+
+	printf("%-32s %10s %14s %12s %12s %12s\n",
+		"Benchmark", "Items", "Median ns", "ns/item", "Min ns", "Max ns");
+
+	BenchmarkResults results(pool);
+	bool failed = false;
+
+	for (const auto benchmark : benchmarks)
+	{
+		BenchmarkState state(pool, warmup, repetitions, threads);
+
+		try
+		{
+			benchmark->m_routine(state);
+		}
+		catch (const Exception& ex)
+		{
+			StaticStatusVector status;
+			ex.stuffException(status);
+
+			fprintf(stderr, "%s: failed with error %" SQUADFORMAT"\n",
+				benchmark->m_name, (SINT64) status.begin()[1]);
+			failed = true;
+			continue;
+		}
+
+		Array<double> times(state.getTimes());
+		if (times.isEmpty())
+			continue;
+
+		std::sort(times.begin(), times.end());
+
+		BenchmarkResult& result = results.add();
+		result.name = benchmark->m_name;
+		result.items = state.getItems();
+		result.repetitions = times.getCount();
+		result.minTime = times.front();
+		result.maxTime = times.back();
+		result.medianTime = (times.getCount() % 2) ? times[times.getCount() / 2] :
+			(times[times.getCount() / 2 - 1] + times[times.getCount() / 2]) / 2;
+
+		for (const auto time : times)
+			result.meanTime += time;
+
+		result.meanTime /= times.getCount();
+
+		printf("%-32s %10" UQUADFORMAT" %14.0f %12.3f %12.0f %12.0f\n",
+			result.name.c_str(), result.items, result.medianTime, result.getItemTime(),
+			result.minTime, result.maxTime);
+		fflush(stdout);
+	}
+
+	try
+	{
+		if (jsonFile.hasData())
+			writeJson(jsonFile.c_str(), results, warmup, repetitions, threads);
+
+		if (baselineFile.hasData())
+		{
+			printf("\n");
+
+			if (compareBaseline(baselineFile.c_str(), results, threshold))
+				failed = true;
+			else
+				printf("No regressions above %.1f%%\n", threshold);
+		}
+	}
+	catch (const Exception&)
+	{
+		fprintf(stderr, "Cannot access JSON file\n");
+		return FINI_ERROR;
+	}
+
+	return failed ? FINI_ERROR : FINI_OK;
+}
+
+
+BenchmarkState::BenchmarkState(MemoryPool& pool, unsigned warmup, unsigned repetitions, unsigned threads)
+	: m_warmup(warmup),
+	  m_repetitions(repetitions),
+	  m_threads(threads),
+	  m_items(1),
+	  m_pass(0),
+	  m_start(0),
+	  m_pauseStart(0),
+	  m_paused(0),
+	  m_times(pool)
+{
+}
+
+bool BenchmarkState::run()
+{
+	const SINT64 now = fb_utils::query_performance_counter();
+
+	if (m_pass > m_warmup)
+	{
+		const double ticks = (double) (now - m_start - m_paused);
+		m_times.add(ticks * 1000000000.0 / fb_utils::query_performance_frequency());
+	}
+
+	if (m_pass++ == m_warmup + m_repetitions)
+		return false;
+
+	m_paused = 0;
+	m_start = fb_utils::query_performance_counter();
+	return true;
+}
+
+void BenchmarkState::pause()
+{
+	m_pauseStart = fb_utils::query_performance_counter();
+}
+
+void BenchmarkState::resume()
+{
+	m_paused += fb_utils::query_performance_counter() - m_pauseStart;
+}
+
+} // namespace Jrd
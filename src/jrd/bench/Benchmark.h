@@ -0,0 +1,151 @@
+/*
+ *	PROGRAM:	Engine Benchmarks
+ *	MODULE:		Benchmark.h
+ *	DESCRIPTION:	Microbenchmark harness
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#ifndef JRD_BENCH_BENCHMARK_H
+#define JRD_BENCH_BENCHMARK_H
+
+#include "../../common/classes/array.h"
+#include "../../common/classes/fb_string.h"
+
+namespace Jrd {
+
+// Benchmark routine prepares its data and then runs passes in the loop:
+//
+//	while (state.run())
+//	{
+//		... measured code processing state.getItems() items ...
+//	}
+//
+// The first passes warm up caches and are not counted, the others are timed
+// one by one. Per pass preparation may be excluded from the timing with
+// pause() / resume().
+
+class BenchmarkState
+{
+public:
+	BenchmarkState(Firebird::MemoryPool& pool, unsigned warmup, unsigned repetitions, unsigned threads);
+
+	// Finish the current pass, returns false when all passes are done
+	bool run();
+
+	void pause();
+	void resume();
+
+	// Number of items processed by a single pass, used to report time per item
+	void setItems(FB_UINT64 items)
+	{
+		m_items = items;
+	}
+
+	FB_UINT64 getItems() const
+	{
+		return m_items;
+	}
+
+	// Number of threads for the concurrent benchmarks
+	unsigned getThreads() const
+	{
+		return m_threads;
+	}
+
+	// Nanoseconds spent by every counted pass
+	const Firebird::Array<double>& getTimes() const
+	{
+		return m_times;
+	}
+
+	// Prevent the compiler from optimizing out the result of measured code
+	template <typename T>
+	static void keep(T value)
+	{
+		[[maybe_unused]] static volatile T sink;
+		sink = value;
+	}
+
+private:
+	const unsigned m_warmup;
+	const unsigned m_repetitions;
+	const unsigned m_threads;
+	FB_UINT64 m_items;
+	unsigned m_pass;
+	SINT64 m_start;
+	SINT64 m_pauseStart;
+	SINT64 m_paused;
+	Firebird::Array<double> m_times;
+};
+
+
+// Reproducible pseudo-random data (xorshift64)
+
+class BenchmarkRandom
+{
+public:
+	explicit BenchmarkRandom(FB_UINT64 seed = 1)
+		: m_state(seed ? seed : 1)
+	{}
+
+	FB_UINT64 next()
+	{
+		m_state ^= m_state << 13;
+		m_state ^= m_state >> 7;
+		m_state ^= m_state << 17;
+		return m_state;
+	}
+
+	ULONG next(ULONG limit)
+	{
+		return (ULONG) (next() % limit);
+	}
+
+private:
+	FB_UINT64 m_state;
+};
+
+
+typedef void BenchmarkRoutine(BenchmarkState& state);
+
+// Static instances of this class register benchmarks
+
+class Benchmark
+{
+public:
+	Benchmark(const char* name, BenchmarkRoutine* routine);
+
+	// Parse command line, run benchmarks and report the results.
+	// Returns process exit code.
+	static int runAll(int argc, char** argv);
+
+private:
+	const char* const m_name;
+	BenchmarkRoutine* const m_routine;
+	Benchmark* m_next;
+
+	static Benchmark* list;
+};
+
+} // namespace Jrd
+
+#define FB_BENCHMARK(group, name)	\
+	static void group##_##name(Jrd::BenchmarkState& state);	\
+	static Jrd::Benchmark group##_##name##_registrar(#group "." #name, group##_##name);	\
+	static void group##_##name(Jrd::BenchmarkState& state)
+
+#endif // JRD_BENCH_BENCHMARK_H
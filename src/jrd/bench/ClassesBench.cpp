@@ -0,0 +1,301 @@
+#include "firebird.h"
+#include "../jrd/bench/Benchmark.h"
+#include "../common/classes/tree.h"
+#include "../common/classes/sparse_bitmap.h"
+#include <thread>
+#include <vector>
+
+using namespace Firebird;
+using namespace Jrd;
+
+namespace
+{
+	typedef SparseBitmap<FB_UINT64> Bitmap;
+	typedef BePlusTree<FB_UINT64, FB_UINT64, MemoryPool> Tree;
+
+	const ULONG BITMAP_DENSE_BITS = 1000000;
+	const ULONG BITMAP_SPARSE_BITS = 100000;
+	const ULONG BITMAP_SPARSE_RANGE = 10000000;
+
+	const ULONG TREE_ITEMS = 100000;
+
+	const ULONG POOL_BLOCKS = 1000;
+	const ULONG POOL_ROUNDS = 100;
+
+	// Record numbers got by the index scan: clustered ranges spread over the table
+	void fillBitmap(Bitmap& bitmap, BenchmarkRandom& random, ULONG count, ULONG range)
+	{
+		for (ULONG i = 0; i < count; )
+		{
+			const FB_UINT64 start = random.next(range);
+			const ULONG length = 1 + random.next(16);
+
+			for (ULONG j = 0; j < length && i < count; j++, i++)
+				bitmap.set(start + j);
+		}
+	}
+
+	// Allocate the blocks of mixed sizes and release them in random order
+	void poolRounds(MemoryPool& pool, FB_UINT64 seed)
+	{
+		BenchmarkRandom random(seed);
+		void* blocks[POOL_BLOCKS];
+
+		for (ULONG round = 0; round < POOL_ROUNDS; round++)
+		{
+			for (ULONG i = 0; i < POOL_BLOCKS; i++)
+			{
+				const ULONG size = random.next(64) ? 16 + random.next(1024) : 8192 + random.next(65536);
+				blocks[i] = pool.allocate(size ALLOC_ARGS);
+			}
+
+			for (ULONG i = POOL_BLOCKS; i > 0; i--)
+			{
+				const ULONG n = random.next(i);
+				pool.deallocate(blocks[n]);
+				blocks[n] = blocks[i - 1];
+			}
+		}
+	}
+}
+
+
+FB_BENCHMARK(Bitmap, SetSequential)
+{
+	auto& pool = *getDefaultMemoryPool();
+	state.setItems(BITMAP_DENSE_BITS);
+
+	while (state.run())
+	{
+		Bitmap bitmap(pool);
+
+		for (ULONG i = 0; i < BITMAP_DENSE_BITS; i++)
+			bitmap.set(i);
+	}
+}
+
+FB_BENCHMARK(Bitmap, SetRandom)
+{
+	auto& pool = *getDefaultMemoryPool();
+	state.setItems(BITMAP_SPARSE_BITS);
+
+	while (state.run())
+	{
+		Bitmap bitmap(pool);
+		BenchmarkRandom random;
+
+		for (ULONG i = 0; i < BITMAP_SPARSE_BITS; i++)
+			bitmap.set(random.next(BITMAP_SPARSE_RANGE));
+	}
+}
+
+FB_BENCHMARK(Bitmap, Test)
+{
+	auto& pool = *getDefaultMemoryPool();
+	BenchmarkRandom random;
+
+	Bitmap bitmap(pool);
+	fillBitmap(bitmap, random, BITMAP_SPARSE_BITS, BITMAP_SPARSE_RANGE);
+
+	state.setItems(BITMAP_SPARSE_BITS);
+
+	while (state.run())
+	{
+		for (ULONG i = 0; i < BITMAP_SPARSE_BITS; i++)
+			BenchmarkState::keep(bitmap.test(random.next(BITMAP_SPARSE_RANGE)));
+	}
+}
+
+FB_BENCHMARK(Bitmap, And)
+{
+	auto& pool = *getDefaultMemoryPool();
+	state.setItems(BITMAP_SPARSE_BITS * 2);
+
+	// Operation changes one of the arguments, so they are rebuilt before every pass
+	Bitmap* bitmap1 = NULL;
+	Bitmap* bitmap2 = NULL;
+
+	while (state.run())
+	{
+		state.pause();
+
+		delete bitmap1;
+		delete bitmap2;
+
+		BenchmarkRandom random;
+		bitmap1 = FB_NEW_POOL(pool) Bitmap(pool);
+		bitmap2 = FB_NEW_POOL(pool) Bitmap(pool);
+		fillBitmap(*bitmap1, random, BITMAP_SPARSE_BITS, BITMAP_SPARSE_RANGE / 10);
+		fillBitmap(*bitmap2, random, BITMAP_SPARSE_BITS, BITMAP_SPARSE_RANGE / 10);
+
+		state.resume();
+
+		BenchmarkState::keep(Bitmap::bit_and(&bitmap1, &bitmap2));
+	}
+
+	delete bitmap1;
+	delete bitmap2;
+}
+
+FB_BENCHMARK(Bitmap, Or)
+{
+	auto& pool = *getDefaultMemoryPool();
+	state.setItems(BITMAP_SPARSE_BITS * 2);
+
+	Bitmap* bitmap1 = NULL;
+	Bitmap* bitmap2 = NULL;
+
+	while (state.run())
+	{
+		state.pause();
+
+		delete bitmap1;
+		delete bitmap2;
+
+		BenchmarkRandom random;
+		bitmap1 = FB_NEW_POOL(pool) Bitmap(pool);
+		bitmap2 = FB_NEW_POOL(pool) Bitmap(pool);
+		fillBitmap(*bitmap1, random, BITMAP_SPARSE_BITS, BITMAP_SPARSE_RANGE);
+		fillBitmap(*bitmap2, random, BITMAP_SPARSE_BITS, BITMAP_SPARSE_RANGE);
+
+		state.resume();
+
+		BenchmarkState::keep(Bitmap::bit_or(&bitmap1, &bitmap2));
+	}
+
+	delete bitmap1;
+	delete bitmap2;
+}
+
+FB_BENCHMARK(Bitmap, Iterate)
+{
+	auto& pool = *getDefaultMemoryPool();
+	BenchmarkRandom random;
+
+	Bitmap bitmap(pool);
+	fillBitmap(bitmap, random, BITMAP_DENSE_BITS, BITMAP_DENSE_BITS * 4);
+
+	while (state.run())
+	{
+		FB_UINT64 count = 0;
+
+		if (bitmap.getFirst())
+		{
+			do
+			{
+				count++;
+			} while (bitmap.getNext());
+		}
+
+		state.setItems(count);
+	}
+}
+
+
+FB_BENCHMARK(Tree, InsertSequential)
+{
+	auto& pool = *getDefaultMemoryPool();
+	state.setItems(TREE_ITEMS);
+
+	while (state.run())
+	{
+		Tree tree(pool);
+
+		for (ULONG i = 0; i < TREE_ITEMS; i++)
+			tree.add(i);
+	}
+}
+
+FB_BENCHMARK(Tree, InsertRandom)
+{
+	auto& pool = *getDefaultMemoryPool();
+	state.setItems(TREE_ITEMS);
+
+	while (state.run())
+	{
+		Tree tree(pool);
+		BenchmarkRandom random;
+
+		for (ULONG i = 0; i < TREE_ITEMS; i++)
+			tree.add(random.next());
+	}
+}
+
+FB_BENCHMARK(Tree, Lookup)
+{
+	auto& pool = *getDefaultMemoryPool();
+	BenchmarkRandom random;
+
+	Tree tree(pool);
+	for (ULONG i = 0; i < TREE_ITEMS; i++)
+		tree.add(random.next(TREE_ITEMS * 2));
+
+	state.setItems(TREE_ITEMS);
+
+	while (state.run())
+	{
+		for (ULONG i = 0; i < TREE_ITEMS; i++)
+			BenchmarkState::keep(tree.locate(random.next(TREE_ITEMS * 2)));
+	}
+}
+
+
+FB_BENCHMARK(MemPool, AllocFree)
+{
+	MemoryPool* const pool = MemoryPool::createPool();
+	state.setItems(POOL_BLOCKS * POOL_ROUNDS);
+
+	while (state.run())
+		poolRounds(*pool, 1);
+
+	MemoryPool::deletePool(pool);
+}
+
+// Threads allocate from the private pools having the common parent,
+// like attachments of the same database do
+
+FB_BENCHMARK(MemPool, ConcurrentPrivate)
+{
+	MemoryPool* const parent = MemoryPool::createPool();
+	state.setItems((FB_UINT64) POOL_BLOCKS * POOL_ROUNDS * state.getThreads());
+
+	while (state.run())
+	{
+		std::vector<std::thread> threads;
+
+		for (unsigned t = 0; t < state.getThreads(); t++)
+		{
+			threads.emplace_back([parent, t]() {
+				MemoryPool* const pool = MemoryPool::createPool(parent);
+				poolRounds(*pool, t + 1);
+				MemoryPool::deletePool(pool);
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	MemoryPool::deletePool(parent);
+}
+
+// Threads allocate from the same pool
+
+FB_BENCHMARK(MemPool, ConcurrentShared)
+{
+	MemoryPool* const pool = MemoryPool::createPool();
+	state.setItems((FB_UINT64) POOL_BLOCKS * POOL_ROUNDS * state.getThreads());
+
+	while (state.run())
+	{
+		std::vector<std::thread> threads;
+
+		for (unsigned t = 0; t < state.getThreads(); t++)
+			threads.emplace_back([pool, t]() { poolRounds(*pool, t + 1); });
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	MemoryPool::deletePool(pool);
+}
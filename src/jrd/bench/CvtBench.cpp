@@ -0,0 +1,170 @@
+#include "firebird.h"
+#include "../jrd/bench/Benchmark.h"
+#include "../common/cvt.h"
+#include "../common/dsc.h"
+#include "../common/StatusArg.h"
+#include "../common/classes/objects_array.h"
+#include "../jrd/intl.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+// MOV_* routines of the engine are the thin wrappers taking the decimal
+// status from the attachment, benchmarks call the underlying CVT_* ones.
+
+namespace
+{
+	const ULONG VALUES = 10000;
+
+	void errFunc(const Arg::StatusVector& v)
+	{
+		v.raise();
+	}
+
+	void makeStrings(ObjectsArray<string>& strings, const char* format, ULONG range)
+	{
+		BenchmarkRandom random;
+
+		for (ULONG i = 0; i < VALUES; i++)
+			strings.add().printf(format, random.next(range), random.next(100));
+	}
+
+	// Move every string to the same target
+	void moveStrings(BenchmarkState& state, const ObjectsArray<string>& strings, dsc& to)
+	{
+		state.setItems(VALUES);
+
+		while (state.run())
+		{
+			for (const auto& str : strings)
+			{
+				dsc from;
+				from.makeText(str.length(), ttype_ascii, (UCHAR*) str.c_str());
+				CVT_move(&from, &to, DecimalStatus::DEFAULT, errFunc);
+			}
+		}
+	}
+}
+
+
+FB_BENCHMARK(Cvt, StringToInteger)
+{
+	ObjectsArray<string> strings;
+	makeStrings(strings, "%u", 1000000000);
+
+	SLONG value;
+	dsc to;
+	to.makeLong(0, &value);
+
+	moveStrings(state, strings, to);
+}
+
+FB_BENCHMARK(Cvt, StringToNumeric)
+{
+	ObjectsArray<string> strings;
+	makeStrings(strings, "%u.%02u", 10000000);
+
+	SINT64 value;
+	dsc to;
+	to.makeInt64(-2, &value);
+
+	moveStrings(state, strings, to);
+}
+
+FB_BENCHMARK(Cvt, StringToDouble)
+{
+	ObjectsArray<string> strings;
+	makeStrings(strings, "%u.%uE-3", 10000000);
+
+	double value;
+	dsc to;
+	to.makeDouble(&value);
+
+	moveStrings(state, strings, to);
+}
+
+FB_BENCHMARK(Cvt, StringToTimestamp)
+{
+	ObjectsArray<string> strings;
+	BenchmarkRandom random;
+
+	for (ULONG i = 0; i < VALUES; i++)
+	{
+		strings.add().printf("%04u-%02u-%02u %02u:%02u:%02u.%04u",
+			1990 + random.next(40), 1 + random.next(12), 1 + random.next(28),
+			random.next(24), random.next(60), random.next(60), random.next(10000));
+	}
+
+	GDS_TIMESTAMP value;
+	dsc to;
+	to.makeTimestamp(&value);
+
+	moveStrings(state, strings, to);
+}
+
+FB_BENCHMARK(Cvt, NumericToString)
+{
+	Array<SINT64> values;
+	BenchmarkRandom random;
+
+	for (ULONG i = 0; i < VALUES; i++)
+		values.add((SINT64) (random.next() % 1000000000000ULL) - 500000000000LL);
+
+	char buffer[32];
+	dsc to;
+	to.makeText(sizeof(buffer), ttype_ascii, (UCHAR*) buffer);
+
+	state.setItems(VALUES);
+
+	while (state.run())
+	{
+		for (auto& value : values)
+		{
+			dsc from;
+			from.makeInt64(-4, &value);
+			CVT_move(&from, &to, DecimalStatus::DEFAULT, errFunc);
+		}
+	}
+}
+
+FB_BENCHMARK(Cvt, NumericRescale)
+{
+	Array<SINT64> values;
+	BenchmarkRandom random;
+
+	for (ULONG i = 0; i < VALUES; i++)
+		values.add((SINT64) (random.next() % 1000000000000ULL));
+
+	state.setItems(VALUES);
+
+	while (state.run())
+	{
+		for (auto& value : values)
+		{
+			dsc from;
+			from.makeInt64(-4, &value);
+			BenchmarkState::keep(CVT_get_int64(&from, -2, DecimalStatus::DEFAULT, errFunc));
+		}
+	}
+}
+
+FB_BENCHMARK(Cvt, IntegerToDouble)
+{
+	Array<SLONG> values;
+	BenchmarkRandom random;
+
+	for (ULONG i = 0; i < VALUES; i++)
+		values.add((SLONG) random.next());
+
+	state.setItems(VALUES);
+
+	while (state.run())
+	{
+		for (auto& value : values)
+		{
+			dsc from;
+			from.makeLong(0, &value);
+			BenchmarkState::keep(CVT_get_double(&from, DecimalStatus::DEFAULT, errFunc));
+		}
+	}
+}
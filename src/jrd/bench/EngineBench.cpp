@@ -0,0 +1,7 @@
+#include "firebird.h"
+#include "../jrd/bench/Benchmark.h"
+
+int main(int argc, char** argv)
+{
+	return Jrd::Benchmark::runAll(argc, argv);
+}
@@ -0,0 +1,95 @@
+#include "firebird.h"
+#include "../jrd/bench/Benchmark.h"
+#include "../common/SimilarToRegex.h"
+#include "../common/StatusArg.h"
+#include "../common/classes/objects_array.h"
+#include "../jrd/evl_string.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+namespace
+{
+	const ULONG STRINGS = 10000;
+
+	// Order descriptions, some of them match the patterns below
+	void makeStrings(ObjectsArray<string>& strings)
+	{
+		BenchmarkRandom random;
+
+		for (ULONG i = 0; i < STRINGS; i++)
+		{
+			string& str = strings.add();
+			str.printf("%c%c%c-%u customer order of %u items shipped in %u",
+				'A' + random.next(26), 'A' + random.next(26), 'A' + random.next(26),
+				random.next(1000000), random.next(100), 2000 + random.next(30));
+		}
+	}
+
+	void likeBench(BenchmarkState& state, const char* pattern)
+	{
+		auto& pool = *getDefaultMemoryPool();
+
+		ObjectsArray<string> strings;
+		makeStrings(strings);
+
+		LikeEvaluator<UCHAR> evaluator(pool, reinterpret_cast<const UCHAR*>(pattern),
+			strlen(pattern), '\\', true, '%', '_');
+
+		state.setItems(STRINGS);
+
+		while (state.run())
+		{
+			for (const auto& str : strings)
+			{
+				evaluator.reset();
+				evaluator.processNextChunk(reinterpret_cast<const UCHAR*>(str.c_str()), str.length());
+				BenchmarkState::keep(evaluator.getResult());
+			}
+		}
+	}
+
+	void similarBench(BenchmarkState& state, const char* pattern)
+	{
+		auto& pool = *getDefaultMemoryPool();
+
+		ObjectsArray<string> strings;
+		makeStrings(strings);
+
+		SimilarToRegex regex(pool, 0, pattern, strlen(pattern), "\\", 1);
+
+		state.setItems(STRINGS);
+
+		while (state.run())
+		{
+			for (const auto& str : strings)
+				BenchmarkState::keep(regex.matches(str.c_str(), str.length()));
+		}
+	}
+}
+
+
+FB_BENCHMARK(Like, Prefix)
+{
+	likeBench(state, "AB%");
+}
+
+FB_BENCHMARK(Like, Contains)
+{
+	likeBench(state, "%order of 5%");
+}
+
+FB_BENCHMARK(Like, Complex)
+{
+	likeBench(state, "%-1_3%order%in 20_5");
+}
+
+FB_BENCHMARK(Similar, Simple)
+{
+	similarBench(state, "AB%");
+}
+
+FB_BENCHMARK(Similar, Complex)
+{
+	similarBench(state, "[A-Z]{3}-[0-9]+ customer order of (1|2|3)[0-9]? items%20(0|1)[0-9]");
+}
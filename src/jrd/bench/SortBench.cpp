@@ -0,0 +1,181 @@
+#include "firebird.h"
+#include "../jrd/bench/Benchmark.h"
+#include "../jrd/jrd.h"
+#include "../jrd/sort.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+// Sort leaves the engine with attachment being checked out while sorting the
+// buffer, that is asserted in debug build. Benchmarks run without attachment
+// and thus in release build only.
+
+#ifndef DEV_BUILD
+
+namespace
+{
+	// Records should fit the in-memory sort buffer: writing and merging of runs
+	// needs the temporary space of the attached database. Thus the benchmarks
+	// measure the put / quick sort / get cycle of a single run. Sort of the first
+	// records only is the exception, it never spills to the temporary space.
+	const ULONG SORT_BUFFER_SIZE = 128 * 1024;
+	const ULONG TOP_N_BUFFERS = 20;
+
+	typedef void FillRoutine(BenchmarkRandom& random, UCHAR* record);
+
+	void sortBench(BenchmarkState& state, const sort_key_def* keys, FB_SIZE_T keyCount,
+		ULONG recordLength, FillRoutine* fill, FB_UINT64 firstRecords = 0)
+	{
+		const ULONG recordSize = ROUNDUP(recordLength + sizeof(sort_ptr_t), FB_ALIGNMENT);
+		const ULONG capacity = SORT_BUFFER_SIZE / (recordSize + sizeof(sort_record*));
+		const ULONG count = firstRecords ? capacity * TOP_N_BUFFERS : capacity * 3 / 4;
+
+		Database* const dbb = Database::create(nullptr, false);
+
+		try
+		{
+			SortOwner owner(*dbb->dbb_permanent, dbb);
+
+			BenchmarkRandom random;
+			Array<UCHAR> records;
+			UCHAR* const data = records.getBuffer(count * recordLength);
+
+			for (ULONG i = 0; i < count; i++)
+				fill(random, data + i * recordLength);
+
+			state.setItems(count);
+
+			while (state.run())
+			{
+				Sort sort(dbb, &owner, recordLength, keyCount, keyCount, keys, NULL, NULL, firstRecords);
+
+				for (ULONG i = 0; i < count; i++)
+				{
+					ULONG* record;
+					sort.put(nullptr, &record);
+					memcpy(record, data + i * recordLength, recordLength);
+				}
+
+				sort.sort(nullptr);
+
+				ULONG* record;
+				do
+				{
+					sort.get(nullptr, &record);
+				} while (record);
+			}
+		}
+		catch (const Exception&)
+		{
+			Database::destroy(dbb);
+			throw;
+		}
+
+		Database::destroy(dbb);
+	}
+
+
+	// INTEGER key with payload
+
+	void fillLong(BenchmarkRandom& random, UCHAR* record)
+	{
+		const SLONG key = (SLONG) random.next();
+		memcpy(record, &key, sizeof(key));
+		memcpy(record + sizeof(key), &key, sizeof(key));
+	}
+
+	// BIGINT key with payload
+
+	void fillInt64(BenchmarkRandom& random, UCHAR* record)
+	{
+		const SINT64 key = (SINT64) random.next();
+		memcpy(record, &key, sizeof(key));
+		memcpy(record + sizeof(key), &key, sizeof(key));
+	}
+
+	// CHAR(32) key sharing the common prefix
+
+	const ULONG TEXT_LENGTH = 32;
+
+	void fillText(BenchmarkRandom& random, UCHAR* record)
+	{
+		static const char PREFIX[] = "CUSTOMER_";
+		memcpy(record, PREFIX, sizeof(PREFIX) - 1);
+
+		for (ULONG i = sizeof(PREFIX) - 1; i < TEXT_LENGTH; i++)
+			record[i] = (i < 20) ? 'A' + random.next(26) : ' ';
+	}
+
+	// INTEGER DESC, CHAR(16), DOUBLE PRECISION with few distinct leading values
+
+	const ULONG COMPOUND_TEXT_LENGTH = 16;
+
+	void fillCompound(BenchmarkRandom& random, UCHAR* record)
+	{
+		const SLONG group = (SLONG) random.next(16);
+		memcpy(record, &group, sizeof(group));
+
+		for (ULONG i = 0; i < COMPOUND_TEXT_LENGTH; i++)
+			record[sizeof(SLONG) + i] = 'a' + random.next(4);
+
+		const double value = (double) random.next() / 1000;
+		memcpy(record + sizeof(SLONG) + COMPOUND_TEXT_LENGTH, &value, sizeof(value));
+	}
+}
+
+
+FB_BENCHMARK(Sort, Integer)
+{
+	sort_key_def key = {};
+	key.setSkdLength(SKD_long, sizeof(SLONG));
+	key.setSkdOffset();
+
+	sortBench(state, &key, 1, 2 * sizeof(SLONG), fillLong);
+}
+
+FB_BENCHMARK(Sort, BigInt)
+{
+	sort_key_def key = {};
+	key.setSkdLength(SKD_int64, sizeof(SINT64));
+	key.setSkdOffset();
+
+	sortBench(state, &key, 1, 2 * sizeof(SINT64), fillInt64);
+}
+
+FB_BENCHMARK(Sort, Text)
+{
+	sort_key_def key = {};
+	key.setSkdLength(SKD_text, TEXT_LENGTH);
+	key.setSkdOffset();
+
+	sortBench(state, &key, 1, TEXT_LENGTH, fillText);
+}
+
+FB_BENCHMARK(Sort, Compound)
+{
+	sort_key_def keys[3] = {};
+
+	keys[0].setSkdLength(SKD_long, sizeof(SLONG));
+	keys[0].skd_flags = SKD_descending;
+	keys[0].setSkdOffset();
+
+	keys[1].setSkdLength(SKD_text, COMPOUND_TEXT_LENGTH);
+	keys[1].setSkdOffset(&keys[0]);
+
+	keys[2].setSkdLength(SKD_double, sizeof(double));
+	keys[2].setSkdOffset(&keys[1]);
+
+	sortBench(state, keys, FB_NELEM(keys),
+		sizeof(SLONG) + COMPOUND_TEXT_LENGTH + sizeof(double), fillCompound);
+}
+
+FB_BENCHMARK(Sort, TopN)
+{
+	sort_key_def key = {};
+	key.setSkdLength(SKD_int64, sizeof(SINT64));
+	key.setSkdOffset();
+
+	sortBench(state, &key, 1, 2 * sizeof(SINT64), fillInt64, 50);
+}
+
+#endif // DEV_BUILD
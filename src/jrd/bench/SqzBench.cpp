@@ -0,0 +1,173 @@
+#include "firebird.h"
+#include "../jrd/bench/Benchmark.h"
+#include "../jrd/sqz.h"
+#include "../common/classes/objects_array.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+namespace
+{
+	const ULONG RECORD_LENGTH = 400;
+	const unsigned RECORDS = 1000;
+
+	// Record images looking like the real ones: integers, CHAR fields partially
+	// filled and padded by spaces, zeroed NULL fields
+	void makeRecords(BenchmarkRandom& random, UCHAR* data)
+	{
+		for (unsigned i = 0; i < RECORDS; i++)
+		{
+			UCHAR* p = data + i * RECORD_LENGTH;
+			const UCHAR* const end = p + RECORD_LENGTH;
+
+			while (p < end)
+			{
+				const ULONG length = MIN(4 + random.next(60), (ULONG) (end - p));
+				const ULONG filled = random.next(length + 1);
+
+				switch (random.next(3))
+				{
+					case 0:
+						for (ULONG j = 0; j < length; j++)
+							p[j] = (UCHAR) random.next();
+						break;
+
+					case 1:
+						for (ULONG j = 0; j < length; j++)
+							p[j] = (j < filled) ? 'A' + random.next(26) : ' ';
+						break;
+
+					default:
+						memset(p, 0, length);
+				}
+
+				p += length;
+			}
+		}
+	}
+}
+
+
+FB_BENCHMARK(Sqz, Pack)
+{
+	auto& pool = *getDefaultMemoryPool();
+	BenchmarkRandom random;
+
+	Array<UCHAR> records;
+	makeRecords(random, records.getBuffer(RECORDS * RECORD_LENGTH));
+
+	// Packed record never exceeds the unpacked one much
+	Array<UCHAR> output;
+	UCHAR* const buffer = output.getBuffer(RECORD_LENGTH * 2);
+
+	state.setItems(RECORDS);
+
+	while (state.run())
+	{
+		for (unsigned i = 0; i < RECORDS; i++)
+		{
+			const UCHAR* const record = records.begin() + i * RECORD_LENGTH;
+			const Compressor dcc(pool, true, true, RECORD_LENGTH, record);
+			dcc.pack(record, buffer);
+		}
+	}
+}
+
+FB_BENCHMARK(Sqz, Unpack)
+{
+	auto& pool = *getDefaultMemoryPool();
+	BenchmarkRandom random;
+
+	Array<UCHAR> records;
+	makeRecords(random, records.getBuffer(RECORDS * RECORD_LENGTH));
+
+	ObjectsArray<Array<UCHAR> > packed;
+
+	for (unsigned i = 0; i < RECORDS; i++)
+	{
+		const UCHAR* const record = records.begin() + i * RECORD_LENGTH;
+		const Compressor dcc(pool, true, true, RECORD_LENGTH, record);
+		dcc.pack(record, packed.add().getBuffer(dcc.getPackedLength()));
+	}
+
+	Array<UCHAR> output;
+	UCHAR* const buffer = output.getBuffer(RECORD_LENGTH);
+
+	state.setItems(RECORDS);
+
+	while (state.run())
+	{
+		for (const auto& item : packed)
+			Compressor::unpack(item.getCount(), item.begin(), RECORD_LENGTH, buffer);
+	}
+}
+
+FB_BENCHMARK(Sqz, DifferenceMake)
+{
+	BenchmarkRandom random;
+
+	// Pairs of record versions differing in a few fields
+	Array<UCHAR> records, versions;
+	makeRecords(random, records.getBuffer(RECORDS * RECORD_LENGTH));
+	versions.assign(records);
+
+	for (unsigned i = 0; i < RECORDS; i++)
+	{
+		UCHAR* const version = versions.begin() + i * RECORD_LENGTH;
+
+		for (unsigned j = 0; j < 3; j++)
+			version[random.next(RECORD_LENGTH)] ^= 0x5A;
+	}
+
+	Difference difference;
+	state.setItems(RECORDS);
+
+	while (state.run())
+	{
+		for (unsigned i = 0; i < RECORDS; i++)
+		{
+			BenchmarkState::keep(difference.make(
+				RECORD_LENGTH, records.begin() + i * RECORD_LENGTH,
+				RECORD_LENGTH, versions.begin() + i * RECORD_LENGTH));
+		}
+	}
+}
+
+FB_BENCHMARK(Sqz, DifferenceApply)
+{
+	BenchmarkRandom random;
+
+	Array<UCHAR> records, versions;
+	makeRecords(random, records.getBuffer(RECORDS * RECORD_LENGTH));
+	versions.assign(records);
+
+	ObjectsArray<Array<UCHAR> > differences;
+	Difference difference;
+
+	for (unsigned i = 0; i < RECORDS; i++)
+	{
+		UCHAR* const version = versions.begin() + i * RECORD_LENGTH;
+
+		for (unsigned j = 0; j < 3; j++)
+			version[random.next(RECORD_LENGTH)] ^= 0x5A;
+
+		const ULONG length = difference.make(
+			RECORD_LENGTH, records.begin() + i * RECORD_LENGTH, RECORD_LENGTH, version);
+
+		differences.add().add(difference.getData(), length);
+	}
+
+	// Applying the difference again to the resulting record does not change it,
+	// so the same buffers are reused by all passes
+	state.setItems(RECORDS);
+
+	while (state.run())
+	{
+		for (unsigned i = 0; i < RECORDS; i++)
+		{
+			const auto& item = differences[i];
+			memcpy(difference.getData(), item.begin(), item.getCount());
+			difference.apply(item.getCount(), RECORD_LENGTH, records.begin() + i * RECORD_LENGTH);
+		}
+	}
+}
@@ -0,0 +1,122 @@
+#include "firebird.h"
+#include "../jrd/bench/Benchmark.h"
+#include "../common/dsc.h"
+#include "../common/xdr_proto.h"
+#include "../jrd/intl.h"
+#include <stddef.h>
+
+using namespace Firebird;
+using namespace Jrd;
+
+namespace
+{
+	const ULONG ROWS = 10000;
+	const USHORT NAME_LENGTH = 40;
+
+	// Message of the typical select list
+	struct Row
+	{
+		SLONG id;
+		SINT64 amount;
+		double rate;
+		GDS_TIMESTAMP stamp;
+		UCHAR code[10];
+		USHORT nameLength;
+		char name[NAME_LENGTH];
+	};
+
+	// Data item addresses are relative to the message buffer
+	template <typename T>
+	T* offset(size_t value)
+	{
+		return reinterpret_cast<T*>((IPTR) value);
+	}
+
+	class Message
+	{
+	public:
+		explicit Message(BenchmarkRandom& random)
+			: rows(*getDefaultMemoryPool())
+		{
+			descs[0].makeLong(0, offset<SLONG>(offsetof(Row, id)));
+			descs[1].makeInt64(-2, offset<SINT64>(offsetof(Row, amount)));
+			descs[2].makeDouble(offset<double>(offsetof(Row, rate)));
+			descs[3].makeTimestamp(offset<GDS_TIMESTAMP>(offsetof(Row, stamp)));
+			descs[4].makeText(sizeof(Row::code), ttype_ascii, offset<UCHAR>(offsetof(Row, code)));
+			descs[5].makeVarying(NAME_LENGTH, ttype_ascii, offset<UCHAR>(offsetof(Row, nameLength)));
+
+			Row* const row = rows.getBuffer(ROWS);
+			memset(row, 0, ROWS * sizeof(Row));
+
+			for (ULONG i = 0; i < ROWS; i++)
+			{
+				row[i].id = i;
+				row[i].amount = random.next(100000000);
+				row[i].rate = (double) random.next() / 1000;
+				row[i].stamp.timestamp_date = 60000 + random.next(1000);
+				row[i].stamp.timestamp_time = random.next(864000000);
+				memcpy(row[i].code, "CODE000000", sizeof(row[i].code));
+				row[i].nameLength = 10 + random.next(NAME_LENGTH - 10);
+				memset(row[i].name, 'a' + i % 26, row[i].nameLength);
+			}
+		}
+
+		void process(xdr_t* xdrs)
+		{
+			for (auto& row : rows)
+			{
+				for (const auto& desc : descs)
+				{
+					if (!xdr_datum(xdrs, &desc, reinterpret_cast<UCHAR*>(&row)))
+						fatal_exception::raise("xdr_datum failed");
+				}
+			}
+		}
+
+		dsc descs[6];
+		Array<Row> rows;
+	};
+}
+
+
+FB_BENCHMARK(Xdr, Encode)
+{
+	BenchmarkRandom random;
+	Message message(random);
+
+	Array<SCHAR> buffer;
+	const unsigned size = ROWS * sizeof(Row) * 2;
+	buffer.getBuffer(size);
+
+	state.setItems(ROWS);
+
+	while (state.run())
+	{
+		xdr_t xdrs;
+		xdrs.create(buffer.begin(), size, XDR_ENCODE);
+		message.process(&xdrs);
+	}
+}
+
+FB_BENCHMARK(Xdr, Decode)
+{
+	BenchmarkRandom random;
+	Message message(random);
+
+	Array<SCHAR> buffer;
+	const unsigned size = ROWS * sizeof(Row) * 2;
+	buffer.getBuffer(size);
+
+	xdr_t encoder;
+	encoder.create(buffer.begin(), size, XDR_ENCODE);
+	message.process(&encoder);
+
+	state.setItems(ROWS);
+
+	while (state.run())
+	{
+		xdr_t xdrs;
+		xdrs.create(buffer.begin(), size, XDR_DECODE);
+		message.process(&xdrs);
+	}
+}
@@ -32,6 +32,8 @@
 #include "../common/TimeZoneUtil.h"
 #include "../common/classes/vector.h"
 #include "../common/classes/VaryStr.h"
+#include "../common/classes/ClumpletReader.h"
+#include "../common/classes/ClumpletWriter.h"
 #include <stdio.h>
 #include "../jrd/jrd.h"
 #include "../jrd/ods.h"
@@ -185,6 +187,48 @@ namespace
 		temporary_key jumpKey;
 	};
 
+	// Format of the stored index statistics, see IndexStatistics::save()
+
+	const UCHAR STATS_VERSION = 1;
+
+	enum StatsTag : UCHAR
+	{
+		stats_selectivity = 1,
+		stats_keys,
+		stats_distinct,
+		stats_bound,
+		stats_value
+	};
+
+	void putStatsEntry(ClumpletWriter& writer, UCHAR tag, const IndexStatistics::Entry& entry)
+	{
+		UCHAR buffer[sizeof(FB_UINT64) + IndexStatistics::MAX_KEY_LENGTH];
+
+		for (unsigned i = 0; i < sizeof(FB_UINT64); i++)
+			buffer[i] = (UCHAR) (entry.count >> (i * 8));
+
+		memcpy(buffer + sizeof(FB_UINT64), entry.data, entry.length);
+		writer.insertBytes(tag, buffer, sizeof(FB_UINT64) + entry.length);
+	}
+
+	bool getStatsEntry(const ClumpletReader& reader, IndexStatistics::Entry& entry)
+	{
+		const FB_SIZE_T length = reader.getClumpLength();
+
+		if (length < sizeof(FB_UINT64) || length > sizeof(FB_UINT64) + IndexStatistics::MAX_KEY_LENGTH)
+			return false;
+
+		const UCHAR* const buffer = reader.getBytes();
+
+		entry.count = 0;
+		for (unsigned i = 0; i < sizeof(FB_UINT64); i++)
+			entry.count |= ((FB_UINT64) buffer[i]) << (i * 8);
+
+		entry.length = length - sizeof(FB_UINT64);
+		memcpy(entry.data, buffer + sizeof(FB_UINT64), entry.length);
+		return true;
+	}
+
 } // namespace
 
 static ULONG add_node(thread_db*, WIN*, index_insertion*, temporary_key*, RecordNumber*,
@@ -798,6 +842,311 @@ void IndexScanListIterator::makeKeys(thread_db* tdbb, temporary_key* lower, temp
 }
 
 
+// IndexStatistics class
+
+void IndexStatistics::clear()
+{
+	selectivity = 0;
+	keys = 0;
+	distinct = 0;
+	bounds.clear();
+	values.clear();
+}
+
+void IndexStatistics::load(const UCHAR* data, ULONG length)
+{
+	clear();
+
+	try
+	{
+		ClumpletReader reader(ClumpletReader::Tagged, data, length);
+
+		if (reader.getBufferTag() != STATS_VERSION)
+			return;
+
+		for (reader.rewind(); !reader.isEof(); reader.moveNext())
+		{
+			Entry entry;
+
+			switch (reader.getClumpTag())
+			{
+				case stats_selectivity:
+					selectivity = (float) reader.getDouble();
+					break;
+
+				case stats_keys:
+					keys = reader.getBigInt();
+					break;
+
+				case stats_distinct:
+					distinct = reader.getBigInt();
+					break;
+
+				case stats_bound:
+					if (getStatsEntry(reader, entry))
+						bounds.add(entry);
+					break;
+
+				case stats_value:
+					if (getStatsEntry(reader, entry))
+						values.add(entry);
+					break;
+			}
+		}
+	}
+	catch (const Exception&)
+	{
+		clear();
+	}
+
+	if (bounds.isEmpty() || distinct < values.getCount())
+		clear();
+}
+
+void IndexStatistics::save(UCharBuffer& buffer) const
+{
+	ClumpletWriter writer(ClumpletWriter::Tagged, MAX_USHORT, STATS_VERSION);
+
+	writer.insertDouble(stats_selectivity, selectivity);
+	writer.insertBigInt(stats_keys, keys);
+	writer.insertBigInt(stats_distinct, distinct);
+
+	for (const auto& bound : bounds)
+		putStatsEntry(writer, stats_bound, bound);
+
+	for (const auto& value : values)
+		putStatsEntry(writer, stats_value, value);
+
+	buffer.assign(writer.getBuffer(), writer.getBufferLength());
+}
+
+bool IndexStatistics::getEqualSelectivity(const temporary_key* key, double& selectivity) const
+{
+	fb_assert(hasData());
+
+	// The value outside the histogram could be stored after the statistics was collected,
+	// e.g. a generated one, so nothing is known about it
+	if (compare(bounds.front(), key) > 0 || compare(bounds.back(), key) < 0)
+		return false;
+
+	FB_UINT64 common = 0;
+
+	for (const auto& value : values)
+	{
+		if (value.length == key->key_length && !memcmp(value.data, key->key_data, value.length))
+		{
+			selectivity = (double) value.count / keys;
+			return true;
+		}
+
+		common += value.count;
+	}
+
+	// The rest of the values is assumed to be distributed uniformly
+	const FB_UINT64 others = distinct - values.getCount();
+
+	if (others && keys > common)
+		selectivity = (double) (keys - common) / others / keys;
+	else
+		selectivity = 1.0 / keys;
+
+	return true;
+}
+
+bool IndexStatistics::getRangeSelectivity(const temporary_key* lower, const temporary_key* upper,
+	double& selectivity) const
+{
+	fb_assert(hasData());
+
+	// The range outside the histogram could contain only the keys
+	// stored after the statistics was collected
+	if ((lower && compare(bounds.back(), lower) < 0) || (upper && compare(bounds.front(), upper) > 0))
+		return false;
+
+	const double start = lower ? getPosition(lower) : 0;
+	double end = keys;
+	double equal;
+
+	// Keys equal to the upper bound belong to the range too
+	if (upper && getEqualSelectivity(upper, equal))
+		end = getPosition(upper) + equal * keys;
+
+	selectivity = MIN(MAX(end - start, 1.0) / keys, 1.0);
+	return true;
+}
+
+int IndexStatistics::compare(const Entry& entry, const temporary_key* key)
+{
+	const USHORT length = MIN(entry.length, key->key_length);
+
+	if (const int result = memcmp(entry.data, key->key_data, length))
+		return result;
+
+	// The truncated entry matches all keys it's a prefix of
+	if (entry.length == MAX_KEY_LENGTH)
+		return 0;
+
+	return (int) entry.length - (int) key->key_length;
+}
+
+double IndexStatistics::getPosition(const temporary_key* key) const
+{
+	// Return the estimated number of keys preceding the given one
+
+	if (compare(bounds.front(), key) >= 0)
+		return 0;
+
+	if (compare(bounds.back(), key) < 0)
+		return (double) keys;
+
+	FB_SIZE_T low = 1, high = bounds.getCount() - 1;
+
+	while (low < high)
+	{
+		const FB_SIZE_T middle = (low + high) / 2;
+
+		if (compare(bounds[middle], key) < 0)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	const Entry& upperBound = bounds[low];
+
+	if (!compare(upperBound, key))
+		return (double) upperBound.count;
+
+	// Assume the keys to be spread evenly inside the bucket
+	return (bounds[low - 1].count + upperBound.count) / 2.0;
+}
+
+
+// DistributionCollector class
+
+DistributionCollector::DistributionCollector(MemoryPool& pool, USHORT segments, bool descending)
+	: m_samples(pool), m_values(pool), m_segments(segments),
+	  m_marker(descending ? 255 - segments : segments)
+{
+	m_run.key_length = 0;
+}
+
+void DistributionCollector::add(const temporary_key& key)
+{
+	const USHORT length = getLeadingLength(key);
+
+	if (!m_keys || length != m_run.key_length || memcmp(key.key_data, m_run.key_data, length))
+	{
+		flushRun();
+		m_run.key_length = length;
+		memcpy(m_run.key_data, key.key_data, length);
+		m_distinct++;
+	}
+
+	m_runCount++;
+
+	if (m_keys % m_stride == 0)
+	{
+		if (m_samples.getCount() == MAX_SAMPLES)
+		{
+			for (unsigned i = 1; i < MAX_SAMPLES / 2; i++)
+				m_samples[i] = m_samples[i * 2];
+
+			m_samples.shrink(MAX_SAMPLES / 2);
+			m_stride *= 2;
+		}
+
+		if (m_keys % m_stride == 0)
+			addEntry(m_samples, m_keys);
+	}
+
+	m_keys++;
+}
+
+void DistributionCollector::finish(IndexStatistics& statistics)
+{
+	flushRun();
+
+	statistics.clear();
+	statistics.keys = m_keys;
+	statistics.distinct = m_distinct;
+
+	if (!m_keys)
+		return;
+
+	const FB_UINT64 last = m_keys - 1;
+	const unsigned buckets = IndexStatistics::HISTOGRAM_BUCKETS;
+	FB_SIZE_T prior = MAX_ULONG;
+
+	for (unsigned i = 0; i < buckets; i++)
+	{
+		const FB_UINT64 target = (FB_UINT64) ((double) last * i / buckets);
+		const FB_SIZE_T pos = MIN((target + m_stride / 2) / m_stride, m_samples.getCount() - 1);
+
+		if (pos != prior && m_samples[pos].count != last)
+			statistics.bounds.add(m_samples[pos]);
+
+		prior = pos;
+	}
+
+	// The highest key is known exactly
+	addEntry(statistics.bounds, last);
+
+	// Keep the values that are more common than the average one
+	for (const auto& value : m_values)
+	{
+		if (value.count * m_distinct > m_keys)
+			statistics.values.add(value);
+	}
+}
+
+USHORT DistributionCollector::getLeadingLength(const temporary_key& key) const
+{
+	if (m_segments == 1)
+		return key.key_length;
+
+	// Every group of the compound key starts with the segment number
+	USHORT length = 0;
+	while (length < key.key_length && key.key_data[length] == m_marker)
+		length += STUFF_COUNT + 1;
+
+	return MIN(length, key.key_length);
+}
+
+void DistributionCollector::addEntry(Array<IndexStatistics::Entry>& entries, FB_UINT64 count)
+{
+	IndexStatistics::Entry& entry = entries.add();
+	entry.count = count;
+	entry.length = MIN(m_run.key_length, IndexStatistics::MAX_KEY_LENGTH);
+	memcpy(entry.data, m_run.key_data, entry.length);
+}
+
+void DistributionCollector::flushRun()
+{
+	if (m_runCount > 1 && m_run.key_length <= IndexStatistics::MAX_KEY_LENGTH)
+	{
+		if (m_values.getCount() < IndexStatistics::MCV_COUNT)
+			addEntry(m_values, m_runCount);
+		else
+		{
+			auto least = m_values.begin();
+			for (auto iter = m_values.begin() + 1; iter != m_values.end(); ++iter)
+			{
+				if (iter->count < least->count)
+					least = iter;
+			}
+
+			if (m_runCount > least->count)
+			{
+				m_values.remove(least);
+				addEntry(m_values, m_runCount);
+			}
+		}
+	}
+
+	m_runCount = 0;
+}
+
+
 void BTR_all(thread_db* tdbb, jrd_rel* relation, IndexDescList& idxList, RelationPages* relPages)
 {
 /**************************************
@@ -2009,6 +2358,67 @@ idx_e BTR_make_key(thread_db* tdbb,
 }
 
 
+bool BTR_make_leading_key(thread_db* tdbb, const index_desc* idx, const dsc* desc, SSHORT scale,
+						  temporary_key* key)
+{
+/**************************************
+ *
+ *	B T R _ m a k e _ l e a d i n g _ k e y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Construct the key for a value of the leading index segment,
+ *	the same way BTR_make_key does it for an equality search.
+ *	The value is given by a descriptor, so no request is needed.
+ *
+ **************************************/
+	const bool descending = (idx->idx_flags & idx_descending);
+	const USHORT keyType = (idx->idx_flags & idx_unique) ? INTL_KEY_UNIQUE : INTL_KEY_SORT;
+	const USHORT itype = idx->idx_rpt[0].idx_itype;
+
+	key->key_flags = 0;
+	key->key_nulls = desc ? 0 : 1;
+
+	if (idx->idx_count == 1)
+		compress(tdbb, desc, scale, key, itype, descending, keyType, nullptr);
+	else
+	{
+		temporary_key temp;
+		temp.key_flags = 0;
+		temp.key_length = 0;
+
+		compress(tdbb, desc, scale, &temp, itype, descending, keyType, nullptr);
+
+		if (static_cast<ULONG>(temp.key_length) / STUFF_COUNT * (STUFF_COUNT + 1) + STUFF_COUNT + 1 > MAX_KEY)
+			return false;
+
+		// Every STUFF_COUNT bytes are prefixed by the segment number
+		// and the last group is padded, see BTR_make_key
+
+		UCHAR* p = key->key_data;
+
+		for (USHORT i = 0; i < temp.key_length; i++)
+		{
+			if (i % STUFF_COUNT == 0)
+				*p++ = (UCHAR) idx->idx_count;
+
+			*p++ = temp.key_data[i];
+		}
+
+		while ((p - key->key_data) % (STUFF_COUNT + 1))
+			*p++ = 0;
+
+		key->key_length = p - key->key_data;
+	}
+
+	if (descending)
+		BTR_complement_key(key);
+
+	return true;
+}
+
+
 void BTR_make_null_key(thread_db* tdbb, const index_desc* idx, temporary_key* key)
 {
 /**************************************
@@ -2363,7 +2773,8 @@ void BTR_reserve_slot(thread_db* tdbb, IndexCreation& creation)
 }
 
 
-void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity)
+void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity,
+					 IndexStatistics* statistics)
 {
 /**************************************
  *
@@ -2377,6 +2788,8 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
  *	without visiting data pages. Thus the
  *	effects of uncommitted transactions
  *	will be included in the calculation.
+ *	If requested, collect the distribution
+ *	of the leading segment keys as well.
  *
  **************************************/
 
@@ -2426,6 +2839,13 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
 	duplicatesList.grow(segments);
 	memset(duplicatesList.begin(), 0, segments * sizeof(FB_UINT64));
 
+	AutoPtr<DistributionCollector> collector;
+	if (statistics)
+	{
+		collector = FB_NEW_POOL(*tdbb->getDefaultPool())
+			DistributionCollector(*tdbb->getDefaultPool(), segments, descending);
+	}
+
 	//const Database* dbb = tdbb->getDatabase();
 
 	// go through all the leaf nodes and count them;
@@ -2536,6 +2956,10 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
 			// keep the key value current for comparison with the next key
 			key.key_length = l;
 			memcpy(key.key_data + node.prefix, node.data, node.length);
+
+			if (collector)
+				collector->add(key);
+
 			pointer = node.readNode(pointer, true);
 		}
 
@@ -2558,6 +2982,12 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
 	else
 		selectivity[0] = (float) (nodes ? 1.0 / (float) (nodes - duplicates) : 0.0);
 
+	if (collector)
+	{
+		collector->finish(*statistics);
+		statistics->selectivity = selectivity.back();
+	}
+
 	// Store the selectivity on the root page
 	window.win_page = relPages->rel_index_root;
 	window.win_flags = 0;
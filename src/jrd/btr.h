@@ -244,6 +244,96 @@ const int irb_force_upper	= irb_exclude_upper;
 
 typedef Firebird::HalfStaticArray<float, 4> SelectivityList;
 
+// Distribution of the leading segment keys of an index, collected by
+// BTR_selectivity: equi-depth histogram bounds and most common values.
+// Keys are kept in the index key format (bounds are truncated to
+// MAX_KEY_LENGTH bytes), so they are compared with the search keys bytewise.
+
+class IndexStatistics : public Firebird::PermanentStorage
+{
+public:
+	static const unsigned HISTOGRAM_BUCKETS = 32;
+	static const unsigned MCV_COUNT = 16;
+	static const USHORT MAX_KEY_LENGTH = 64;
+
+	struct Entry
+	{
+		FB_UINT64 count;	// ordinal position for bounds, number of occurrences for values
+		USHORT length;
+		UCHAR data[MAX_KEY_LENGTH];
+	};
+
+	explicit IndexStatistics(MemoryPool& p)
+		: PermanentStorage(p), bounds(p), values(p)
+	{}
+
+	bool hasData() const
+	{
+		return keys != 0;
+	}
+
+	void clear();
+	void load(const UCHAR* data, ULONG length);
+	void save(Firebird::UCharBuffer& buffer) const;
+
+	// Return false if the keys lie outside the histogram and the default selectivity should be used
+	bool getEqualSelectivity(const temporary_key* key, double& selectivity) const;
+	bool getRangeSelectivity(const temporary_key* lower, const temporary_key* upper,
+		double& selectivity) const;
+
+	float selectivity = 0;			// index selectivity at the time of collection
+	FB_UINT64 keys = 0;				// number of keys
+	FB_UINT64 distinct = 0;			// number of distinct leading segment values
+	Firebird::Array<Entry> bounds;	// histogram bounds, including the lowest and highest keys
+	Firebird::Array<Entry> values;	// most common values
+
+private:
+	static int compare(const Entry& entry, const temporary_key* key);
+	double getPosition(const temporary_key* key) const;
+};
+
+// Collects the distribution of the leading segment keys while the index
+// keys are walked in their order. Every stride-th key is sampled and
+// the samples are thinned out when there are too many of them, so the
+// histogram bounds are picked without knowing the number of keys in advance.
+
+class DistributionCollector
+{
+public:
+	static const unsigned MAX_SAMPLES = IndexStatistics::HISTOGRAM_BUCKETS * 4;
+
+	DistributionCollector(MemoryPool& pool, USHORT segments, bool descending);
+
+	void add(const temporary_key& key);
+	void finish(IndexStatistics& statistics);
+
+	USHORT getLeadingLength(const temporary_key& key) const;
+
+	FB_SIZE_T getSampleCount() const
+	{
+		return m_samples.getCount();
+	}
+
+	FB_UINT64 getStride() const
+	{
+		return m_stride;
+	}
+
+private:
+	void addEntry(Firebird::Array<IndexStatistics::Entry>& entries, FB_UINT64 count);
+	void flushRun();
+
+	Firebird::Array<IndexStatistics::Entry> m_samples;
+	Firebird::Array<IndexStatistics::Entry> m_values;
+	const USHORT m_segments;
+	const UCHAR m_marker;
+	temporary_key m_run;
+	FB_UINT64 m_runCount = 0;
+	FB_UINT64 m_keys = 0;
+	FB_UINT64 m_distinct = 0;
+	FB_UINT64 m_stride = 1;
+};
+
 class BtrPageGCLock : public Lock
 {
 	// This class assumes that the static part of the lock key (Lock::lck_key)
@@ -922,6 +922,7 @@ void CCH_fetch_page(thread_db* tdbb, WIN* window, const bool read_shadow)
 	bdb->bdb_incarnation = ++bcb->bcb_page_incarnation;
 
 	tdbb->bumpStats(RuntimeStatistics::PAGE_READS);
+	RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_PAGE_READ);
 
 	PageSpace* pageSpace = dbb->dbb_page_manager.findPageSpace(bdb->bdb_page.getPageSpaceID());
 	fb_assert(pageSpace);
@@ -4914,6 +4915,7 @@ static bool write_page(thread_db* tdbb, BufferDesc* bdb, FbStatusVector* const s
 	if (true)
 	{
 		tdbb->bumpStats(RuntimeStatistics::PAGE_WRITES);
+		RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_PAGE_WRITE);
 
 		// write out page to main database file, and to any
 		// shadows, making a special case of the header page
@@ -5179,10 +5181,21 @@ void BufferControl::destroy(BufferControl* bcb)
 
 bool BufferDesc::addRef(thread_db* tdbb, SyncType syncType, int wait)
 {
-	if (wait == 1)
-		bdb_syncPage.lock(NULL, syncType, FB_FUNCTION);
-	else if (!bdb_syncPage.lock(NULL, syncType, FB_FUNCTION, -wait * 1000))
-		return false;
+	if (!wait)
+	{
+		if (!bdb_syncPage.lock(NULL, syncType, FB_FUNCTION, 0))
+			return false;
+	}
+	else if (!bdb_syncPage.lockConditional(syncType, FB_FUNCTION))
+	{
+		// Only contended latches are accounted as waits
+		RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_PAGE_LATCH);
+
+		if (wait == 1)
+			bdb_syncPage.lock(NULL, syncType, FB_FUNCTION);
+		else if (!bdb_syncPage.lock(NULL, syncType, FB_FUNCTION, -wait * 1000))
+			return false;
+	}
 
 	++bdb_use_count;
 
@@ -286,6 +286,39 @@ enum stat_group_t {
 	stat_cmp_statement = 5
 };
 
+// wait event types, see RuntimeStatistics::StatType
+
+enum wait_type_t {
+	wait_page_read = 0,
+	wait_page_write = 1,
+	wait_page_latch = 2,
+	wait_lock_database = 3,
+	wait_lock_metadata = 4,
+	wait_lock_buffer = 5,
+	wait_lock_transaction = 6,
+	wait_record_conflict = 7,
+	wait_garbage_collect = 8,
+	wait_backout = 9,
+	wait_sort_spill = 10
+};
+
+// kinds of files in MON$FILE_IO_STATS
+
+enum io_file_type_t {
+	io_file_database = 0,
+	io_file_shadow = 1,
+	io_file_delta = 2,
+	io_file_temporary = 3
+};
+
+// I/O operations, see Firebird::IoLatencyStats::Operation
+
+enum io_operation_t {
+	io_operation_read = 0,
+	io_operation_write = 1,
+	io_operation_sync = 2
+};
+
 enum InfoType
 {
 	INFO_TYPE_CONNECTION_ID = 1,
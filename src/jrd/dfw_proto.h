@@ -43,7 +43,8 @@ Jrd::DeferredWork* DFW_post_work(Jrd::jrd_tra*, Jrd::dfw_t, const Firebird::stri
 	const Jrd::MetaName& package = NULL);
 Jrd::DeferredWork* DFW_post_work_arg(Jrd::jrd_tra*, Jrd::DeferredWork*, const dsc*, USHORT);
 Jrd::DeferredWork* DFW_post_work_arg(Jrd::jrd_tra*, Jrd::DeferredWork*, const dsc*, USHORT, Jrd::dfw_t);
-void DFW_update_index(const TEXT*, USHORT, const Jrd::SelectivityList&, Jrd::jrd_tra*);
+void DFW_update_index(const TEXT*, USHORT, const Jrd::SelectivityList&, const Jrd::IndexStatistics*,
+	Jrd::jrd_tra*);
 void DFW_reset_icu(Jrd::thread_db*);
 
 #endif // JRD_DFW_PROTO_H
@@ -66,6 +66,28 @@ namespace Jrd
 
 		return desc;
 	}
+
+	// Get the unscaled value of a SMALLINT, INTEGER or BIGINT descriptor.
+	// Return false for other data types.
+	inline bool EVL_get_exact(const dsc* desc, SINT64& value)
+	{
+		switch (desc->dsc_dtype)
+		{
+			case dtype_short:
+				value = *(SSHORT*) desc->dsc_address;
+				return true;
+
+			case dtype_long:
+				value = *(SLONG*) desc->dsc_address;
+				return true;
+
+			case dtype_int64:
+				value = *(SINT64*) desc->dsc_address;
+				return true;
+		}
+
+		return false;
+	}
 }
 
 #endif // JRD_EVL_PROTO_H
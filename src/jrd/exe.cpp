@@ -1655,9 +1655,14 @@ const StmtNode* EXE_looper(thread_db* tdbb, Request* request, const StmtNode* no
 						profilerInitialTicks = profilerLastTicks = profilerManager->queryTicks();
 						profilerInitialAccumulatedOverhead = profilerLastAccumulatedOverhead =
 							profilerManager->getAccumulatedOverhead();
+
+						if (profilerManager->isSampling() && !exeState.oldRequest)
+							profilerManager->resetSampling(profilerInitialTicks);
 					}
 
-					if (node->hasLineColumn &&
+					if (profilerManager->isSampling())
+						profilerManager->checkSample(request);
+					else if (node->hasLineColumn &&
 						node->isProfileAware() &&
 						(!profileNode ||
 						 !(node->line == profileNode->line && node->column == profileNode->column)))
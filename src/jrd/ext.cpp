@@ -60,25 +60,6 @@
 #include "../common/isc_f_proto.h"
 #include "../common/os/os_utils.h"
 
-#if defined _MSC_VER && _MSC_VER < 1400
-// NS: in VS2003 these only work with static CRT
-extern "C" {
-int __cdecl _fseeki64(FILE*, __int64, int);
-__int64 __cdecl _ftelli64(FILE*);
-}
-#endif
-
-#ifdef WIN_NT
-#define FTELL64 _ftelli64
-#define FSEEK64 _fseeki64
-#elif defined(LSB_BUILD)
-#define FTELL64 ftello64
-#define FSEEK64 fseeko64
-#else
-#define FTELL64 ftello
-#define FSEEK64 fseeko
-#endif
-
 using namespace Firebird;
 
 namespace Jrd
@@ -155,6 +136,244 @@ namespace {
 
 		return ext_file->ext_ifi;
 	}
+
+	FB_UINT64 ext_size(FILE* file)
+	{
+#ifdef WIN_NT
+		struct __stat64 statistics;
+		if (!_fstat64(_fileno(file), &statistics))
+#else
+		struct STAT statistics;
+		if (!os_utils::fstat(fileno(file), &statistics))
+#endif
+		{
+			return statistics.st_size;
+		}
+
+		return 0;
+	}
+
+	// Size of data read from the file at once, it grows while the file is read sequentially
+	const ULONG EXT_BUFFER_MIN = 64 * 1024;
+	const ULONG EXT_BUFFER_MAX = 1024 * 1024;
+
+	// Limit of a text record length
+	const ULONG EXT_RECORD_MAX = 16 * 1024 * 1024;
+
+	const UCHAR EXT_QUOTE = '"';
+
+	// Return the file data starting at the given position, reading them into the buffer
+	// if it doesn't contain the requested length yet. Less data is available at the end of file.
+
+	const UCHAR* ext_read(ExternalFile* file, ExternalBuffer& buffer, FB_UINT64 position,
+		ULONG length, ULONG& available)
+	{
+		if (position >= buffer.ext_position &&
+			position + length <= buffer.ext_position + buffer.ext_length)
+		{
+			const ULONG offset = (ULONG) (position - buffer.ext_position);
+			available = buffer.ext_length - offset;
+			return buffer.ext_data.begin() + offset;
+		}
+
+		ULONG size = buffer.ext_length ? MIN(buffer.ext_length * 2, EXT_BUFFER_MAX) : 0;
+		size = MAX(MAX(size, EXT_BUFFER_MIN), length);
+
+		// hvlad: fseek will flush file buffer and degrade performance, so don't
+		// call it if it is not necessary. Note that we must flush file buffer if we
+		// do read after write
+
+		bool doSeek = false;
+		if (!(file->ext_flags & EXT_last_read))
+		{
+			doSeek = true;
+		}
+		else
+		{
+			SINT64 offset = FTELL64(file->ext_ifi);
+			if (offset < 0)
+			{
+				ERR_post(Arg::Gds(isc_io_error) << STRINGIZE(FTELL64) << Arg::Str(file->ext_filename) <<
+						 Arg::Gds(isc_io_read_err) << SYS_ERR(errno));
+			}
+			doSeek = (static_cast<FB_UINT64>(offset) != position);
+		}
+
+		// reset both flags cause we are going to move the file pointer
+		file->ext_flags &= ~(EXT_last_write | EXT_last_read);
+
+		if (doSeek)
+		{
+			if (FSEEK64(file->ext_ifi, position, SEEK_SET) != 0)
+			{
+				ERR_post(Arg::Gds(isc_io_error) << STRINGIZE(FSEEK64) << Arg::Str(file->ext_filename) <<
+						 Arg::Gds(isc_io_open_err) << SYS_ERR(errno));
+			}
+		}
+
+		buffer.ext_position = position;
+		buffer.ext_length = (ULONG) fread(buffer.ext_data.getBuffer(size, false), 1, size, file->ext_ifi);
+
+		file->ext_flags |= EXT_last_read;
+
+		available = buffer.ext_length;
+		return buffer.ext_data.begin();
+	}
+
+	// Move the fields of a text record into the record buffer
+
+	void ext_parse(thread_db* tdbb, jrd_rel* relation, Record* record,
+		const UCHAR* data, ULONG length, UCHAR delimiter)
+	{
+		const Format* const format = record->getFormat();
+
+		if (length && data[length - 1] == '\r')
+			length--;
+
+		const UCHAR* ptr = data;
+		const UCHAR* const end = data + length;
+		bool more = true;
+
+		HalfStaticArray<UCHAR, BUFFER_MEDIUM> value;
+		dsc desc;
+
+		record->nullify();
+
+		Format::fmt_desc_const_iterator desc_ptr = format->fmt_desc.begin();
+
+		USHORT i = 0;
+		for (vec<jrd_fld*>::iterator itr = relation->rel_fields->begin();
+			more && i < format->fmt_count; ++i, ++itr, ++desc_ptr)
+		{
+			const jrd_fld* field = *itr;
+
+			if (!desc_ptr->dsc_length || !field)
+				continue;
+
+			value.clear();
+
+			const bool quoted = (ptr < end && *ptr == EXT_QUOTE);
+
+			if (quoted)
+			{
+				for (++ptr; ptr < end; ++ptr)
+				{
+					if (*ptr == EXT_QUOTE)
+					{
+						if (ptr + 1 < end && ptr[1] == EXT_QUOTE)
+							++ptr;
+						else
+						{
+							++ptr;
+							break;
+						}
+					}
+
+					value.add(*ptr);
+				}
+			}
+
+			while (ptr < end && *ptr != delimiter)
+				value.add(*ptr++);
+
+			if (ptr < end)
+				++ptr;
+			else
+				more = false;
+
+			// Empty unquoted value means NULL
+			if (!quoted && value.isEmpty())
+				continue;
+
+			if (value.getCount() > MAX_USHORT)
+				ERR_post(Arg::Gds(isc_string_truncation));
+
+			const USHORT ttype = (desc_ptr->isText() || desc_ptr->isBlob()) ?
+				desc_ptr->getTextType() : ttype_ascii;
+
+			dsc text;
+			text.makeText((USHORT) value.getCount(), ttype, value.begin());
+
+			desc = *desc_ptr;
+			desc.dsc_address = record->getData() + (IPTR) desc.dsc_address;
+			MOV_move(tdbb, &text, &desc);
+
+			const LiteralNode* literal = nodeAs<LiteralNode>(field->fld_missing_value);
+
+			if (literal && !MOV_compare(tdbb, &literal->litDesc, &desc))
+				continue;
+
+			record->clearNull(i);
+		}
+	}
+
+	// Append the fields of a record to a text record
+
+	void ext_format(thread_db* tdbb, jrd_rel* relation, Record* record,
+		HalfStaticArray<UCHAR, BUFFER_MEDIUM>& line, UCHAR delimiter)
+	{
+		const Format* const format = record->getFormat();
+
+		MoveBuffer buffer;
+		dsc desc;
+		bool first = true;
+
+		Format::fmt_desc_const_iterator desc_ptr = format->fmt_desc.begin();
+
+		USHORT i = 0;
+		for (vec<jrd_fld*>::iterator itr = relation->rel_fields->begin();
+			i < format->fmt_count; ++i, ++itr, ++desc_ptr)
+		{
+			const jrd_fld* field = *itr;
+
+			if (!desc_ptr->dsc_length || !field)
+				continue;
+
+			if (!first)
+				line.add(delimiter);
+
+			first = false;
+
+			// NULL is written as an empty value
+			if (record->isNull(i))
+				continue;
+
+			desc = *desc_ptr;
+			desc.dsc_address = record->getData() + (IPTR) desc.dsc_address;
+
+			const USHORT ttype = (desc.isText() || desc.isBlob()) ? desc.getTextType() : ttype_ascii;
+
+			UCHAR* address;
+			const ULONG length = MOV_make_string2(tdbb, &desc, ttype, &address, buffer, false);
+
+			bool quote = !length;
+
+			for (ULONG n = 0; n < length && !quote; n++)
+			{
+				const UCHAR c = address[n];
+				quote = (c == delimiter || c == EXT_QUOTE || c == '\r' || c == '\n');
+			}
+
+			if (quote)
+			{
+				line.add(EXT_QUOTE);
+
+				for (ULONG n = 0; n < length; n++)
+				{
+					if (address[n] == EXT_QUOTE)
+						line.add(EXT_QUOTE);
+
+					line.add(address[n]);
+				}
+
+				line.add(EXT_QUOTE);
+			}
+			else
+				line.add(address, length);
+		}
+
+		line.add('\n');
+	}
 } // namespace
 
 
@@ -182,18 +401,7 @@ double EXT_cardinality(thread_db* tdbb, jrd_rel* relation)
 			must_close = true;
 		}
 
-		FB_UINT64 file_size = 0;
-
-#ifdef WIN_NT
-		struct __stat64 statistics;
-		if (!_fstat64(_fileno(file->ext_ifi), &statistics))
-#else
-		struct STAT statistics;
-		if (!os_utils::fstat(fileno(file->ext_ifi), &statistics))
-#endif
-		{
-			file_size = statistics.st_size;
-		}
+		const FB_UINT64 file_size = ext_size(file->ext_ifi);
 
 		if (must_close)
 		{
@@ -204,7 +412,11 @@ double EXT_cardinality(thread_db* tdbb, jrd_rel* relation)
 		const Format* const format = MET_current(tdbb, relation);
 		fb_assert(format && format->fmt_length);
 		const USHORT offset = (USHORT)(IPTR) format->fmt_desc[0].dsc_address;
-		const ULONG record_length = format->fmt_length - offset;
+		ULONG record_length = format->fmt_length - offset;
+
+		// Text records are usually shorter than the record buffer
+		if (file->ext_delimiter)
+			record_length = MAX(record_length / 4, 1);
 
 		return (double) file_size / record_length;
 	}
@@ -234,8 +446,7 @@ void EXT_erase(record_param*, jrd_tra*)
 }
 
 
-// Third param is unused.
-ExternalFile* EXT_file(jrd_rel* relation, const TEXT* file_name) //, bid* description)
+ExternalFile* EXT_file(jrd_rel* relation, const TEXT* file_name, const TEXT* file_format)
 {
 /**************************************
  *
@@ -309,11 +520,127 @@ ExternalFile* EXT_file(jrd_rel* relation, const TEXT* file_name) //, bid* descri
 	strcpy(file->ext_filename, file_name);
 	file->ext_flags = 0;
 	file->ext_ifi = NULL;
+	file->ext_delimiter = 0;
+
+	// Format stored by older versions is not known, such files are read as fixed length records
+	USHORT flags = 0;
+	if (file_format && EXT_parse_format(file_format, file->ext_delimiter, flags))
+		file->ext_flags |= flags;
 
 	return file;
 }
 
 
+bool EXT_find_eol(const UCHAR* data, ULONG length, UCHAR delimiter, ULONG& eol)
+{
+/**************************************
+ *
+ *	E X T _ f i n d _ e o l
+ *
+ **************************************
+ *
+ * Functional description
+ *	Find the end of a text record. Line feeds inside quoted
+ *	values belong to the record. Like in ext_parse, only a quote
+ *	starting the field opens the quoted value, the doubled one
+ *	inside it stands for the quote itself.
+ *
+ **************************************/
+	bool fieldStart = true;
+	bool quoted = false;
+
+	for (eol = 0; eol < length; eol++)
+	{
+		const UCHAR c = data[eol];
+
+		if (quoted)
+		{
+			if (c == EXT_QUOTE)
+			{
+				if (eol + 1 < length && data[eol + 1] == EXT_QUOTE)
+					eol++;
+				else
+					quoted = false;
+			}
+		}
+		else if (c == '\n')
+			return true;
+		else if (c == EXT_QUOTE && fieldStart)
+			quoted = true;
+
+		fieldStart = (!quoted && c == delimiter);
+	}
+
+	return false;
+}
+
+
+bool EXT_parse_format(const string& text, UCHAR& delimiter, USHORT& flags, string* canonical)
+{
+/**************************************
+ *
+ *	E X T _ p a r s e _ f o r m a t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Parse the format of an external file:
+ *	FIXED, CSV or TSV, the two latter optionally
+ *	followed by HEADER. Return false if it's invalid.
+ *
+ **************************************/
+	ObjectsArray<string> words;
+
+	for (FB_SIZE_T pos = 0; pos < text.length();)
+	{
+		const FB_SIZE_T start = text.find_first_not_of(" \t\r\n", pos);
+		if (start == string::npos)
+			break;
+
+		FB_SIZE_T finish = text.find_first_of(" \t\r\n", start);
+		if (finish == string::npos)
+			finish = text.length();
+
+		string& word = words.add();
+		word = text.substr(start, finish - start);
+		word.upper();
+
+		pos = finish;
+	}
+
+	if (words.isEmpty() || words.getCount() > 2)
+		return false;
+
+	delimiter = 0;
+	flags = 0;
+
+	if (words[0] == "CSV")
+		delimiter = ',';
+	else if (words[0] == "TSV")
+		delimiter = '\t';
+	else if (words[0] != "FIXED")
+		return false;
+
+	if (words.getCount() > 1)
+	{
+		if (!delimiter || words[1] != "HEADER")
+			return false;
+
+		flags |= EXT_header;
+	}
+
+	if (canonical)
+	{
+		canonical->assign(words[0]);
+
+		if (flags & EXT_header)
+			canonical->append(" HEADER");
+	}
+
+	return true;
+}
+
+
 void EXT_fini(jrd_rel* relation, bool close_only)
 {
 /**************************************
@@ -345,7 +672,7 @@ void EXT_fini(jrd_rel* relation, bool close_only)
 }
 
 
-bool EXT_get(thread_db* tdbb, record_param* rpb, FB_UINT64& position)
+bool EXT_get(thread_db* tdbb, record_param* rpb, FB_UINT64& position, ExternalBuffer& buffer)
 {
 /**************************************
  *
@@ -364,10 +691,6 @@ bool EXT_get(thread_db* tdbb, record_param* rpb, FB_UINT64& position)
 	Record* const record = rpb->rpb_record;
 	const Format* const format = record->getFormat();
 
-	const USHORT offset = (USHORT) (IPTR) format->fmt_desc[0].dsc_address;
-	UCHAR* p = record->getData() + offset;
-	const ULONG l = record->getLength() - offset;
-
 	if (file->ext_ifi == NULL)
 	{
 		ERR_post(Arg::Gds(isc_io_error) << "fseek" << Arg::Str(file->ext_filename) <<
@@ -375,45 +698,67 @@ bool EXT_get(thread_db* tdbb, record_param* rpb, FB_UINT64& position)
 				 Arg::Gds(isc_random) << "File not opened");
 	}
 
-	// hvlad: fseek will flush file buffer and degrade performance, so don't
-	// call it if it is not necessary. Note that we must flush file buffer if we
-	// do read after write
-
-	bool doSeek = false;
-	if (!(file->ext_flags & EXT_last_read))
-	{
-		doSeek = true;
-	}
-	else
+	if (file->ext_delimiter)
 	{
-		SINT64 offset = FTELL64(file->ext_ifi);
-		if (offset < 0)
+		// Text records are terminated by line feeds, blank lines and the header are skipped
+
+		for (;;)
 		{
-			ERR_post(Arg::Gds(isc_io_error) << STRINGIZE(FTELL64) << Arg::Str(file->ext_filename) <<
-					 Arg::Gds(isc_io_read_err) << SYS_ERR(errno));
-		}
-		doSeek = (static_cast<FB_UINT64>(offset) != position);
-	}
+			ULONG length = 1, available, eol;
+			const UCHAR* data;
 
-	// reset both flags cause we are going to move the file pointer
-	file->ext_flags &= ~(EXT_last_write | EXT_last_read);
+			for (;;)
+			{
+				data = ext_read(file, buffer, position, length, available);
 
-	if (doSeek)
-	{
-		if (FSEEK64(file->ext_ifi, position, SEEK_SET) != 0)
-		{
-			ERR_post(Arg::Gds(isc_io_error) << STRINGIZE(FSEEK64) << Arg::Str(file->ext_filename) <<
-					 Arg::Gds(isc_io_open_err) << SYS_ERR(errno));
+				if (EXT_find_eol(data, available, file->ext_delimiter, eol))
+					break;
+
+				if (available < length)
+				{
+					// Last record may miss the line feed
+					if (!available)
+						return false;
+
+					eol = available;
+					break;
+				}
+
+				if (available >= EXT_RECORD_MAX)
+				{
+					ERR_post(Arg::Gds(isc_ext_record_too_long) << Arg::Num(position) <<
+							 Arg::Str(file->ext_filename));
+				}
+
+				length = available * 2;
+			}
+
+			const bool header = (file->ext_flags & EXT_header) && position == 0;
+
+			position += MIN(eol + 1, available);
+
+			if (header || !eol || (eol == 1 && data[0] == '\r'))
+				continue;
+
+			ext_parse(tdbb, relation, record, data, eol, file->ext_delimiter);
+			return true;
 		}
 	}
 
-	if (!fread(p, l, 1, file->ext_ifi))
+	const USHORT offset = (USHORT) (IPTR) format->fmt_desc[0].dsc_address;
+	UCHAR* p = record->getData() + offset;
+	const ULONG l = record->getLength() - offset;
+
+	ULONG available;
+	const UCHAR* const data = ext_read(file, buffer, position, l, available);
+
+	if (available < l)
 	{
 		return false;
 	}
 
+	memcpy(p, data, l);
 	position += l;
-	file->ext_flags |= EXT_last_read;
 
 	// Loop thru fields setting missing fields to either blanks/zeros or the missing value
 
@@ -551,7 +896,16 @@ void EXT_store(thread_db* tdbb, record_param* rpb)
 
 	const USHORT offset = (USHORT) (IPTR) format->fmt_desc[0].dsc_address;
 	const UCHAR* p = record->getData() + offset;
-	const ULONG l = record->getLength() - offset;
+	ULONG l = record->getLength() - offset;
+
+	HalfStaticArray<UCHAR, BUFFER_MEDIUM> line;
+
+	if (file->ext_delimiter)
+	{
+		ext_format(tdbb, relation, record, line, file->ext_delimiter);
+		p = line.begin();
+		l = line.getCount();
+	}
 
 	// hvlad: fseek will flush file buffer and degrade performance, so don't
 	// call it if it is not necessary.	Note that we must flush file buffer if we
@@ -25,6 +25,26 @@
 #define JRD_EXT_H
 
 #include <stdio.h>
+#include "../common/classes/array.h"
+
+#if defined _MSC_VER && _MSC_VER < 1400
+// NS: in VS2003 these only work with static CRT
+extern "C" {
+int __cdecl _fseeki64(FILE*, __int64, int);
+__int64 __cdecl _ftelli64(FILE*);
+}
+#endif
+
+#ifdef WIN_NT
+#define FTELL64 _ftelli64
+#define FSEEK64 _fseeki64
+#elif defined(LSB_BUILD)
+#define FTELL64 ftello64
+#define FSEEK64 fseeko64
+#else
+#define FTELL64 ftello
+#define FSEEK64 fseeko
+#endif
 
 namespace Jrd {
 
@@ -36,12 +56,29 @@ public:
 	USHORT	ext_flags;			// Misc and cruddy flags
 	USHORT	ext_tra_cnt;		// How many transactions used the file
 	FILE*	ext_ifi;			// Internal file identifier
+	UCHAR	ext_delimiter;		// Field delimiter of text records, zero for fixed length records
 	char	ext_filename[1];
 };
 
 const int EXT_readonly		= 1;	// File could only be opened for read
 const int EXT_last_read		= 2;	// last operation was read
 const int EXT_last_write	= 4;	// last operation was write
+const int EXT_header		= 8;	// first line of text records contains column names
+
+// Data of an external file buffered by a table scan
+
+class ExternalBuffer
+{
+public:
+	explicit ExternalBuffer(MemoryPool& pool)
+		: ext_data(pool), ext_position(0), ext_length(0)
+	{
+	}
+
+	Firebird::Array<UCHAR> ext_data;
+	FB_UINT64 ext_position;		// file position of the data
+	ULONG ext_length;			// length of the data read
+};
 
 } //namespace Jrd
 
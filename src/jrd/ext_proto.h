@@ -25,6 +25,7 @@
 #define JRD_EXT_PROTO_H
 
 namespace Jrd {
+	class ExternalBuffer;
 	class ExternalFile;
 	class jrd_tra;
 	class RecordSource;
@@ -35,12 +36,14 @@ namespace Jrd {
 
 double	EXT_cardinality(Jrd::thread_db*, Jrd::jrd_rel*);
 void	EXT_erase(Jrd::record_param*, Jrd::jrd_tra*);
-Jrd::ExternalFile*	EXT_file(Jrd::jrd_rel*, const TEXT*); //, Jrd::bid*);
+Jrd::ExternalFile*	EXT_file(Jrd::jrd_rel*, const TEXT*, const TEXT*);
+bool	EXT_find_eol(const UCHAR*, ULONG, UCHAR, ULONG&);
 void	EXT_fini(Jrd::jrd_rel*, bool);
-bool	EXT_get(Jrd::thread_db*, Jrd::record_param*, FB_UINT64&);
+bool	EXT_get(Jrd::thread_db*, Jrd::record_param*, FB_UINT64&, Jrd::ExternalBuffer&);
 void	EXT_modify(Jrd::record_param*, Jrd::record_param*, Jrd::jrd_tra*);
 
 void	EXT_open(Jrd::Database*, Jrd::ExternalFile*);
+bool	EXT_parse_format(const Firebird::string&, UCHAR&, USHORT&, Firebird::string* = NULL);
 void	EXT_store(Jrd::thread_db*, Jrd::record_param*);
 
 void EXT_tra_attach(Jrd::ExternalFile*, Jrd::jrd_tra*);
@@ -234,3 +234,8 @@
 	FIELD(fld_integer		, nam_integer		, dtype_long	, sizeof(SLONG)				, 0							, NULL		, true		, ODS_13_1)
 
 	FIELD(fld_par_workers	, nam_par_workers	, dtype_long	, sizeof(SLONG)				, 0							, NULL		, true		, ODS_13_1)
+
+	FIELD(fld_wait_type		, nam_wait_type		, dtype_short	, sizeof(SSHORT)			, 0							, NULL		, true		, ODS_14_0)
+	FIELD(fld_io_file_type	, nam_io_file_type	, dtype_short	, sizeof(SSHORT)			, 0							, NULL		, true		, ODS_14_0)
+	FIELD(fld_io_operation	, nam_io_operation	, dtype_short	, sizeof(SSHORT)			, 0							, NULL		, true		, ODS_14_0)
+	FIELD(fld_ext_format	, nam_ext_format	, dtype_varying	, 31						, dsc_text_type_ascii		, NULL		, true		, ODS_14_0)
@@ -1491,7 +1491,8 @@ void IDX_modify_flag_uk_modified(thread_db* tdbb,
 }
 
 
-void IDX_statistics(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity)
+void IDX_statistics(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity,
+					IndexStatistics* statistics)
 {
 /**************************************
  *
@@ -1501,13 +1502,13 @@ void IDX_statistics(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityLi
  *
  * Functional description
  *	Scan index pages recomputing
- *	selectivity.
+ *	selectivity and key distribution.
  *
  **************************************/
 
 	SET_TDBB(tdbb);
 
-	BTR_selectivity(tdbb, relation, id, selectivity);
+	BTR_selectivity(tdbb, relation, id, selectivity, statistics);
 }
 
 
@@ -2163,6 +2164,9 @@ static void release_index_block(thread_db* tdbb, IndexBlock* index_block)
 	}
 	index_block->idb_condition = nullptr;
 
+	// The key distribution is reloaded when needed next time
+	index_block->idb_selectivity = 0;
+
 	LCK_release(tdbb, index_block->idb_lock);
 }
 
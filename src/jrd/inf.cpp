@@ -891,6 +891,11 @@ void INF_database_info(thread_db* tdbb,
 			length = INF_convert(0, buffer);
 			break;
 
+		case fb_info_wire_stats:
+			// answered by remote client, embedded connection has no wire
+			length = 0;
+			break;
+
 		case fb_info_features:
 			{
 				static const unsigned char features[] = ENGINE_FEATURES;
@@ -7732,6 +7732,7 @@ void release_attachment(thread_db* tdbb, Jrd::Attachment* attachment, XThreadEns
 
 	MET_clear_cache(tdbb);
 
+	attachment->releaseGenRanges(tdbb);
 	attachment->releaseLocks(tdbb);
 
 	// Shut down any extern relations
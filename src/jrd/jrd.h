@@ -122,6 +122,7 @@ class ExternalFile;
 class ViewContext;
 class IndexBlock;
 class IndexLock;
+class IndexStatistics;
 class ArrayField;
 struct sort_context;
 class vcl;
@@ -308,6 +309,8 @@ public:
 	dsc			idb_expression_desc;		// descriptor for expression result
 	BoolExprNode* idb_condition;			// node tree for index condition
 	Statement* idb_condition_statement;		// statement for index condition evaluation
+	IndexStatistics* idb_statistics;		// key distribution of the index
+	float		idb_selectivity;			// index selectivity the distribution was loaded for
 	Lock*		idb_lock;					// lock to synchronize changes to index
 	USHORT		idb_id;
 };
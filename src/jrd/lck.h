@@ -76,7 +76,8 @@ enum lck_t {
 	LCK_repl_state,				// Replication state lock
 	LCK_repl_tables,			// Replication set lock
 	LCK_dsql_statement_cache,	// DSQL statement cache lock
-	LCK_profiler_listener		// Remote profiler listener
+	LCK_profiler_listener,		// Remote profiler listener
+	LCK_gen_ranges				// Cached generator ranges lock
 };
 
 // Lock owner types
@@ -473,3 +473,24 @@ NAME("RDB$VARBINARY_MAX", nam_varbinary_max)
 NAME("RDB$INTEGER", nam_integer)
 
 NAME("MON$PARALLEL_WORKERS", nam_par_workers)
+
+NAME("RDB$WAIT_TYPE", nam_wait_type)
+NAME("MON$WAIT_STATS", nam_mon_wait_stats)
+NAME("MON$WAIT_TYPE", nam_mon_wait_type)
+NAME("MON$WAIT_COUNT", nam_mon_wait_count)
+NAME("MON$WAIT_TIME", nam_mon_wait_time)
+
+NAME("RDB$IO_FILE_TYPE", nam_io_file_type)
+NAME("RDB$IO_OPERATION", nam_io_operation)
+NAME("MON$FILE_IO_STATS", nam_mon_file_io_stats)
+NAME("MON$FILE_NAME", nam_mon_file_name)
+NAME("MON$FILE_TYPE", nam_mon_file_type)
+NAME("MON$IO_OPERATION", nam_mon_io_operation)
+NAME("MON$LATENCY_BOUND", nam_mon_latency_bound)
+NAME("MON$IO_COUNT", nam_mon_io_count)
+NAME("MON$IO_BYTES", nam_mon_io_bytes)
+NAME("MON$IO_TIME", nam_mon_io_time)
+
+NAME("RDB$KEY_DISTRIBUTION", nam_key_distribution)
+NAME("RDB$GENERATOR_CACHE", nam_gen_cache)
+NAME("RDB$EXTERNAL_FORMAT", nam_ext_format)
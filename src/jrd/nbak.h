@@ -493,6 +493,13 @@ public:
 
 	// Get size (in pages) of locked database file
 	ULONG getPageCount(thread_db* tdbb);
+
+	// Difference file, caller should hold the state lock
+	const jrd_file* getDiffFile() const
+	{
+		return diff_file;
+	}
+
 private:
 	friend class NBackupStateLock;
 
@@ -52,6 +52,64 @@
 using namespace Firebird;
 using namespace Jrd;
 
+namespace
+{
+	// Check whether the value or the inversion uses the given streams
+
+	bool dependsOnStreams(const ValueExprNode* value, const StreamList& streams)
+	{
+		for (const auto stream : streams)
+		{
+			if (value && value->containsStream(stream))
+				return true;
+		}
+
+		return false;
+	}
+
+	bool dependsOnStreams(const InversionNode* inversion, const StreamList& streams)
+	{
+		switch (inversion->type)
+		{
+		case InversionNode::TYPE_AND:
+		case InversionNode::TYPE_OR:
+		case InversionNode::TYPE_IN:
+			return dependsOnStreams(inversion->node1, streams) ||
+				dependsOnStreams(inversion->node2, streams);
+
+		case InversionNode::TYPE_INDEX:
+			{
+				const auto retrieval = inversion->retrieval;
+
+				if (!retrieval->irb_value)
+					return false;
+
+				const auto lower = retrieval->irb_value;
+				const auto upper = retrieval->irb_value + retrieval->irb_desc.idx_count;
+
+				for (unsigned i = 0; i < retrieval->irb_lower_count; i++)
+				{
+					if (dependsOnStreams(lower[i], streams))
+						return true;
+				}
+
+				for (unsigned i = 0; i < retrieval->irb_upper_count; i++)
+				{
+					if (dependsOnStreams(upper[i], streams))
+						return true;
+				}
+
+				return false;
+			}
+
+		case InversionNode::TYPE_DBKEY:
+			return dependsOnStreams(inversion->value, streams);
+		}
+
+		return false;
+	}
+}
+
 
 //
 // Constructor
@@ -230,7 +288,7 @@ void InnerJoin::estimateCost(unsigned position,
 			// probing + copying cost
 			cardinality * (COST_FACTOR_HASHING + currentCardinality * COST_FACTOR_MEMCOPY);
 
-		if (hashCost <= loopCost && hashCardinality <= HashJoin::maxCapacity())
+		if (hashCardinality <= HashJoin::maxCapacity())
 		{
 			auto& equiMatches = joinedStreams[position].equiMatches;
 			fb_assert(!equiMatches.hasData());
@@ -262,9 +320,13 @@ void InnerJoin::estimateCost(unsigned position,
 				}
 			}
 
-			// Adjust the actual cost value, if hash joining is both possible and preferrable
-			if (equiMatches.hasData())
+			// Adjust the actual cost value, if hash joining is both possible and preferrable.
+			// Otherwise the matches are remembered for a possible adaptive hash join.
+			if (equiMatches.hasData() && hashCost <= loopCost)
+			{
+				joinedStreams[position].hashJoin = true;
 				cost = hashCost;
+			}
 		}
 	}
 
@@ -507,6 +569,12 @@ River* InnerJoin::formRiver()
 	HalfStaticArray<RecordSource*, OPT_STATIC_ITEMS> rsbs;
 	HalfStaticArray<BoolExprNode*, OPT_STATIC_ITEMS> equiMatches;
 
+	// Joins may adapt to the actual cardinalities at runtime, unless the user-specified
+	// plan must be followed or the first rows are requested to be returned faster
+
+	const ULONG adaptiveFactor = (plan || optimizer->favorFirstRows()) ? 0 :
+		tdbb->getDatabase()->dbb_config->getAdaptiveJoinFactor();
+
 	for (const auto& stream : bestStreams)
 	{
 		const bool sortUtilized = (orgSortNode && !*orgSortPtr);
@@ -519,12 +587,42 @@ River* InnerJoin::formRiver()
 		//    OR
 		//    - existing sort was not utilized using an index
 
-		if (rsbs.hasData() && // this is not the first stream
-			stream.equiMatches.hasData() &&
-			(!optimizer->favorFirstRows() || !sortUtilized))
+		const bool hashJoin = (rsbs.hasData() && // this is not the first stream
+			stream.hashJoin &&
+			(!optimizer->favorFirstRows() || !sortUtilized));
+
+		// An adaptive join switches between hashing and index lookups using values from
+		// the prior streams, so it needs the nested loop retrieval for the latter ones.
+		// Conjuncts it utilizes are given back to the hash join retrieval.
+
+		const bool adaptive = (adaptiveFactor && rsbs.hasData() && stream.equiMatches.hasData());
+
+		RecordSource* loopRsb = nullptr;
+		InversionNode* inversion = nullptr;
+		Optimizer::ConjunctFlags conjunctFlags;
+
+		if (adaptive)
+			optimizer->getConjunctFlags(conjunctFlags);
+
+		if (!hashJoin)
+		{
+			loopRsb = optimizer->generateRetrieval(stream.number, sortPtr, false, false,
+				nullptr, &inversion);
+		}
+
+		const bool lookup = (adaptive && !hashJoin &&
+			inversion && dependsOnStreams(inversion, streams));
+
+		if (hashJoin || lookup)
 		{
 			fb_assert(streams.hasData());
 
+			if (!hashJoin && !sortUtilized)
+				batchPriorStreams(rsbs, streams, stream.number, inversion);
+
+			if (loopRsb)
+				optimizer->setConjunctFlags(conjunctFlags);
+
 			// Deactivate priorly joined streams
 			StreamStateHolder stateHolder(csb, streams);
 			stateHolder.deactivate();
@@ -569,8 +667,12 @@ River* InnerJoin::formRiver()
 			// Ensure the smallest stream is the one to be hashed,
 			// unless the prior record source is already a join.
 			// But we can swap the streams only if the sort node was not utilized.
-			if (rsb->getCardinality() > priorRsb->getCardinality() &&
-				(streams.getCount() == 1) && !sortUtilized)
+			// Nested loops being adapted keep the prior streams leading.
+			const bool swapped = (hashJoin &&
+				rsb->getCardinality() > priorRsb->getCardinality() &&
+				(streams.getCount() == 1) && !sortUtilized);
+
+			if (swapped)
 			{
 				// Swap the sides
 				std::swap(hashJoinRsbs[0], hashJoinRsbs[1]);
@@ -578,14 +680,66 @@ River* InnerJoin::formRiver()
 			}
 
 			// Create a hash join
-			rsb = FB_NEW_POOL(getPool())
+			const auto hashJoinRsb = FB_NEW_POOL(getPool())
 				HashJoin(tdbb, csb, 2, hashJoinRsbs, keys.begin(), stream.selectivity);
 
+			// If nested loops were estimated to be cheaper, start with index lookups
+			// and switch to hashing if the prior streams return too many rows.
+			// If the stream leads the hash join, switch to index lookups into it
+			// if the hashed prior stream returns too few rows.
+
+			if (!hashJoin)
+			{
+				hashJoinRsb->setLookup(loopRsb, false,
+					(FB_UINT64) (priorRsb->getCardinality() * adaptiveFactor));
+			}
+			else if (adaptive && swapped)
+			{
+				const auto threshold = (FB_UINT64) (priorRsb->getCardinality() / adaptiveFactor);
+
+				if (threshold)
+				{
+					// Look for the lookup retrieval as if the hash join retrieval
+					// did not exist and then restore the conjuncts it utilizes
+
+					Optimizer::ConjunctFlags hashFlags;
+					optimizer->getConjunctFlags(hashFlags);
+					optimizer->setConjunctFlags(conjunctFlags);
+
+					stateHolder.activate();
+
+					if (hasLookup(stream.number, streams))
+					{
+						loopRsb = optimizer->generateRetrieval(stream.number, nullptr, false, false,
+							nullptr, &inversion);
+
+						if (inversion && dependsOnStreams(inversion, streams))
+							hashJoinRsb->setLookup(loopRsb, true, threshold);
+					}
+
+					optimizer->setConjunctFlags(hashFlags);
+				}
+			}
+
+			rsb = hashJoinRsb;
+
 			// Clear priorly processed rsb's, as they're already incorporated into a hash join
 			rsbs.clear();
 		}
 		else
-			rsb = optimizer->generateRetrieval(stream.number, sortPtr, false, false);
+		{
+			rsb = loopRsb;
+
+			// Rows cannot be reordered if the sort was utilized using an index
+			// or the user-specified plan must be followed. And the batching is
+			// avoided if the first rows are requested to be returned faster.
+
+			if (rsbs.hasData() && inversion && !plan && !sortUtilized &&
+				!optimizer->favorFirstRows())
+			{
+				batchPriorStreams(rsbs, streams, stream.number, inversion);
+			}
+		}
 
 		rsbs.add(rsb);
 		streams.add(stream.number);
@@ -680,6 +834,115 @@ void InnerJoin::getIndexedRelationships(StreamInfo* testStream)
 }
 
 
+//
+// Check whether the stream can be retrieved via an index using values from the prior streams
+//
+
+bool InnerJoin::hasLookup(StreamType stream, const StreamList& streams)
+{
+	Retrieval retrieval(tdbb, optimizer, stream, false, false, nullptr, true);
+	const auto candidate = retrieval.getInversion();
+
+	for (const auto priorStream : streams)
+	{
+		if (candidate->dependentFromStreams.exist(priorStream))
+			return true;
+	}
+
+	return false;
+}
+
+
+//
+// If the stream is looked up via an index using values from the prior streams,
+// sort the prior rows by these values in batches. This way the index is probed
+// in the key order and the pages read by one lookup are likely to be reused
+// by the next ones, thus turning random I/O into a mostly sequential one.
+//
+
+void InnerJoin::batchPriorStreams(HalfStaticArray<RecordSource*, OPT_STATIC_ITEMS>& rsbs,
+								  const StreamList& streams, StreamType stream,
+								  const InversionNode* inversion)
+{
+	double priorCardinality = MINIMUM_CARDINALITY;
+	for (const auto priorRsb : rsbs)
+		priorCardinality *= priorRsb->getCardinality();
+
+	const auto tail = &csb->csb_rpt[stream];
+
+	if (priorCardinality < JOIN_BATCH_SIZE || tail->csb_cardinality < JOIN_BATCH_SIZE)
+		return;
+
+	if (const auto sort = getBatchKeys(inversion, streams))
+	{
+		const auto priorRsb = (rsbs.getCount() == 1) ? rsbs[0] :
+			FB_NEW_POOL(getPool()) NestedLoopJoin(csb, rsbs.getCount(), rsbs.begin());
+
+		const auto sortRsb = optimizer->generateSort(streams, nullptr,
+			priorRsb, sort, false, false);
+		sortRsb->setBatchSize(JOIN_BATCH_SIZE);
+
+		rsbs.clear();
+		rsbs.add(sortRsb);
+	}
+}
+
+
+//
+// Return the sort clause ordering the prior streams by the lookup keys
+// of the given index retrieval, or nullptr if the retrieval does not
+// depend on the prior streams
+//
+
+SortNode* InnerJoin::getBatchKeys(const InversionNode* inversion, const StreamList& streams)
+{
+	if (inversion->type != InversionNode::TYPE_INDEX)
+		return nullptr;
+
+	const auto retrieval = inversion->retrieval;
+
+	if (!retrieval->irb_value || retrieval->irb_list)
+		return nullptr;
+
+	// Equality and lower bound lookups start at the lower key, the others at the upper one
+	const auto count = retrieval->irb_lower_count ?
+		retrieval->irb_lower_count : retrieval->irb_upper_count;
+	const auto values = retrieval->irb_lower_count ?
+		retrieval->irb_value : retrieval->irb_value + retrieval->irb_desc.idx_count;
+
+	const auto direction = (retrieval->irb_generic & irb_descending) ? ORDER_DESC : ORDER_ASC;
+
+	const auto sort = FB_NEW_POOL(getPool()) SortNode(getPool());
+	bool dependent = false;
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		const auto value = values[i];
+
+		for (const auto stream : streams)
+		{
+			if (value->containsStream(stream))
+			{
+				dependent = true;
+				break;
+			}
+		}
+
+		sort->direction.add(direction);
+		sort->nullOrder.add(NULLS_DEFAULT);
+		sort->expressions.add(value);
+	}
+
+	if (!dependent)
+	{
+		delete sort;
+		return nullptr;
+	}
+
+	return sort;
+}
+
+
 //
 // Return stream information based on the stream number
 //
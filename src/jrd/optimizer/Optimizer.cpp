@@ -1018,6 +1018,8 @@ RecordSource* Optimizer::compile(BoolExprNodeStack* parentStack)
 
 	checkIndices();
 
+	SortedStream* sortStream = nullptr;
+
 	if (project || sort)
 	{
 		// Eliminate any duplicate dbkey streams
@@ -1030,11 +1032,11 @@ RecordSource* Optimizer::compile(BoolExprNodeStack* parentStack)
 
 		// Handle project clause, if present
 		if (project)
-			rsb = generateSort(bedStreams, &keyStreams, rsb, project, favorFirstRows(), true);
+			rsb = sortStream = generateSort(bedStreams, &keyStreams, rsb, project, favorFirstRows(), true);
 
 		// Handle sort clause if present
 		if (sort)
-			rsb = generateSort(bedStreams, &keyStreams, rsb, sort, favorFirstRows(), false);
+			rsb = sortStream = generateSort(bedStreams, &keyStreams, rsb, sort, favorFirstRows(), false);
 	}
 
 	// Add invariant booleans, if any. They should be evaluated before
@@ -1048,11 +1050,17 @@ RecordSource* Optimizer::compile(BoolExprNodeStack* parentStack)
     // functions add their nodes at the beginning of the rsb list we MUST call
     // gen_skip before gen_first.
 
+	// The sort under FIRST (and SKIP) has to produce only the first
+	// FIRST + SKIP records, let it know that number at runtime.
+
+	if (!rse->rse_first)
+		sortStream = nullptr;
+
 	if (rse->rse_skip)
-		rsb = FB_NEW_POOL(getPool()) SkipRowsStream(csb, rsb, rse->rse_skip);
+		rsb = FB_NEW_POOL(getPool()) SkipRowsStream(csb, rsb, rse->rse_skip, sortStream);
 
 	if (rse->rse_first)
-		rsb = FB_NEW_POOL(getPool()) FirstRowsStream(csb, rsb, rse->rse_first);
+		rsb = FB_NEW_POOL(getPool()) FirstRowsStream(csb, rsb, rse->rse_first, sortStream);
 
 	if (rse->isSingular())
 		rsb = FB_NEW_POOL(getPool()) SingularStream(csb, rsb);
@@ -1136,7 +1144,7 @@ void Optimizer::compileRelation(StreamType stream)
 				if (idx.idx_selectivity <= 0.0f)
 				{
 					SelectivityList	selectivity;
-					BTR_selectivity(tdbb, relation, idx.idx_id, selectivity);
+					BTR_selectivity(tdbb, relation, idx.idx_id, selectivity, nullptr);
 					if (selectivity[0] > 0.0f)
 						updated = true;
 				}
@@ -2556,7 +2564,8 @@ RecordSource* Optimizer::generateRetrieval(StreamType stream,
 										   SortNode** sortClause,
 										   bool outerFlag,
 										   bool innerFlag,
-										   BoolExprNode** returnBoolean)
+										   BoolExprNode** returnBoolean,
+										   InversionNode** returnInversion)
 {
 	const auto tail = &csb->csb_rpt[stream];
 	const auto relation = tail->csb_relation;
@@ -2719,6 +2728,9 @@ RecordSource* Optimizer::generateRetrieval(StreamType stream,
 		{
 			rsb = FB_NEW_POOL(getPool()) BitmapTableScan(csb, alias, stream, relation,
 				inversion, scanSelectivity);
+
+			if (returnInversion)
+				*returnInversion = inversion;
 		}
 		else
 		{
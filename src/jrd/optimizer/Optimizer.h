@@ -70,6 +70,12 @@ const double DEFAULT_CARDINALITY = 1000.0;
 // so it's not included here.
 const double DEFAULT_INDEX_COST = 3.0;
 
+// Number of rows the prior streams of a nested loop join are sorted by
+// in order to probe the index of the next stream in the key order.
+// Such batching is used only if both the number of probes and
+// the probed table are expected to be at least that large.
+const unsigned JOIN_BATCH_SIZE = 1000;
+
 
 struct index_desc;
 class jrd_rel;
@@ -253,6 +259,7 @@ public:
 	static const unsigned CONJUNCT_JOINED	= 4;	// conjunct used for equi-join
 
 	typedef Firebird::HalfStaticArray<Conjunct, OPT_STATIC_ITEMS> ConjunctList;
+	typedef Firebird::HalfStaticArray<unsigned, OPT_STATIC_ITEMS> ConjunctFlags;
 
 	class ConjunctIterator
 	{
@@ -353,6 +360,23 @@ public:
 		return ConjunctIterator(begin, end);
 	}
 
+	// Conjunct flags are saved and restored to generate alternative retrievals
+	void getConjunctFlags(ConjunctFlags& flags) const
+	{
+		flags.clear();
+
+		for (const auto& conjunct : conjuncts)
+			flags.add(conjunct.flags);
+	}
+
+	void setConjunctFlags(const ConjunctFlags& flags)
+	{
+		fb_assert(flags.getCount() == conjuncts.getCount());
+
+		for (FB_SIZE_T i = 0; i < conjuncts.getCount(); i++)
+			conjuncts[i].flags = flags[i];
+	}
+
 	static Firebird::string getPlan(thread_db* tdbb, const Statement* statement, bool detailed)
 	{
 		return statement ? statement->getPlan(tdbb, detailed) : "";
@@ -462,7 +486,8 @@ public:
 									SortNode** sortClause,
 									bool outerFlag,
 									bool innerFlag,
-									BoolExprNode** returnBoolean = nullptr);
+									BoolExprNode** returnBoolean = nullptr,
+									InversionNode** returnInversion = nullptr);
 	SortedStream* generateSort(const StreamList& streams,
 							   const StreamList* dbkeyStreams,
 							   RecordSource* rsb, SortNode* sort,
@@ -695,6 +720,8 @@ protected:
 	InversionNode* composeInversion(InversionNode* node1, InversionNode* node2,
 		InversionNode::Type node_type) const;
 	const Firebird::string& getAlias();
+	bool getDistributionSelectivity(const IndexScratch& scratch, const IndexScratchSegment& segment,
+		double& selectivity) const;
 	void getInversionCandidates(InversionCandidateList& inversions,
 		IndexScratchList& indexScratches, unsigned scope) const;
 	InversionNode* makeIndexScanNode(IndexScratch* indexScratch) const;
@@ -850,11 +877,13 @@ class InnerJoin : private Firebird::PermanentStorage
 		{
 			number = num;
 			selectivity = 0.0;
+			hashJoin = false;
 			equiMatches.clear();
 		}
 
 		StreamType number;			// stream in position of join order
 		double selectivity = 0.0;	// position selectivity
+		bool hashJoin = false;		// hash join is cheaper than nested loops
 		Firebird::Vector<BoolExprNode*, MAX_EQUI_MATCHES> equiMatches;
 	};
 
@@ -881,6 +910,10 @@ protected:
 		IndexedRelationships& processList, double cost, double cardinality);
 	void getIndexedRelationships(StreamInfo* testStream);
 	StreamInfo* getStreamInfo(StreamType stream);
+	SortNode* getBatchKeys(const InversionNode* inversion, const StreamList& streams);
+	bool hasLookup(StreamType stream, const StreamList& streams);
+	void batchPriorStreams(Firebird::HalfStaticArray<RecordSource*, OPT_STATIC_ITEMS>& rsbs,
+		const StreamList& streams, StreamType stream, const InversionNode* inversion);
 #ifdef OPT_DEBUG
 	void printBestOrder() const;
 	void printFoundOrder(StreamType position, double positionCost,
@@ -238,6 +238,84 @@ const string& Retrieval::getAlias()
 	return alias;
 }
 
+// Estimate the selectivity of the leading segment match using the key distribution
+// collected by SET STATISTICS INDEX. It's possible only if the matched values
+// are literals, i.e. they can be converted into the index keys at prepare time.
+
+bool Retrieval::getDistributionSelectivity(const IndexScratch& scratch,
+										   const IndexScratchSegment& segment,
+										   double& selectivity) const
+{
+	const auto idx = scratch.index;
+
+	if (scratch.usePartialKey)
+		return false;
+
+	const auto lowerLiteral = nodeAs<LiteralNode>(segment.lowerValue);
+	const auto upperLiteral = nodeAs<LiteralNode>(segment.upperValue);
+
+	if ((segment.lowerValue && !lowerLiteral) || (segment.upperValue && !upperLiteral) ||
+		(!lowerLiteral && !upperLiteral))
+	{
+		return false;
+	}
+
+	const auto statistics = MET_lookup_index_statistics(tdbb, relation, idx);
+
+	if (!statistics)
+		return false;
+
+	temporary_key lowerKey, upperKey;
+	const temporary_key* lower = nullptr;
+	const temporary_key* upper = nullptr;
+
+	try
+	{
+		if (lowerLiteral)
+		{
+			if (!BTR_make_leading_key(tdbb, idx, &lowerLiteral->litDesc, segment.scale, &lowerKey))
+				return false;
+
+			lower = &lowerKey;
+		}
+
+		if (upperLiteral)
+		{
+			if (!BTR_make_leading_key(tdbb, idx, &upperLiteral->litDesc, segment.scale, &upperKey))
+				return false;
+
+			upper = &upperKey;
+		}
+	}
+	catch (const Exception&)
+	{
+		// The literal is not convertible to the key, leave it to the execution
+		fb_utils::init_status(tdbb->tdbb_status_vector);
+		return false;
+	}
+
+	switch (segment.scanType)
+	{
+		case segmentScanEqual:
+		case segmentScanEquivalent:
+			return statistics->getEqualSelectivity(lower ? lower : upper, selectivity);
+
+		case segmentScanBetween:
+		case segmentScanLess:
+		case segmentScanGreater:
+			// Keys of the descending index are ordered the other way around
+			if (idx->idx_flags & idx_descending)
+				std::swap(lower, upper);
+
+			return statistics->getRangeSelectivity(lower, upper, selectivity);
+
+		default:
+			break;
+	}
+
+	return false;
+}
+
 InversionCandidate* Retrieval::getInversion()
 {
 	if (finalCandidate)
@@ -853,6 +931,7 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 			bool unique = false;
 			unsigned listCount = 0;
 			auto maxSelectivity = scratch.selectivity;
+			double distributionFactor = 1;
 
 			for (unsigned j = 0; j < scratch.segments.getCount(); j++)
 			{
@@ -902,6 +981,22 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 				if (useDefaultSelectivity)
 					selectivity = MAX(scratch.selectivity * DEFAULT_SELECTIVITY, minSelectivity);
 
+				// The leading segment values may be estimated using the key distribution.
+				// The next segments are assumed to deviate from their average selectivity
+				// the same way as the leading one.
+				double estimated = 0;
+				const bool useDistribution = (j == 0 && !useDefaultSelectivity &&
+					getDistributionSelectivity(scratch, segment, estimated));
+
+				if (useDistribution &&
+					(scanType == segmentScanEqual || scanType == segmentScanEquivalent))
+				{
+					distributionFactor = estimated / selectivity;
+					selectivity = estimated;
+				}
+				else if (j > 0 && !useDefaultSelectivity)
+					selectivity = MIN(selectivity * distributionFactor, scratch.selectivity);
+
 				if (scanType == segmentScanList)
 				{
 					if (listCount) // we cannot have more than one list matched to an index
@@ -1001,11 +1096,17 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 								break;
 						}
 
-						// Adjust the compound selectivity using the reduce factor.
-						// It should be better than the previous segment but worse
-						// than a full match.
-						const double diffSelectivity = scratch.selectivity - selectivity;
-						selectivity += (diffSelectivity * factor);
+						if (useDistribution)
+							selectivity = estimated;
+						else
+						{
+							// Adjust the compound selectivity using the reduce factor.
+							// It should be better than the previous segment but worse
+							// than a full match.
+							const double diffSelectivity = scratch.selectivity - selectivity;
+							selectivity += (diffSelectivity * factor);
+						}
+
 						fb_assert(selectivity <= scratch.selectivity);
 						scratch.selectivity = selectivity;
 
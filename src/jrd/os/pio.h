@@ -33,6 +33,7 @@
 #include "../common/classes/rwlock.h"
 #include "../common/classes/array.h"
 #include "../common/classes/File.h"
+#include "../common/classes/IoLatency.h"
 
 namespace Jrd {
 
@@ -48,6 +49,7 @@ public:
 	USHORT fil_fudge;			// Fudge factor for page relocation
 	int fil_desc;
 	Firebird::Mutex fil_mutex;
+	Firebird::IoLatencyStats fil_io_stats;	// I/O latencies
 	USHORT fil_flags;
 	SCHAR fil_string[1];		// Expanded file name
 };
@@ -76,6 +78,7 @@ public:
 	USHORT fil_fudge;					// Fudge factor for page relocation
 	HANDLE fil_desc;					// File descriptor
 	Firebird::RWLock* fil_ext_lock;		// file extend lock
+	Firebird::IoLatencyStats fil_io_stats;	// I/O latencies
 	USHORT fil_flags;
 	SCHAR fil_string[1];				// Expanded file name
 };
@@ -428,6 +428,8 @@ void PIO_flush(thread_db* tdbb, jrd_file* main_file)
 	{
 		if (file->fil_desc != -1)
 		{
+			IoLatencyStats::Timer timer(file->fil_io_stats, IoLatencyStats::IO_SYNC);
+
 			// This really should be an error
 			fsync(file->fil_desc);
 		}
@@ -815,7 +817,12 @@ bool PIO_read(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page,
 		if (!(file = seek_file(file, bdb, &offset, status_vector)))
 			return false;
 
-		if ((bytes = os_utils::pread(file->fil_desc, page, size, LSEEK_OFFSET_CAST offset)) == size)
+		{ // scope
+			IoLatencyStats::Timer timer(file->fil_io_stats, IoLatencyStats::IO_READ, size);
+			bytes = os_utils::pread(file->fil_desc, page, size, LSEEK_OFFSET_CAST offset);
+		}
+
+		if (bytes == size)
 		{
 			// os_utils::posix_fadvise(file->desc, offset, size, POSIX_FADV_NOREUSE);
 			return true;
@@ -867,7 +874,12 @@ bool PIO_write(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page,
 		if (!(file = seek_file(file, bdb, &offset, status_vector)))
 			return false;
 
-		if ((bytes = os_utils::pwrite(file->fil_desc, page, size, LSEEK_OFFSET_CAST offset)) == size)
+		{ // scope
+			IoLatencyStats::Timer timer(file->fil_io_stats, IoLatencyStats::IO_WRITE, size);
+			bytes = os_utils::pwrite(file->fil_desc, page, size, LSEEK_OFFSET_CAST offset);
+		}
+
+		if (bytes == size)
 		{
 			// os_utils::posix_fadvise(file->desc, offset, size, POSIX_FADV_DONTNEED);
 			return true;
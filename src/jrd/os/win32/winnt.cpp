@@ -321,7 +321,10 @@ void PIO_flush(thread_db* tdbb, jrd_file* main_file)
 	EngineCheckout cout(tdbb, FB_FUNCTION, EngineCheckout::UNNECESSARY);
 
 	for (jrd_file* file = main_file; file; file = file->fil_next)
+	{
+		IoLatencyStats::Timer timer(file->fil_io_stats, IoLatencyStats::IO_SYNC);
 		FlushFileBuffers(file->fil_desc);
+	}
 }
 
 
@@ -596,11 +599,17 @@ bool PIO_read(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page,
 	HANDLE desc = file->fil_desc;
 
 	DWORD actual_length;
-	BOOL ret = ReadFile(desc, page, size, &actual_length, &overlapped);
-	if (!ret)
-	{
-		if (GetLastError() == ERROR_IO_PENDING)
-			ret = GetOverlappedResult(desc, &overlapped, &actual_length, TRUE);
+	BOOL ret;
+
+	{ // scope
+		IoLatencyStats::Timer timer(file->fil_io_stats, IoLatencyStats::IO_READ, size);
+
+		ret = ReadFile(desc, page, size, &actual_length, &overlapped);
+		if (!ret)
+		{
+			if (GetLastError() == ERROR_IO_PENDING)
+				ret = GetOverlappedResult(desc, &overlapped, &actual_length, TRUE);
+		}
 	}
 
 	if (!ret || (size != actual_length))
@@ -774,11 +783,17 @@ bool PIO_write(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page,
 	HANDLE desc = file->fil_desc;
 
 	DWORD actual_length;
-	BOOL ret = WriteFile(desc, page, size, &actual_length, &overlapped);
-	if (!ret)
-	{
-		if (GetLastError() == ERROR_IO_PENDING)
-			ret = GetOverlappedResult(desc, &overlapped, &actual_length, TRUE);
+	BOOL ret;
+
+	{ // scope
+		IoLatencyStats::Timer timer(file->fil_io_stats, IoLatencyStats::IO_WRITE, size);
+
+		ret = WriteFile(desc, page, size, &actual_length, &overlapped);
+		if (!ret)
+		{
+			if (GetLastError() == ERROR_IO_PENDING)
+				ret = GetOverlappedResult(desc, &overlapped, &actual_length, TRUE);
+		}
 	}
 
 	if (!ret || (size != actual_length))
@@ -23,6 +23,7 @@
 #include "firebird.h"
 #include "../jrd/jrd.h"
 #include "../jrd/req.h"
+#include "../jrd/ext.h"
 #include "../jrd/cmp_proto.h"
 #include "../jrd/ext_proto.h"
 #include "../jrd/met_proto.h"
@@ -61,6 +62,7 @@ void ExternalTableScan::internalOpen(thread_db* tdbb) const
 	VIO_record(tdbb, rpb, MET_current(tdbb, m_relation), request->req_pool);
 
 	impure->irsb_position = 0;
+	impure->irsb_buffer = FB_NEW_POOL(*request->req_pool) ExternalBuffer(*request->req_pool);
 	rpb->rpb_number.setValue(BOF_NUMBER);
 }
 
@@ -73,7 +75,12 @@ void ExternalTableScan::close(thread_db* tdbb) const
 	Impure* const impure = request->getImpure<Impure>(m_impure);
 
 	if (impure->irsb_flags & irsb_open)
+	{
 		impure->irsb_flags &= ~irsb_open;
+
+		delete impure->irsb_buffer;
+		impure->irsb_buffer = NULL;
+	}
 }
 
 bool ExternalTableScan::internalGetRecord(thread_db* tdbb) const
@@ -92,7 +99,7 @@ bool ExternalTableScan::internalGetRecord(thread_db* tdbb) const
 
 	rpb->rpb_runtime_flags &= ~RPB_CLEAR_FLAGS;
 
-	if (EXT_get(tdbb, rpb, impure->irsb_position))
+	if (EXT_get(tdbb, rpb, impure->irsb_position, *impure->irsb_buffer))
 	{
 		rpb->rpb_number.increment();
 		rpb->rpb_number.setValid(true);
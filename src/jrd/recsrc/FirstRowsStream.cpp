@@ -37,10 +37,12 @@ using namespace Jrd;
 // Data access: first N rows filter
 // --------------------------------
 
-FirstRowsStream::FirstRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value)
+FirstRowsStream::FirstRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value,
+		const SortedStream* sort)
 	: RecordSource(csb),
 	  m_next(next),
-	  m_value(value)
+	  m_value(value),
+	  m_sort(sort)
 {
 	fb_assert(m_next && m_value);
 
@@ -69,6 +71,10 @@ void FirstRowsStream::internalOpen(thread_db* tdbb) const
 	{
 		impure->irsb_flags = irsb_open;
 		impure->irsb_count = value;
+
+		if (m_sort)
+			m_sort->setLimit(request, value);
+
 		m_next->open(tdbb);
 	}
 }
@@ -310,12 +310,23 @@ HashJoin::HashJoin(thread_db* tdbb, CompilerScratch* csb, FB_SIZE_T count,
 	m_cardinality *= selectivity;
 }
 
+void HashJoin::setLookup(RecordSource* lookup, bool lookupLeader, FB_UINT64 threshold)
+{
+	fb_assert(lookup && m_args.getCount() == 1);
+
+	m_lookup = lookup;
+	m_lookupLeader = lookupLeader;
+	m_lookupThreshold = threshold;
+}
+
 void HashJoin::internalOpen(thread_db* tdbb) const
 {
 	Request* const request = tdbb->getRequest();
 	Impure* const impure = request->getImpure<Impure>(m_impure);
 
 	impure->irsb_flags = irsb_open | irsb_mustread;
+	impure->irsb_lookup = (m_lookup && !m_lookupLeader);
+	impure->irsb_lookup_count = 0;
 
 	delete impure->irsb_hash_table;
 	impure->irsb_hash_table = nullptr;
@@ -346,6 +357,9 @@ void HashJoin::close(thread_db* tdbb) const
 		for (FB_SIZE_T i = 0; i < m_args.getCount(); i++)
 			m_args[i].buffer->close(tdbb);
 
+		if (m_lookup)
+			m_lookup->close(tdbb);
+
 		m_leader.source->close(tdbb);
 	}
 }
@@ -360,6 +374,54 @@ bool HashJoin::internalGetRecord(thread_db* tdbb) const
 	if (!(impure->irsb_flags & irsb_open))
 		return false;
 
+	// Adaptive join: join the rows using index lookups
+
+	while (impure->irsb_lookup)
+	{
+		if (impure->irsb_flags & irsb_mustread)
+		{
+			if (m_lookupLeader)
+			{
+				// Look up the leading stream for every hashed row
+
+				const BufferedStream* const arg = m_args[0].buffer;
+
+				if (impure->irsb_lookup_count >= arg->getCount(tdbb))
+					return false;
+
+				arg->locate(tdbb, impure->irsb_lookup_count++);
+
+				if (!arg->getRecord(tdbb))
+					return false;
+			}
+			else
+			{
+				// Look up the hashed stream for every leading row,
+				// but switch to hashing if there are too many of them
+
+				if (impure->irsb_lookup_count == m_lookupThreshold)
+				{
+					impure->irsb_lookup = false;
+					break;
+				}
+
+				if (!m_leader.source->getRecord(tdbb))
+					return false;
+
+				impure->irsb_lookup_count++;
+			}
+
+			m_lookup->open(tdbb);
+			impure->irsb_flags &= ~irsb_mustread;
+		}
+
+		if (m_lookup->getRecord(tdbb))
+			return true;
+
+		m_lookup->close(tdbb);
+		impure->irsb_flags |= irsb_mustread;
+	}
+
 	while (true)
 	{
 		if (impure->irsb_flags & irsb_mustread)
@@ -399,6 +461,18 @@ bool HashJoin::internalGetRecord(thread_db* tdbb) const
 				}
 
 				impure->irsb_hash_table->sort();
+
+				// If the hashed rows are too few, look up the leading stream
+				// for each of them instead of reading it as a whole
+
+				if (m_lookup && m_lookupLeader &&
+					m_args[0].buffer->getCount(tdbb) <= m_lookupThreshold)
+				{
+					m_leader.source->close(tdbb);
+					impure->irsb_lookup = true;
+
+					return internalGetRecord(tdbb);
+				}
 			}
 
 			// Compute and hash the comparison keys
@@ -464,6 +538,23 @@ WriteLockResult HashJoin::lockRecord(thread_db* /*tdbb*/) const
 void HashJoin::getLegacyPlan(thread_db* tdbb, string& plan, unsigned level) const
 {
 	level++;
+
+	// Adaptive join is shown as the nested loops it switches to or from,
+	// the lookup retrieval joined to the stream providing the key values
+
+	if (m_lookup)
+	{
+		const auto source = m_lookupLeader ? m_args[0].source : m_leader.source;
+
+		plan += "JOIN (";
+		source->getLegacyPlan(tdbb, plan, level);
+		plan += ", ";
+		m_lookup->getLegacyPlan(tdbb, plan, level);
+		plan += ")";
+
+		return;
+	}
+
 	plan += "HASH (";
 	m_leader.source->getLegacyPlan(tdbb, plan, level);
 	plan += ", ";
@@ -485,6 +576,24 @@ void HashJoin::internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned l
 	extras.printf(" (keys: %" ULONGFORMAT", total key length: %" ULONGFORMAT")",
 				  m_leader.keys->getCount(), m_leader.totalKeyLength);
 
+	if (m_lookup)
+	{
+		string adaptive;
+
+		if (m_lookupLeader)
+		{
+			adaptive.printf(" (adaptive: index lookups if no more than %" UQUADFORMAT" hashed rows)",
+				m_lookupThreshold);
+		}
+		else
+		{
+			adaptive.printf(" (adaptive: index lookups for first %" UQUADFORMAT" leading rows)",
+				m_lookupThreshold);
+		}
+
+		extras += adaptive;
+	}
+
 	planEntry.lines.add().text = "Hash Join (inner)" + extras;
 	printOptInfo(planEntry.lines);
 
@@ -496,6 +605,9 @@ void HashJoin::internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned l
 
 		for (const auto& arg : m_args)
 			arg.source->getPlan(tdbb, planEntry.children.add(), level, recurse);
+
+		if (m_lookup)
+			m_lookup->getPlan(tdbb, planEntry.children.add(), level, recurse);
 	}
 }
 
@@ -505,6 +617,9 @@ void HashJoin::markRecursive()
 
 	for (FB_SIZE_T i = 0; i < m_args.getCount(); i++)
 		m_args[i].source->markRecursive();
+
+	if (m_lookup)
+		m_lookup->markRecursive();
 }
 
 void HashJoin::findUsedStreams(StreamList& streams, bool expandAll) const
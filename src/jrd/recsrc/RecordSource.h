@@ -42,6 +42,7 @@ namespace Jrd
 	class AggNode;
 	class BoolExprNode;
 	class DeclareLocalTableNode;
+	class ExternalBuffer;
 	class Sort;
 	class CompilerScratch;
 	class BtrPageGCLock;
@@ -51,6 +52,7 @@ namespace Jrd
 	struct win;
 	class BaseBufferedStream;
 	class BufferedStream;
+	class SortedStream;
 	class PlanEntry;
 
 	enum JoinType { INNER_JOIN, OUTER_JOIN, SEMI_JOIN, ANTI_JOIN };
@@ -349,6 +351,7 @@ namespace Jrd
 		struct Impure : public RecordSource::Impure
 		{
 			FB_UINT64 irsb_position;
+			ExternalBuffer* irsb_buffer;
 		};
 
 	public:
@@ -503,7 +506,8 @@ namespace Jrd
 		};
 
 	public:
-		FirstRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value);
+		FirstRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value,
+			const SortedStream* sort = nullptr);
 
 		void close(thread_db* tdbb) const override;
 
@@ -531,6 +535,7 @@ namespace Jrd
 	private:
 		NestConst<RecordSource> m_next;
 		NestConst<ValueExprNode> const m_value;
+		const SortedStream* const m_sort;	// sort to be limited by the number of rows
 	};
 
 	class SkipRowsStream : public RecordSource
@@ -541,7 +546,8 @@ namespace Jrd
 		};
 
 	public:
-		SkipRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value);
+		SkipRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value,
+			const SortedStream* sort = nullptr);
 
 		void close(thread_db* tdbb) const override;
 
@@ -569,6 +575,7 @@ namespace Jrd
 	private:
 		NestConst<RecordSource> m_next;
 		NestConst<ValueExprNode> const m_value;
+		const SortedStream* const m_sort;	// sort to be limited by the number of rows
 	};
 
 	class FilteredStream : public RecordSource
@@ -634,6 +641,7 @@ namespace Jrd
 		struct Impure : public RecordSource::Impure
 		{
 			Sort* irsb_sort;
+			FB_UINT64 irsb_limit;	// number of first records needed, zero if all
 		};
 
 	public:
@@ -726,6 +734,16 @@ namespace Jrd
 
 		bool compareKeys(const UCHAR* p, const UCHAR* q) const;
 
+		// Called by FIRST / SKIP before opening the stream
+		void setLimit(Request* request, FB_UINT64 limit) const;
+		void extendLimit(Request* request, FB_UINT64 count) const;
+
+		// Sort the input by portions of the given number of records
+		void setBatchSize(ULONG size)
+		{
+			m_batchSize = size;
+		}
+
 		UCHAR* getData(thread_db* tdbb) const;
 		void mapData(thread_db* tdbb, Request* request, UCHAR* data) const;
 
@@ -752,6 +770,7 @@ namespace Jrd
 
 		NestConst<RecordSource> m_next;
 		const SortMap* const m_map;
+		ULONG m_batchSize = 0;
 	};
 
 	// Make moves in a window without going out of partition boundaries.
@@ -1016,6 +1035,9 @@ namespace Jrd
 			SINT64 locateFrameRange(thread_db* tdbb, Request* request, Impure* impure,
 				const Frame* frame, const dsc* offsetDesc, SINT64 position) const;
 
+			bool slideWindow(thread_db* tdbb, Request* request,
+				const Block& lastWindow, const Block& window) const;
+
 		private:
 			NestConst<SortNode> m_order;
 			const MapNode* m_windowMap;
@@ -1025,6 +1047,7 @@ namespace Jrd
 			NestValueArray m_winPassSources, m_winPassTargets;
 			Exclusion m_exclusion;
 			UCHAR m_invariantOffsets;	// 0x1 | 0x2 bitmask
+			bool m_removableAggs;		// all aggregates support aggRemove
 		};
 
 	public:
@@ -1215,6 +1238,8 @@ namespace Jrd
 			HashTable* irsb_hash_table;
 			UCHAR* irsb_leader_buffer;
 			ULONG irsb_leader_hash;
+			bool irsb_lookup;					// index lookups are used instead of hashing
+			FB_UINT64 irsb_lookup_count;		// number of rows driving the lookups
 		};
 
 	public:
@@ -1222,6 +1247,14 @@ namespace Jrd
 				 RecordSource* const* args, NestValueArray* const* keys,
 				 double selectivity = 0);
 
+		// Make the join adaptive. The lookup retrieval either retrieves the hashed
+		// stream using values from the leading one, in this case the join starts
+		// with index lookups and switches to hashing after the threshold number
+		// of leading rows. Or it retrieves the leading stream using values from
+		// the hashed one, then index lookups are used instead of hashing if there
+		// are no more hashed rows than the threshold.
+		void setLookup(RecordSource* lookup, bool lookupLeader, FB_UINT64 threshold);
+
 		void close(thread_db* tdbb) const override;
 
 		bool refetchRecord(thread_db* tdbb) const override;
@@ -1249,6 +1282,9 @@ namespace Jrd
 
 		SubStream m_leader;
 		Firebird::Array<SubStream> m_args;
+		NestConst<RecordSource> m_lookup;
+		bool m_lookupLeader = false;
+		FB_UINT64 m_lookupThreshold = 0;
 	};
 
 	class MergeJoin : public RecordSource
@@ -36,10 +36,12 @@ using namespace Jrd;
 // Data access: skip N rows filter
 // -------------------------------
 
-SkipRowsStream::SkipRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value)
+SkipRowsStream::SkipRowsStream(CompilerScratch* csb, RecordSource* next, ValueExprNode* value,
+		const SortedStream* sort)
 	: RecordSource(csb),
 	  m_next(next),
-	  m_value(value)
+	  m_value(value),
+	  m_sort(sort)
 {
 	fb_assert(m_next && m_value);
 
@@ -64,6 +66,9 @@ void SkipRowsStream::internalOpen(thread_db* tdbb) const
 
 	impure->irsb_count = value + 1;
 
+	if (m_sort)
+		m_sort->extendLimit(request, value);
+
 	m_next->open(tdbb);
 }
 
@@ -69,6 +69,8 @@ void SortedStream::internalOpen(thread_db* tdbb) const
 	delete impure->irsb_sort;
 	impure->irsb_sort = nullptr;
 
+	m_next->open(tdbb);
+
 	impure->irsb_sort = init(tdbb);
 }
 
@@ -137,6 +139,13 @@ void SortedStream::internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsign
 	extras.printf(" (record length: %" ULONGFORMAT", key length: %" ULONGFORMAT")",
 		m_map->length, m_map->keyLength);
 
+	if (m_batchSize)
+	{
+		string batch;
+		batch.printf(" (batch size: %" ULONGFORMAT")", m_batchSize);
+		extras += batch;
+	}
+
 	auto planDescription = &planEntry.lines.add();
 
 	if (m_map->flags & FLAG_REFETCH)
@@ -160,6 +169,20 @@ void SortedStream::internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsign
 	}
 }
 
+void SortedStream::setLimit(Request* request, FB_UINT64 limit) const
+{
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+	impure->irsb_limit = limit;
+}
+
+void SortedStream::extendLimit(Request* request, FB_UINT64 count) const
+{
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+
+	if (impure->irsb_limit)
+		impure->irsb_limit += count;
+}
+
 void SortedStream::markRecursive()
 {
 	m_next->markRecursive();
@@ -184,22 +207,26 @@ Sort* SortedStream::init(thread_db* tdbb) const
 {
 	Request* const request = tdbb->getRequest();
 
-	m_next->open(tdbb);
-
 	// Initialize for sort. If this is really a project operation,
 	// establish a callback routine to reject duplicate records.
 
+	Impure* const impure = request->getImpure<Impure>(m_impure);
+	impure->irsb_flags &= ~irsb_mustread;
+
 	AutoPtr<Sort> scb(FB_NEW_POOL(request->req_sorts.getPool())
 		Sort(tdbb->getDatabase(), &request->req_sorts,
 			 m_map->length, m_map->keyItems.getCount(), m_map->keyItems.getCount(),
 			 m_map->keyItems.begin(),
-			 ((m_map->flags & FLAG_PROJECT) ? rejectDuplicate : nullptr), 0));
+			 ((m_map->flags & FLAG_PROJECT) ? rejectDuplicate : nullptr), 0,
+			 impure->irsb_limit));
 
 	// Pump the input stream dry while pushing records into sort. For
 	// each record, map all fields into the sort record. The reverse
-	// mapping is done in get_sort().
+	// mapping is done in get_sort(). In the batch mode, stop after
+	// the batch is full and continue when its records are fetched.
 
 	dsc to, temp;
+	ULONG count = 0;
 
 	while (m_next->getRecord(tdbb))
 	{
@@ -277,6 +304,12 @@ Sort* SortedStream::init(thread_db* tdbb) const
 				}
 			}
 		}
+
+		if (m_batchSize && ++count == m_batchSize)
+		{
+			impure->irsb_flags |= irsb_mustread;
+			break;
+		}
 	}
 
 	scb->sort(tdbb);
@@ -333,6 +366,17 @@ UCHAR* SortedStream::getData(thread_db* tdbb) const
 	ULONG* data = nullptr;
 	impure->irsb_sort->get(tdbb, &data);
 
+	// The current batch is exhausted, sort the next one
+
+	while (!data && (impure->irsb_flags & irsb_mustread))
+	{
+		delete impure->irsb_sort;
+		impure->irsb_sort = nullptr;
+
+		impure->irsb_sort = init(tdbb);
+		impure->irsb_sort->get(tdbb, &data);
+	}
+
 	return reinterpret_cast<UCHAR*>(data);
 }
 
@@ -465,7 +465,8 @@ WindowedStream::WindowStream::WindowStream(thread_db* tdbb, CompilerScratch* csb
 	  m_winPassSources(csb->csb_pool),
 	  m_winPassTargets(csb->csb_pool),
 	  m_exclusion(exclusion),
-	  m_invariantOffsets(0)
+	  m_invariantOffsets(0),
+	  m_removableAggs(false)
 {
 	// Separate nodes that requires the winPass call.
 
@@ -496,6 +497,16 @@ WindowedStream::WindowStream::WindowStream(thread_db* tdbb, CompilerScratch* csb
 		}
 	}
 
+	m_removableAggs = m_aggSources.hasData();
+
+	for (const auto& source : m_aggSources)
+	{
+		const AggNode* aggNode = nodeAs<AggNode>(source);
+
+		if (!(aggNode->getCapabilities() & AggNode::CAP_SUPPORTS_REMOVE) || aggNode->distinct)
+			m_removableAggs = false;
+	}
+
 	m_arithNodes.resize(2);
 
 	if (m_order)
@@ -802,14 +813,9 @@ bool WindowedStream::WindowStream::internalGetRecord(thread_db* tdbb) const
 			// This may be incompatible with some function like LIST, but currently LIST cannot
 			// be used in ordered windows anyway.
 
-			if (!lastWindow.isValid() ||
-				impure->windowBlock.startPosition > lastWindow.startPosition ||
-				impure->windowBlock.endPosition < lastWindow.endPosition)
-			{
-				aggInit(tdbb, request, m_windowMap);
-				m_next->locate(tdbb, impure->windowBlock.startPosition);
-			}
-			else
+			if (lastWindow.isValid() &&
+				impure->windowBlock.startPosition <= lastWindow.startPosition &&
+				impure->windowBlock.endPosition >= lastWindow.endPosition)
 			{
 				if (impure->windowBlock.startPosition < lastWindow.startPosition)
 				{
@@ -827,6 +833,11 @@ bool WindowedStream::WindowStream::internalGetRecord(thread_db* tdbb) const
 
 				m_next->locate(tdbb, lastWindow.endPosition + 1);
 			}
+			else if (!slideWindow(tdbb, request, lastWindow, impure->windowBlock))
+			{
+				aggInit(tdbb, request, m_windowMap);
+				m_next->locate(tdbb, impure->windowBlock.startPosition);
+			}
 
 			SINT64 aggPos = (SINT64) m_next->getPosition(request);
 
@@ -1086,6 +1097,45 @@ SINT64 WindowedStream::WindowStream::locateFrameRange(thread_db* tdbb, Request*
 	return rangePos;
 }
 
+// Move the last window aggregation forward, removing the rows that have left the frame instead
+// of aggregating the whole frame again. Returns false if the window should be aggregated from
+// scratch.
+bool WindowedStream::WindowStream::slideWindow(thread_db* tdbb, Request* request,
+	const Block& lastWindow, const Block& window) const
+{
+	if (!m_removableAggs || !lastWindow.isValid() ||
+		window.startPosition <= lastWindow.startPosition ||
+		window.startPosition > lastWindow.endPosition ||
+		window.endPosition < lastWindow.endPosition)
+	{
+		return false;
+	}
+
+	const SINT64 removeCount = window.startPosition - lastWindow.startPosition;
+	const SINT64 addCount = window.endPosition - lastWindow.endPosition;
+
+	if (removeCount + addCount > window.endPosition - window.startPosition + 1)
+		return false;
+
+	m_next->locate(tdbb, lastWindow.startPosition);
+
+	for (SINT64 pending = removeCount; pending > 0; --pending)
+	{
+		if (!m_next->getRecord(tdbb))
+			fb_assert(false);
+
+		for (const auto& source : m_aggSources)
+		{
+			if (!nodeAs<AggNode>(source)->aggRemove(tdbb, request))
+				return false;
+		}
+	}
+
+	m_next->locate(tdbb, lastWindow.endPosition + 1);
+
+	return true;
+}
+
 // ------------------------------
 
 SlidingWindow::SlidingWindow(thread_db* aTdbb, const BaseBufferedStream* aStream,
@@ -101,6 +101,7 @@ RELATION(nam_indices, rel_indices, ODS_8_0, rel_persistent)
 	FIELD(f_idx_statistics, nam_statistics, fld_statistics, 1, ODS_8_0)
 	FIELD(f_idx_cond_blr, nam_cond_blr, fld_value, 1, ODS_13_1)
 	FIELD(f_idx_cond_source, nam_cond_source, fld_source, 1, ODS_13_1)
+	FIELD(f_idx_distribution, nam_key_distribution, fld_blob, 1, ODS_14_0)
 END_RELATION
 
 // Relation 5 (RDB$RELATION_FIELDS)
@@ -148,6 +149,7 @@ RELATION(nam_relations, rel_relations, ODS_8_0, rel_persistent)
 	FIELD(f_rel_flags, nam_flags, fld_flag_nullable, 0, ODS_8_0)
 	FIELD(f_rel_type, nam_r_type, fld_r_type, 0, ODS_11_1)
 	FIELD(f_rel_sql_security, nam_sql_security, fld_b_sql_security, 1, ODS_13_0)
+	FIELD(f_rel_ext_format, nam_ext_format, fld_ext_format, 1, ODS_14_0)
 END_RELATION
 
 // Relation 7 (RDB$VIEW_RELATIONS)
@@ -323,6 +325,7 @@ RELATION(nam_gens, rel_gens, ODS_8_0, rel_persistent)
 	FIELD(f_gen_owner, nam_owner, fld_user, 1, ODS_12_0)
 	FIELD(f_gen_init_val, nam_init_val, fld_gen_val, 1, ODS_12_0)
 	FIELD(f_gen_increment, nam_gen_increment, fld_gen_increment, 1, ODS_12_0)
+	FIELD(f_gen_cache, nam_gen_cache, fld_integer, 1, ODS_14_0)
 END_RELATION
 
 // Relation 21 (RDB$FIELD_DIMENSIONS)
@@ -758,3 +761,23 @@ RELATION(nam_mon_compiled_statements, rel_mon_compiled_statements, ODS_13_1, rel
 	FIELD(f_mon_cmp_stmt_pkg_name, nam_mon_pkg_name, fld_pkg_name, 0, ODS_13_1)
 	FIELD(f_mon_cmp_stmt_stat_id, nam_mon_stat_id, fld_stat_id, 0, ODS_13_1)
 END_RELATION
+
+// Relation 56 (MON$WAIT_STATS)
+RELATION(nam_mon_wait_stats, rel_mon_wait_stats, ODS_14_0, rel_virtual)
+	FIELD(f_mon_wait_stat_id, nam_mon_stat_id, fld_stat_id, 0, ODS_14_0)
+	FIELD(f_mon_wait_stat_group, nam_mon_stat_group, fld_stat_group, 0, ODS_14_0)
+	FIELD(f_mon_wait_type, nam_mon_wait_type, fld_wait_type, 0, ODS_14_0)
+	FIELD(f_mon_wait_count, nam_mon_wait_count, fld_counter, 0, ODS_14_0)
+	FIELD(f_mon_wait_time, nam_mon_wait_time, fld_counter, 0, ODS_14_0)
+END_RELATION
+
+// Relation 57 (MON$FILE_IO_STATS)
+RELATION(nam_mon_file_io_stats, rel_mon_file_io_stats, ODS_14_0, rel_virtual)
+	FIELD(f_mon_fio_file_name, nam_mon_file_name, fld_file_name2, 0, ODS_14_0)
+	FIELD(f_mon_fio_file_type, nam_mon_file_type, fld_io_file_type, 0, ODS_14_0)
+	FIELD(f_mon_fio_operation, nam_mon_io_operation, fld_io_operation, 0, ODS_14_0)
+	FIELD(f_mon_fio_bound, nam_mon_latency_bound, fld_counter, 0, ODS_14_0)
+	FIELD(f_mon_fio_count, nam_mon_io_count, fld_counter, 0, ODS_14_0)
+	FIELD(f_mon_fio_bytes, nam_mon_io_bytes, fld_counter, 0, ODS_14_0)
+	FIELD(f_mon_fio_time, nam_mon_io_time, fld_counter, 0, ODS_14_0)
+END_RELATION
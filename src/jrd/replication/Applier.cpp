@@ -39,6 +39,7 @@
 #include "../jrd/rlck_proto.h"
 #include "../jrd/tra_proto.h"
 #include "../jrd/vio_proto.h"
+#include "../jrd/WorkerAttachment.h"
 #include "../dsql/dsql_proto.h"
 #include "firebird/impl/sqlda_pub.h"
 
@@ -181,6 +182,11 @@ namespace
 			return m_header->protocol;
 		}
 
+		USHORT getFlags() const
+		{
+			return m_header->flags;
+		}
+
 		void defineAtom()
 		{
 			const auto length = getByte();
@@ -237,6 +243,14 @@ Applier* Applier::create(thread_db* tdbb)
 	if (!attachment->locksmith(tdbb, REPLICATE_INTO_DATABASE))
 		status_exception::raise(Arg::Gds(isc_miss_prvlg) << "REPLICATE_INTO_DATABASE");
 
+	return createInternal(tdbb);
+}
+
+Applier* Applier::createInternal(thread_db* tdbb)
+{
+	const auto dbb = tdbb->getDatabase();
+	const auto attachment = tdbb->getAttachment();
+
 	Request* request = nullptr;
 	const auto req_pool = attachment->createPool();
 
@@ -275,6 +289,15 @@ void Applier::shutdown(thread_db* tdbb)
 	const auto dbb = tdbb->getDatabase();
 	const auto attachment = tdbb->getAttachment();
 
+	if (m_parallel)
+	{
+		if (!(dbb->dbb_flags & DBB_bugcheck))
+			m_parallel->cleanup();
+
+		delete m_parallel;
+		m_parallel = nullptr;
+	}
+
 	if (!(dbb->dbb_flags & DBB_bugcheck))
 	{
 		cleanupTransactions(tdbb);
@@ -305,6 +328,15 @@ void Applier::process(thread_db* tdbb, ULONG length, const UCHAR* data)
 
 	tdbb->tdbb_flags |= TDBB_replicator;
 
+	// Compressed blocks are unpacked before anything else is done
+
+	UCharBuffer unpacked;
+	if (length >= sizeof(Block) && (((const Block*) data)->flags & BLOCK_COMPRESSED))
+	{
+		length = decompressBlock(length, data, unpacked);
+		data = unpacked.begin();
+	}
+
 	BlockReader reader(length, data);
 
 	const auto traNum = reader.getTransactionId();
@@ -313,6 +345,24 @@ void Applier::process(thread_db* tdbb, ULONG length, const UCHAR* data)
 	if (protocol != PROTOCOL_CURRENT_VERSION)
 		raiseError("Unsupported replication protocol version %u", protocol);
 
+	// Sender which marks synchronization points allows the blocks
+	// to be applied asynchronously, so switch to the parallel mode
+	// if it was requested for this attachment
+
+	if (!m_parallel && (reader.getFlags() & BLOCK_SYNC_POINT))
+	{
+		const auto workers = tdbb->getAttachment()->att_parallel_workers;
+
+		if (workers > 1)
+			m_parallel = FB_NEW_POOL(getPool()) ParallelApplier(getPool(), this, workers);
+	}
+
+	if (m_parallel)
+	{
+		m_parallel->process(tdbb, length, data);
+		return;
+	}
+
 	while (!reader.isEof())
 	{
 		try
@@ -499,6 +549,9 @@ void Applier::rollbackTransaction(thread_db* tdbb, TraNumber traNum, bool cleanu
 
 void Applier::cleanupTransactions(thread_db* tdbb)
 {
+	if (m_parallel)
+		m_parallel->cleanup();
+
 	TransactionMap::Accessor txnAccessor(&m_txnMap);
 	if (txnAccessor.getFirst())
 	{
@@ -926,7 +979,10 @@ void Applier::setSequence(thread_db* tdbb, const MetaName& genName, SINT64 value
 	AutoSetRestoreFlag<ULONG> noCascade(&tdbb->tdbb_flags, TDBB_repl_in_progress, !m_enableCascade);
 
 	if (DPM_gen_id(tdbb, gen_id, false, 0) < value)
+	{
 		DPM_gen_id(tdbb, gen_id, true, value);
+		attachment->invalidateGenRanges(tdbb, true);
+	}
 }
 
 void Applier::storeBlob(thread_db* tdbb, TraNumber traNum, bid* blobId,
@@ -1410,3 +1466,750 @@ void Applier::logConflict(const char* msg, ...)
 	logReplicaWarning(m_database, buffer);
 #endif
 }
+
+
+// ParallelApplier class
+
+namespace
+{
+	// Queue size (in bytes) which causes the queued blocks to be applied
+	// even if the sender did not request a synchronization point yet
+	const ULONG MAX_QUEUE_SIZE = 16 * 1024 * 1024;
+
+	// Transactions ended by a failed flush, per replica database. The sender
+	// restarts from its last synchronization point using a new attachment,
+	// so they must survive the attachment which has applied them.
+
+	class EndedTransactions
+	{
+		struct Entry
+		{
+			explicit Entry(MemoryPool& pool)
+				: database(pool), transactions(pool)
+			{}
+
+			PathName database;
+			SortedArray<TraNumber> transactions;
+		};
+
+	public:
+		explicit EndedTransactions(MemoryPool& pool)
+			: m_entries(pool)
+		{}
+
+		void save(const PathName& database, const SortedArray<TraNumber>& transactions)
+		{
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			FB_SIZE_T pos;
+			Entry* const entry = find(database, pos) ? &m_entries[pos] : &m_entries.add();
+
+			entry->database = database;
+			entry->transactions.assign(transactions);
+		}
+
+		void load(const PathName& database, SortedArray<TraNumber>& transactions)
+		{
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			FB_SIZE_T pos;
+			if (find(database, pos))
+			{
+				transactions.assign(m_entries[pos].transactions);
+				m_entries.remove(pos);
+			}
+		}
+
+	private:
+		bool find(const PathName& database, FB_SIZE_T& pos) const
+		{
+			for (pos = 0; pos < m_entries.getCount(); pos++)
+			{
+				if (m_entries[pos].database == database)
+					return true;
+			}
+
+			return false;
+		}
+
+		ObjectsArray<Entry> m_entries;
+		Mutex m_mutex;
+	};
+
+	GlobalPtr<EndedTransactions> endedTransactions;
+
+	// Collect the primary, unique and foreign key indices of the relation
+
+	void getKeyIndices(thread_db* tdbb, jrd_rel* relation, HalfStaticArray<index_desc, 8>& indices)
+	{
+		RelationPages* const relPages = relation->getPages(tdbb);
+		auto page = relPages->rel_index_root;
+		if (!page)
+		{
+			DPM_scan_pages(tdbb);
+			page = relPages->rel_index_root;
+		}
+
+		const PageNumber root_page(relPages->rel_pg_space_id, page);
+		win window(root_page);
+		const auto root = (index_root_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_root);
+
+		index_desc idx;
+
+		for (USHORT i = 0; i < root->irt_count; i++)
+		{
+			if (BTR_description(tdbb, relation, root, &idx, i) &&
+				(idx.idx_flags & (idx_unique | idx_primary | idx_foreign)))
+			{
+				indices.add(idx);
+			}
+		}
+
+		CCH_RELEASE(tdbb, &window);
+	}
+}
+
+bool ParallelApplier::Slot::init(thread_db* tdbb)
+{
+	const auto owner = static_cast<ParallelApplier*>(m_task);
+	const auto status = tdbb->tdbb_status_vector;
+
+	if (!m_attStable)
+		m_attStable = WorkerAttachment::getAttachment(status, owner->m_dbb);
+
+	const auto attachment = m_attStable ? m_attStable->getHandle() : nullptr;
+
+	if (!attachment)
+	{
+		if (!status->hasData())
+			Arg::Gds(isc_bad_db_handle).copyTo(status);
+
+		return false;
+	}
+
+	tdbb->setDatabase(attachment->att_database);
+	tdbb->setAttachment(attachment);
+
+	if (!m_applier)
+	{
+		try
+		{
+			WorkerContextHolder holder(tdbb, FB_FUNCTION);
+			m_applier = Applier::createInternal(tdbb);
+		}
+		catch (const Exception& ex)
+		{
+			ex.stuffException(status);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void ParallelApplier::Slot::shutdown()
+{
+	if (!m_attStable)
+		return;
+
+	FbLocalStatus status;
+
+	if (m_applier)
+	{
+		Attachment* attachment = nullptr;
+		{
+			AttSyncLockGuard guard(*m_attStable->getSync(), FB_FUNCTION);
+			attachment = m_attStable->getHandle();
+		}
+
+		// If the attachment is already gone, our applier is gone as well
+
+		if (attachment)
+		{
+			BackgroundContextHolder tdbb(attachment->att_database, attachment, &status, FB_FUNCTION);
+
+			try
+			{
+				m_applier->shutdown(tdbb);
+			}
+			catch (const Exception& ex)
+			{
+				ex.stuffException(&status);
+			}
+		}
+
+		m_applier = nullptr;
+	}
+
+	WorkerAttachment::releaseAttachment(&status, m_attStable);
+	m_attStable = nullptr;
+}
+
+ParallelApplier::ParallelApplier(MemoryPool& pool, Applier* applier, unsigned workers)
+	: PermanentStorage(pool),
+	  m_applier(applier),
+	  m_dbb(applier->getAttachment()->att_database),
+	  m_coordinator(&pool),
+	  m_slots(pool),
+	  m_buffer(pool),
+	  m_queue(pool),
+	  m_txnMap(pool),
+	  m_keyMap(pool),
+	  m_ended(pool),
+	  m_skipped(pool),
+	  m_record(nullptr),
+	  m_firstPending(0),
+	  m_running(0),
+	  m_lastTicket(0),
+	  m_doneTicket(0),
+	  m_stop(false)
+{
+	for (unsigned i = 0; i < workers; i++)
+		m_slots.add(FB_NEW_POOL(pool) Slot(this));
+
+	endedTransactions->load(m_applier->m_database, m_skipped);
+}
+
+ParallelApplier::~ParallelApplier()
+{
+	for (auto slot : m_slots)
+		delete slot;
+
+	TransactionMap::Accessor txnAccessor(&m_txnMap);
+	if (txnAccessor.getFirst())
+	{
+		do {
+			delete txnAccessor.current()->second;
+		} while (txnAccessor.getNext());
+	}
+
+	delete m_record;
+}
+
+void ParallelApplier::process(thread_db* tdbb, ULONG length, const UCHAR* data)
+{
+	BlockReader reader(length, data);
+
+	if (reader.getFlags() & BLOCK_SYNC_POINT)
+	{
+		// The sender will never send again the transactions ended so far
+		flush(tdbb);
+		m_ended.clear();
+		return;
+	}
+
+	const auto traNum = reader.getTransactionId();
+
+	// Transactions ended before the failure of the previous flush
+	// are sent again, as the sender restarts from its last synchronization point
+
+	FB_SIZE_T pos;
+	if (traNum && m_skipped.find(traNum, pos))
+	{
+		if (reader.getFlags() & BLOCK_END_TRANS)
+			m_skipped.remove(pos);
+
+		return;
+	}
+
+	// Collect the keys of records being modified, they're used to detect
+	// the conflicts with transactions applied by other workers
+
+	ObjectsArray<string> keys(getPool());
+	bool isolate = false, cleanupAll = false;
+
+	while (!reader.isEof())
+	{
+		const auto op = reader.getTag();
+
+		switch (op)
+		{
+		case opStartTransaction:
+		case opPrepareTransaction:
+		case opCommitTransaction:
+		case opRollbackTransaction:
+		case opStartSavepoint:
+		case opReleaseSavepoint:
+		case opRollbackSavepoint:
+			break;
+
+		case opCleanupTransaction:
+			cleanupAll = true;
+			break;
+
+		case opInsertRecord:
+		case opDeleteRecord:
+			{
+				const auto relName = reader.getMetaName();
+				const ULONG recLength = reader.getInt32();
+				const auto record = reader.getBinary(recLength);
+				addKey(tdbb, relName, recLength, record, keys);
+			}
+			break;
+
+		case opUpdateRecord:
+			{
+				const auto relName = reader.getMetaName();
+				const ULONG orgLength = reader.getInt32();
+				const auto orgRecord = reader.getBinary(orgLength);
+				const ULONG newLength = reader.getInt32();
+				const auto newRecord = reader.getBinary(newLength);
+				addKey(tdbb, relName, orgLength, orgRecord, keys);
+				addKey(tdbb, relName, newLength, newRecord, keys);
+			}
+			break;
+
+		case opStoreBlob:
+			reader.getInt32();
+			reader.getInt32();
+			do {
+				const ULONG segLength = (USHORT) reader.getInt16();
+				if (!segLength)
+					break;
+				reader.getBinary(segLength);
+			} while (!reader.isEof());
+			break;
+
+		case opExecuteSql:
+		case opExecuteSqlIntl:
+			reader.getMetaName();
+			if (op == opExecuteSqlIntl)
+				reader.getByte();
+			reader.getString();
+			// DDL changes are applied isolated from other transactions
+			isolate = true;
+			break;
+
+		case opSetSequence:
+			reader.getMetaName();
+			reader.getInt64();
+			break;
+
+		case opDefineAtom:
+			reader.defineAtom();
+			break;
+
+		default:
+			fb_assert(false);
+		}
+	}
+
+	if (!traNum)
+	{
+		// Operations not bound to some transaction are applied by every worker,
+		// after all the preceding blocks and before the subsequent ones
+
+		flush(tdbb);
+
+		for (unsigned i = 0; i < m_slots.getCount(); i++)
+			enqueue(i, length, data, 0, 0, 0);
+
+		flush(tdbb);
+
+		if (cleanupAll)
+		{
+			// All transactions are rolled back by workers, forget them
+			for (auto& txn : m_txnMap)
+				txn.second->ticket = ++m_lastTicket;
+
+			m_doneTicket = m_lastTicket;
+			purge();
+		}
+
+		return;
+	}
+
+	if (isolate)
+		flush(tdbb);
+
+	Transaction* transaction = nullptr;
+
+	if (!m_txnMap.get(traNum, transaction))
+	{
+		// New transaction is bound to the least loaded worker
+		unsigned slot = 0;
+
+		for (unsigned i = 1; i < m_slots.getCount(); i++)
+		{
+			if (m_slots[i]->m_pending < m_slots[slot]->m_pending)
+				slot = i;
+		}
+
+		transaction = FB_NEW_POOL(getPool()) Transaction(getPool());
+		transaction->slot = slot;
+		m_txnMap.put(traNum, transaction);
+	}
+
+	// If some key was modified by another transaction which has already ended,
+	// this block must wait until that transaction is committed. Conflicts with
+	// active transactions are impossible, as the primary would block them too.
+
+	FB_UINT64 waitTicket = 0;
+
+	for (const auto& key : keys)
+	{
+		TraNumber owner;
+		if (m_keyMap.get(key, owner))
+		{
+			if (owner == traNum)
+				continue;
+
+			Transaction* other = nullptr;
+			if (m_txnMap.get(owner, other) && other->ticket > waitTicket)
+				waitTicket = other->ticket;
+		}
+
+		m_keyMap.put(key, traNum);
+		transaction->keys.add(key);
+	}
+
+	FB_UINT64 ticket = 0;
+
+	if (reader.getFlags() & BLOCK_END_TRANS)
+		ticket = transaction->ticket = ++m_lastTicket;
+
+	enqueue(transaction->slot, length, data, traNum, waitTicket, ticket);
+
+	if (isolate || m_buffer.getCount() >= MAX_QUEUE_SIZE)
+		flush(tdbb);
+}
+
+void ParallelApplier::flush(thread_db* tdbb)
+{
+	if (m_queue.isEmpty())
+		return;
+
+	m_firstPending = 0;
+	m_running = 0;
+	m_stop = false;
+	m_status.clear();
+
+	{	// scope
+		EngineCheckout cout(tdbb, FB_FUNCTION);
+		m_coordinator.runSync(this);
+	}
+
+	FbLocalStatus status;
+	const bool success = getResult(&status);
+
+	m_queue.clear();
+	m_buffer.clear();
+
+	for (auto slot : m_slots)
+		slot->m_pending = 0;
+
+	if (!success)
+	{
+		// The state of workers is unknown, so discard everything.
+		// The sender is expected to restart from its last synchronization point,
+		// so remember the transactions ended since then to skip them.
+
+		for (const auto traNum : m_ended)
+		{
+			if (!m_skipped.exist(traNum))
+				m_skipped.add(traNum);
+		}
+
+		m_ended.clear();
+		endedTransactions->save(m_applier->m_database, m_skipped);
+
+		cleanup();
+		status.raise();
+	}
+
+	purge();
+}
+
+void ParallelApplier::cleanup()
+{
+	// Worker appliers rollback their transactions while being shutdown
+	for (auto slot : m_slots)
+	{
+		slot->shutdown();
+		slot->m_pending = 0;
+	}
+
+	m_queue.clear();
+	m_buffer.clear();
+
+	for (auto& txn : m_txnMap)
+		txn.second->ticket = ++m_lastTicket;
+
+	m_doneTicket = m_lastTicket;
+	purge();
+	fb_assert(m_keyMap.count() == 0);
+
+	m_lastTicket = m_doneTicket = 0;
+}
+
+void ParallelApplier::enqueue(unsigned slot, ULONG length, const UCHAR* data, TraNumber traNum,
+							  FB_UINT64 waitTicket, FB_UINT64 ticket)
+{
+	QueuedBlock block;
+	block.offset = m_buffer.getCount();
+	block.length = length;
+	block.slot = slot;
+	block.traNum = traNum;
+	block.waitTicket = waitTicket;
+	block.ticket = ticket;
+	block.state = BLOCK_PENDING;
+
+	m_queue.add(block);
+	m_buffer.add(data, length);
+	m_slots[slot]->m_pending++;
+}
+
+void ParallelApplier::addKey(thread_db* tdbb, const MetaName& relName, ULONG length, const UCHAR* data,
+							 ObjectsArray<string>& keys)
+{
+	// Keys are the table name followed by the index ID and the value of every primary/unique key.
+	// Foreign key values are used as keys of the referenced index, so the changes of the master
+	// and detail records are serialized. If some key cannot be evaluated, the whole table is used
+	// as a key.
+
+	ObjectsArray<string> recordKeys(getPool());
+
+	try
+	{
+		const auto relation = MET_lookup_relation(tdbb, relName);
+
+		if (relation)
+		{
+			if (!(relation->rel_flags & REL_scanned))
+				MET_scan_relation(tdbb, relation);
+
+			HalfStaticArray<index_desc, 8> indices;
+			getKeyIndices(tdbb, relation, indices);
+
+			if (indices.hasData())
+			{
+				const auto format = m_applier->findFormat(tdbb, relation, length);
+
+				record_param rpb;
+				rpb.rpb_relation = relation;
+				rpb.rpb_record = m_record;
+
+				const auto record = m_record = VIO_record(tdbb, &rpb, format, &getPool());
+				record->copyDataFrom(data);
+
+				for (auto& idx : indices)
+				{
+					jrd_rel* keyRelation = relation;
+					USHORT keyId = idx.idx_id;
+
+					if (!(idx.idx_flags & (idx_unique | idx_primary)))
+					{
+						if (!MET_lookup_partner(tdbb, relation, &idx, 0) ||
+							!(keyRelation = MET_relation(tdbb, idx.idx_primary_relation)))
+						{
+							recordKeys.clear();
+							break;
+						}
+
+						keyId = idx.idx_primary_index;
+					}
+
+					// Unique key type is used for foreign keys too,
+					// to match the keys of the referenced index
+
+					IndexKey indexKey(tdbb, relation, &idx, INTL_KEY_UNIQUE, idx.idx_count);
+
+					if (indexKey.compose(record) != idx_e_ok)
+					{
+						recordKeys.clear();
+						break;
+					}
+
+					string& key = recordKeys.add();
+					key.assign(keyRelation->rel_name.c_str(), keyRelation->rel_name.length());
+					key += '\0';
+					key.append((const char*) &keyId, sizeof(keyId));
+					key.append((const char*) indexKey->key_data, indexKey->key_length);
+				}
+			}
+		}
+	}
+	catch (const Exception&)
+	{
+		// Errors are reported by the worker applying this block
+		CCH_unwind(tdbb, false);
+		fb_utils::init_status(tdbb->tdbb_status_vector);
+		recordKeys.clear();
+	}
+
+	if (recordKeys.isEmpty())
+	{
+		string& key = keys.add();
+		key.assign(relName.c_str(), relName.length());
+		key += '\0';
+		return;
+	}
+
+	for (const auto& key : recordKeys)
+		keys.add(key);
+}
+
+void ParallelApplier::purge()
+{
+	// Forget transactions which are already committed or rolled back, together with their keys
+
+	HalfStaticArray<TraNumber, 64> finished;
+
+	for (auto& txn : m_txnMap)
+	{
+		const auto transaction = txn.second;
+
+		if (!transaction->ticket || transaction->ticket > m_doneTicket)
+			continue;
+
+		for (const auto& key : transaction->keys)
+		{
+			TraNumber owner;
+			if (m_keyMap.get(key, owner) && owner == txn.first)
+				m_keyMap.remove(key);
+		}
+
+		finished.add(txn.first);
+		delete transaction;
+	}
+
+	for (const auto traNum : finished)
+		m_txnMap.remove(traNum);
+}
+
+bool ParallelApplier::handler(WorkItem& item)
+{
+	const auto slot = static_cast<Slot*>(&item);
+	const QueuedBlock& block = m_queue[slot->m_block];
+
+	FbLocalStatus status;
+	bool success = false;
+
+	{	// scope
+		ThreadContextHolder tdbb(&status);
+
+		if (slot->init(tdbb))
+		{
+			try
+			{
+				WorkerContextHolder holder(tdbb, FB_FUNCTION);
+				slot->m_applier->process(tdbb, block.length, m_buffer.begin() + block.offset);
+				success = true;
+			}
+			catch (const Exception& ex)
+			{
+				ex.stuffException(&status);
+			}
+		}
+	}
+
+	MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	m_queue[slot->m_block].state = BLOCK_DONE;
+	slot->m_busy = false;
+	m_running--;
+
+	if (success)
+	{
+		if (block.ticket)
+		{
+			m_doneTicket = block.ticket;
+			m_ended.add(block.traNum);
+		}
+	}
+	else
+	{
+		if (m_status.isSuccess())
+			m_status.save(&status);
+
+		m_stop = true;
+	}
+
+	m_condition.notifyAll();
+
+	return success;
+}
+
+bool ParallelApplier::getWorkItem(WorkItem** item)
+{
+	MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	HalfStaticArray<bool, 8> blocked;
+
+	while (!m_stop)
+	{
+		while (m_firstPending < m_queue.getCount() && m_queue[m_firstPending].state == BLOCK_DONE)
+			m_firstPending++;
+
+		if (m_firstPending == m_queue.getCount())
+			return false;
+
+		// Pick the first block which does not wait for anything. Every worker
+		// applies its blocks in the original order, and every block waits only
+		// for the preceding ones, so there's always something to do unless
+		// the blocks being waited for are being applied right now.
+
+		blocked.clear();
+		blocked.resize(m_slots.getCount(), false);
+
+		for (FB_SIZE_T i = m_firstPending; i < m_queue.getCount(); i++)
+		{
+			auto& block = m_queue[i];
+
+			if (block.state == BLOCK_DONE || blocked[block.slot])
+				continue;
+
+			blocked[block.slot] = true;
+
+			const auto slot = m_slots[block.slot];
+
+			if (block.state == BLOCK_RUNNING || slot->m_busy)
+				continue;
+
+			if (block.waitTicket > m_doneTicket)
+				continue;
+
+			if (block.ticket && block.ticket != m_doneTicket + 1)
+				continue;
+
+			block.state = BLOCK_RUNNING;
+			slot->m_busy = true;
+			slot->m_block = i;
+			m_running++;
+
+			*item = slot;
+			return true;
+		}
+
+		if (!m_running)
+		{
+			fb_assert(false);
+
+			FbLocalStatus status;
+			(Arg::Gds(isc_random) << Arg::Str("Replication queue cannot be processed")).copyTo(&status);
+			m_status.save(&status);
+			m_stop = true;
+			break;
+		}
+
+		m_condition.wait(m_mutex);
+	}
+
+	return false;
+}
+
+bool ParallelApplier::getResult(IStatus* status)
+{
+	if (status)
+	{
+		status->init();
+		status->setErrors(m_status.getErrors());
+	}
+
+	return m_status.isSuccess();
+}
+
+int ParallelApplier::getMaxWorkers()
+{
+	return (int) m_slots.getCount();
+}
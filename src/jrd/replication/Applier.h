@@ -26,6 +26,9 @@
 
 #include "../common/classes/array.h"
 #include "../common/classes/GenericMap.h"
+#include "../common/classes/condition.h"
+#include "../common/classes/objects_array.h"
+#include "../common/Task.h"
 #include "../jrd/jrd.h"
 #include "../jrd/tra.h"
 
@@ -33,8 +36,109 @@
 
 namespace Jrd
 {
+	class Applier;
+
+	// Applies the replication blocks of different transactions in parallel,
+	// using a few worker attachments. Blocks are queued until the sender
+	// requests a synchronization point, then the whole queue is processed.
+	// Every transaction is bound to a single worker, transactions which modify
+	// the same records (identified by relation and every primary/unique key)
+	// or records linked by a foreign key are serialized and all transactions
+	// are committed in their original order.
+
+	class ParallelApplier : public Firebird::Task, private Firebird::PermanentStorage
+	{
+		struct Transaction
+		{
+			explicit Transaction(Firebird::MemoryPool& pool)
+				: slot(0), ticket(0), keys(pool)
+			{}
+
+			unsigned slot;
+			FB_UINT64 ticket;
+			Firebird::ObjectsArray<Firebird::string> keys;
+		};
+
+		typedef Firebird::GenericMap<Firebird::Pair<Firebird::NonPooled<TraNumber, Transaction*> > > TransactionMap;
+		typedef Firebird::GenericMap<Firebird::Pair<Firebird::Left<Firebird::string, TraNumber> > > KeyMap;
+
+		enum BlockState { BLOCK_PENDING, BLOCK_RUNNING, BLOCK_DONE };
+
+		struct QueuedBlock
+		{
+			ULONG offset;
+			ULONG length;
+			unsigned slot;
+			TraNumber traNum;
+			FB_UINT64 waitTicket;	// ticket which must be applied before this block
+			FB_UINT64 ticket;		// commit order of the block ending the transaction
+			BlockState state;
+		};
+
+		class Slot : public Task::WorkItem
+		{
+		public:
+			explicit Slot(ParallelApplier* owner)
+				: Task::WorkItem(owner), m_applier(nullptr),
+				  m_block(0), m_pending(0), m_busy(false)
+			{}
+
+			bool init(thread_db* tdbb);
+			void shutdown();
+
+			Firebird::RefPtr<StableAttachmentPart> m_attStable;
+			Applier* m_applier;
+			FB_SIZE_T m_block;
+			ULONG m_pending;
+			bool m_busy;
+		};
+
+	public:
+		ParallelApplier(Firebird::MemoryPool& pool, Applier* applier, unsigned workers);
+		~ParallelApplier();
+
+		void process(thread_db* tdbb, ULONG length, const UCHAR* data);
+		void flush(thread_db* tdbb);
+		void cleanup();
+
+		// Task implementation
+		bool handler(WorkItem& item) override;
+		bool getWorkItem(WorkItem** item) override;
+		bool getResult(Firebird::IStatus* status) override;
+		int getMaxWorkers() override;
+
+	private:
+		void enqueue(unsigned slot, ULONG length, const UCHAR* data, TraNumber traNum,
+					 FB_UINT64 waitTicket, FB_UINT64 ticket);
+		void addKey(thread_db* tdbb, const MetaName& relName, ULONG length, const UCHAR* data,
+					Firebird::ObjectsArray<Firebird::string>& keys);
+		void purge();
+
+		Applier* const m_applier;
+		Database* const m_dbb;
+		Firebird::Coordinator m_coordinator;
+		Firebird::HalfStaticArray<Slot*, 8> m_slots;
+		Firebird::Array<UCHAR> m_buffer;
+		Firebird::Array<QueuedBlock> m_queue;
+		TransactionMap m_txnMap;
+		KeyMap m_keyMap;
+		Firebird::SortedArray<TraNumber> m_ended;		// transactions ended since the last synchronization point
+		Firebird::SortedArray<TraNumber> m_skipped;		// ended transactions which the sender may send again
+		Record* m_record;
+		FB_SIZE_T m_firstPending;
+		ULONG m_running;
+		FB_UINT64 m_lastTicket;
+		FB_UINT64 m_doneTicket;
+		Firebird::Mutex m_mutex;
+		Firebird::Condition m_condition;
+		Firebird::StatusHolder m_status;
+		bool m_stop;
+	};
+
 	class Applier : private Firebird::PermanentStorage
 	{
+		friend class ParallelApplier;
+
 		typedef Firebird::GenericMap<Firebird::Pair<Firebird::NonPooled<TraNumber, jrd_tra*> > > TransactionMap;
 		typedef Firebird::HalfStaticArray<bid, 16> BlobList;
 /*
@@ -155,6 +259,9 @@ namespace Jrd
 		Record* m_record = nullptr;
 		JReplicator* m_interface;
 		const bool m_enableCascade;
+		ParallelApplier* m_parallel = nullptr;
+
+		static Applier* createInternal(thread_db* tdbb);
 
 		void startTransaction(thread_db* tdbb, TraNumber traNum);
 		void prepareTransaction(thread_db* tdbb, TraNumber traNum);
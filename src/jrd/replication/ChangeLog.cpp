@@ -73,6 +73,8 @@ namespace
 
 	const unsigned COPY_BLOCK_SIZE = 64 * 1024; // 64 KB
 
+	const ULONG MIN_COMPRESS_LENGTH = 256;
+
 	const char* FILENAME_PATTERN = "%s.journal-%09" UQUADFORMAT;
 
 	const char* FILENAME_WILDCARD = "$(filename)";
@@ -132,11 +134,11 @@ ChangeLog::Segment::~Segment()
 		::close(m_handle);
 }
 
-void ChangeLog::Segment::init(FB_UINT64 sequence, const Guid& guid)
+void ChangeLog::Segment::init(FB_UINT64 sequence, const Guid& guid, USHORT version)
 {
 	fb_assert(sizeof(CHANGELOG_SIGNATURE) == sizeof(m_header->hdr_signature));
 	strcpy(m_header->hdr_signature, CHANGELOG_SIGNATURE);
-	m_header->hdr_version = CHANGELOG_CURRENT_VERSION;
+	m_header->hdr_version = version;
 	m_header->hdr_state = SEGMENT_STATE_USED;
 	guid.copyTo(m_header->hdr_guid);
 	m_header->hdr_sequence = sequence;
@@ -150,8 +152,11 @@ bool ChangeLog::Segment::validate(const Guid& guid) const
 	if (strcmp(m_header->hdr_signature, CHANGELOG_SIGNATURE))
 		return false;
 
-	if (m_header->hdr_version != CHANGELOG_CURRENT_VERSION)
+	if (m_header->hdr_version < CHANGELOG_VERSION_1 ||
+		m_header->hdr_version > CHANGELOG_CURRENT_VERSION)
+	{
 		return false;
+	}
 
 	if (m_header->hdr_state != SEGMENT_STATE_FREE &&
 		m_header->hdr_state != SEGMENT_STATE_USED &&
@@ -589,6 +594,20 @@ void ChangeLog::forceSwitch()
 
 FB_UINT64 ChangeLog::write(ULONG length, const UCHAR* data, bool sync)
 {
+	// Compress the block outside the lock, small blocks are not worth it
+
+	const ULONG orgLength = length;
+	const UCHAR* const orgData = data;
+
+	UCharBuffer packed;
+	if (m_config->journalCompression && length >= MIN_COMPRESS_LENGTH &&
+		compressBlock(m_config->journalCompression, m_config->journalCompressionLevel,
+					  length, data, packed))
+	{
+		length = packed.getCount();
+		data = packed.begin();
+	}
+
 	LockGuard guard(this);
 
 	auto segment = getSegment(length);
@@ -614,6 +633,19 @@ FB_UINT64 ChangeLog::write(ULONG length, const UCHAR* data, bool sync)
 	if (!segment)
 		raiseError("Out of available space in journal segments");
 
+	// Segment created before compression was enabled cannot contain compressed blocks,
+	// so the original block is requested and appended then
+	if (segment->getVersion() < CHANGELOG_VERSION_2 && data != orgData)
+	{
+		length = orgLength;
+		data = orgData;
+
+		segment = getSegment(length);
+
+		if (!segment)
+			raiseError("Out of available space in journal segments");
+	}
+
 	const auto state = m_sharedMemory->getHeader();
 
 	if (segment->isEmpty())
@@ -953,7 +985,12 @@ ChangeLog::Segment* ChangeLog::createSegment()
 
 	const auto segment = FB_NEW_POOL(getPool()) Segment(getPool(), filename, fd);
 
-	segment->init(sequence, m_guid);
+	// Replicas which are not aware of compressed blocks may still read
+	// the journal unless compression is enabled
+	const USHORT version = m_config->journalCompression ?
+		CHANGELOG_VERSION_2 : CHANGELOG_VERSION_1;
+
+	segment->init(sequence, m_guid, version);
 	segment->addRef();
 
 	m_segments.add(segment);
@@ -1014,7 +1051,10 @@ ChangeLog::Segment* ChangeLog::reuseSegment(ChangeLog::Segment* segment)
 
 	segment = FB_NEW_POOL(getPool()) Segment(getPool(), newname, fd);
 
-	segment->init(sequence, m_guid);
+	const USHORT version = m_config->journalCompression ?
+		CHANGELOG_VERSION_2 : CHANGELOG_VERSION_1;
+
+	segment->init(sequence, m_guid, version);
 	segment->addRef();
 
 	m_segments.add(segment);
@@ -28,6 +28,7 @@
 #include "../common/StatusArg.h"
 #include "../jrd/constants.h"
 
+#include "Protocol.h"
 #include "Utils.h"
 #include "Config.h"
 
@@ -58,6 +59,9 @@ namespace
 	const ULONG DEFAULT_GROUP_FLUSH_DELAY = 0;
 	const ULONG DEFAULT_APPLY_IDLE_TIMEOUT = 10;				// seconds
 	const ULONG DEFAULT_APPLY_ERROR_TIMEOUT = 60;				// seconds
+	const ULONG DEFAULT_APPLY_PARALLELISM = 1;
+	const ULONG DEFAULT_COMPRESSION_LEVEL = 6;
+	const ULONG MAX_COMPRESSION_LEVEL = 9;
 
 	void parseLong(const string& input, ULONG& output)
 	{
@@ -117,11 +121,14 @@ Config::Config()
 	  archiveDirectory(getPool()),
 	  archiveCommand(getPool()),
 	  archiveTimeout(DEFAULT_ARCHIVE_TIMEOUT),
+	  journalCompression(0),
+	  journalCompressionLevel(DEFAULT_COMPRESSION_LEVEL),
 	  syncReplicas(getPool()),
 	  sourceDirectory(getPool()),
 	  verboseLogging(false),
 	  applyIdleTimeout(DEFAULT_APPLY_IDLE_TIMEOUT),
 	  applyErrorTimeout(DEFAULT_APPLY_ERROR_TIMEOUT),
+	  applyParallelism(DEFAULT_APPLY_PARALLELISM),
 	  pluginName(getPool()),
 	  logErrors(true),
 	  reportErrors(false),
@@ -143,11 +150,14 @@ Config::Config(const Config& other)
 	  archiveDirectory(getPool(), other.archiveDirectory),
 	  archiveCommand(getPool(), other.archiveCommand),
 	  archiveTimeout(other.archiveTimeout),
+	  journalCompression(other.journalCompression),
+	  journalCompressionLevel(other.journalCompressionLevel),
 	  syncReplicas(getPool(), other.syncReplicas),
 	  sourceDirectory(getPool(), other.sourceDirectory),
 	  verboseLogging(other.verboseLogging),
 	  applyIdleTimeout(other.applyIdleTimeout),
 	  applyErrorTimeout(other.applyErrorTimeout),
+	  applyParallelism(other.applyParallelism),
 	  pluginName(getPool(), other.pluginName),
 	  logErrors(other.logErrors),
 	  reportErrors(other.reportErrors),
@@ -268,6 +278,27 @@ Config* Config::get(const PathName& lookupName)
 				{
 					parseLong(value, config->archiveTimeout);
 				}
+				else if (key == "journal_compression")
+				{
+					string method(value);
+					method.upper();
+
+					if (method == "NONE")
+						config->journalCompression = 0;
+					else if (method == "LZ4")
+						config->journalCompression = BLOCK_COMPRESSED_LZ4;
+					else if (method == "ZLIB")
+						config->journalCompression = BLOCK_COMPRESSED_ZLIB;
+					else
+						configError("unknown compression method", key, value);
+				}
+				else if (key == "journal_compression_level")
+				{
+					parseLong(value, config->journalCompressionLevel);
+
+					if (config->journalCompressionLevel > MAX_COMPRESSION_LEVEL)
+						configError("invalid compression level", key, value);
+				}
 				else if (key == "plugin")
 				{
 					config->pluginName = value;
@@ -405,6 +436,10 @@ void Config::enumerate(ReplicaList& replicas)
 				{
 					parseLong(value, config->applyErrorTimeout);
 				}
+				else if (key == "apply_parallelism")
+				{
+					parseLong(value, config->applyParallelism);
+				}
 			}
 
 			if (dbName.hasData() && config->sourceDirectory.hasData())
@@ -55,12 +55,15 @@ namespace Replication
 		Firebird::PathName archiveDirectory;
 		Firebird::string archiveCommand;
 		ULONG archiveTimeout;
+		USHORT journalCompression;
+		ULONG journalCompressionLevel;
 		Firebird::ObjectsArray<Firebird::string> syncReplicas;
 		Firebird::PathName sourceDirectory;
 		std::optional<Firebird::Guid> sourceGuid;
 		bool verboseLogging;
 		ULONG applyIdleTimeout;
 		ULONG applyErrorTimeout;
+		ULONG applyParallelism;
 		Firebird::string pluginName;
 		bool logErrors;
 		bool reportErrors;
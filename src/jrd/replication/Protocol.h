@@ -34,6 +34,21 @@ namespace Replication
 	const USHORT BLOCK_BEGIN_TRANS	= 0x0001;
 	const USHORT BLOCK_END_TRANS	= 0x0002;
 
+	// Block without data marking the synchronization point: all blocks sent
+	// before it must be applied when it's processed. Such points are sent only
+	// by the senders which allow the blocks to be applied in parallel.
+	const USHORT BLOCK_SYNC_POINT	= 0x0004;
+
+	// Block data stored in the journal may be compressed. Such data starts
+	// with its original length (4 bytes) followed by the compressed bytes.
+	const USHORT BLOCK_COMPRESSED_LZ4	= 0x0010;
+	const USHORT BLOCK_COMPRESSED_ZLIB	= 0x0020;
+	const USHORT BLOCK_COMPRESSED		= BLOCK_COMPRESSED_LZ4 | BLOCK_COMPRESSED_ZLIB;
+
+	// Original length of the compressed data cannot exceed the maximum
+	// compression ratio of the supported methods (deflate has the largest one)
+	const ULONG MAX_COMPRESSION_RATIO = 1032;
+
 	struct Block
 	{
 		FB_UINT64 traNumber;
@@ -22,6 +22,9 @@
 
 #include "firebird.h"
 #include "../common/classes/GenericMap.h"
+#include "../common/classes/init.h"
+#include "../common/classes/Lz4.h"
+#include "../common/classes/zip.h"
 #include "../common/config/config_file.h"
 #include "../common/isc_proto.h"
 #include "../common/isc_f_proto.h"
@@ -31,6 +34,7 @@
 #include "../common/os/path_utils.h"
 #include "../jrd/constants.h"
 
+#include "Protocol.h"
 #include "Utils.h"
 
 #ifdef HAVE_UNISTD_H
@@ -71,6 +75,10 @@ namespace
 
 	const char* REPLICATION_LOGFILE = "replication.log";
 
+#ifdef HAVE_ZLIB_H
+	InitInstance<ZLib> zlib;
+#endif
+
 	class LogWriter : private GlobalStorage
 	{
 	public:
@@ -291,4 +299,138 @@ namespace Replication
 		logMessage(REPLICA_SIDE, VERBOSE_MSG, database, message);
 	}
 
+	bool compressBlock(USHORT method, ULONG level,
+					   ULONG length, const UCHAR* data,
+					   UCharBuffer& output)
+	{
+		// Compressed block must be smaller than the original one,
+		// otherwise it's stored as is
+
+		fb_assert(length >= sizeof(Block));
+		fb_assert(method == BLOCK_COMPRESSED_LZ4 || method == BLOCK_COMPRESSED_ZLIB);
+
+		const ULONG rawLength = length - sizeof(Block);
+		const auto rawData = data + sizeof(Block);
+
+		if (rawLength <= sizeof(ULONG))
+			return false;
+
+		const ULONG capacity = rawLength - sizeof(ULONG) - 1;
+		const ULONG prefix = sizeof(Block) + sizeof(ULONG);
+		const auto ptr = output.getBuffer(prefix + capacity);
+
+		ULONG packedLength = 0;
+
+		if (method == BLOCK_COMPRESSED_LZ4)
+			packedLength = Lz4::compress(rawData, rawLength, ptr + prefix, capacity);
+#ifdef HAVE_ZLIB_H
+		else if (zlib())
+		{
+			z_stream strm;
+			memset(&strm, 0, sizeof(strm));
+			strm.zalloc = ZLib::allocFunc;
+			strm.zfree = ZLib::freeFunc;
+
+			if (zlib().deflateInit(&strm, (int) level) != Z_OK)
+				return false;
+
+			strm.next_in = const_cast<UCHAR*>(rawData);
+			strm.avail_in = rawLength;
+			strm.next_out = ptr + prefix;
+			strm.avail_out = capacity;
+
+			if (zlib().deflate(&strm, Z_FINISH) == Z_STREAM_END)
+				packedLength = capacity - strm.avail_out;
+
+			zlib().deflateEnd(&strm);
+		}
+#endif
+
+		if (!packedLength)
+			return false;
+
+		memcpy(ptr, data, sizeof(Block));
+		const auto header = (Block*) ptr;
+		header->flags |= method;
+		header->length = sizeof(ULONG) + packedLength;
+		memcpy(ptr + sizeof(Block), &rawLength, sizeof(ULONG));
+
+		output.shrink(prefix + packedLength);
+		return true;
+	}
+
+	ULONG decompressBlock(ULONG length, const UCHAR* data, UCharBuffer& output)
+	{
+		fb_assert(length >= sizeof(Block));
+
+		Block header;
+		memcpy(&header, data, sizeof(Block));
+
+		const ULONG packedLength = length - sizeof(Block);
+
+		if (packedLength < sizeof(ULONG))
+			raiseError("Compressed replication block is corrupted");
+
+		ULONG rawLength;
+		memcpy(&rawLength, data + sizeof(Block), sizeof(ULONG));
+
+		// Original length comes from the block itself, so validate it before allocating the buffer
+
+		const FB_UINT64 maxLength = (FB_UINT64) (packedLength - sizeof(ULONG)) * MAX_COMPRESSION_RATIO;
+
+		if (!rawLength || rawLength > maxLength || rawLength > MAX_ULONG - sizeof(Block))
+			raiseError("Compressed replication block is corrupted");
+
+		const auto packedData = data + sizeof(Block) + sizeof(ULONG);
+		const auto ptr = output.getBuffer(sizeof(Block) + rawLength);
+		ULONG resultLength = 0;
+
+		if (header.flags & BLOCK_COMPRESSED_LZ4)
+		{
+			if (!Lz4::decompress(packedData, packedLength - sizeof(ULONG),
+								 ptr + sizeof(Block), rawLength, &resultLength))
+			{
+				raiseError("Compressed replication block is corrupted");
+			}
+		}
+		else
+		{
+#ifdef HAVE_ZLIB_H
+			if (!zlib())
+				raiseError("Compressed replication block cannot be decoded, zlib is not available");
+
+			z_stream strm;
+			memset(&strm, 0, sizeof(strm));
+			strm.zalloc = ZLib::allocFunc;
+			strm.zfree = ZLib::freeFunc;
+
+			if (zlib().inflateInit(&strm) != Z_OK)
+				raiseError("Cannot initialize zlib decompressor");
+
+			strm.next_in = const_cast<UCHAR*>(packedData);
+			strm.avail_in = packedLength - sizeof(ULONG);
+			strm.next_out = ptr + sizeof(Block);
+			strm.avail_out = rawLength;
+
+			const int ret = zlib().inflate(&strm, Z_FINISH);
+			resultLength = rawLength - strm.avail_out;
+			zlib().inflateEnd(&strm);
+
+			if (ret != Z_STREAM_END)
+				raiseError("Compressed replication block is corrupted");
+#else
+			raiseError("Compressed replication block cannot be decoded, zlib is not available");
+#endif
+		}
+
+		if (resultLength != rawLength)
+			raiseError("Compressed replication block is corrupted");
+
+		header.flags &= ~BLOCK_COMPRESSED;
+		header.length = rawLength;
+		memcpy(ptr, &header, sizeof(Block));
+
+		return sizeof(Block) + rawLength;
+	}
+
 } // namespace
@@ -179,6 +179,9 @@ Sort::Sort(Database* dbb,
  *		  compared. This is used at creation of unique index since sort key
  *		  includes index key (which must be unique) and record numbers.
  *
+ * If max_records is not zero, only that number of first records is
+ * going to be fetched and the rest of them may be discarded early.
+ *
  **************************************/
 	fb_assert(m_owner);
 	fb_assert(unique_keys <= keys);
@@ -362,21 +365,26 @@ void Sort::put(thread_db* tdbb, ULONG** record_address)
 		if ((UCHAR*) record < m_memory + m_longs ||
 			(UCHAR*) NEXT_RECORD(record) <= (UCHAR*) (m_next_pointer + 1))
 		{
-			putRun(tdbb);
-			while (true)
+			if (!truncateBuffer(tdbb))
 			{
-				run_control* run = m_runs;
-				const USHORT depth = run->run_depth;
-				if (depth == MAX_MERGE_LEVEL)
-					break;
-				USHORT count = 1;
-				while ((run = run->run_next) && run->run_depth == depth)
-					count++;
-				if (count < RUN_GROUP)
-					break;
-				mergeRuns(count);
+				RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_SORT_SPILL);
+
+				putRun(tdbb);
+				while (true)
+				{
+					run_control* run = m_runs;
+					const USHORT depth = run->run_depth;
+					if (depth == MAX_MERGE_LEVEL)
+						break;
+					USHORT count = 1;
+					while ((run = run->run_next) && run->run_depth == depth)
+						count++;
+					if (count < RUN_GROUP)
+						break;
+					mergeRuns(count);
+				}
+				init();
 			}
-			init();
 			record = m_last_record;
 		}
 
@@ -438,6 +446,8 @@ void Sort::sort(thread_db* tdbb)
 
 		// Write the last records as a run_control
 
+		RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_SORT_SPILL);
+
 		putRun(tdbb);
 
 		CHECK_FILE(NULL);
@@ -1964,6 +1974,10 @@ void Sort::orderAndSave(thread_db* tdbb)
 	// m_next_pointer points to the end of pointer memory or the beginning of records
 	while (ptr < m_next_pointer)
 	{
+		// Records after the first m_max_records are never fetched, don't save them
+		if (m_max_records && run->run_records == m_max_records)
+			break;
+
 		// If the next pointer is null, it's record has been eliminated as a
 		// duplicate.  This is the only easy case.
 		if (!(*ptr++))
@@ -1972,6 +1986,8 @@ void Sort::orderAndSave(thread_db* tdbb)
 		run->run_records++;
 	}
 
+	sort_record** const end_pointer = ptr;
+
 	const ULONG key_length = (m_longs - SIZEOF_SR_BCKPTR_IN_LONGS) * sizeof(ULONG);
 	run->run_size = run->run_records * key_length;
 	run->run_seek = m_space->allocateSpace(run->run_size);
@@ -1981,7 +1997,7 @@ void Sort::orderAndSave(thread_db* tdbb)
 	if (mem)
 	{
 		ptr = m_first_pointer + 1;
-		while (ptr < m_next_pointer)
+		while (ptr < end_pointer)
 		{
 			SR* record = (SR*) (*ptr++);
 
@@ -2134,6 +2150,58 @@ void Sort::sortBuffer(thread_db* tdbb)
 }
 
 
+bool Sort::truncateBuffer(thread_db* tdbb)
+{
+/**************************************
+ *
+ * Memory has been exhausted, but the caller needs only the first
+ * m_max_records records. If they fit into a half of the memory, sort
+ * the buffer and keep just them instead of writing the run. This way
+ * the sort never spills to the scratch file and its memory is reused
+ * again and again, making it a bounded top-N sort.
+ *
+ **************************************/
+	const ULONG record_size = (m_longs << SHIFTLONG) + sizeof(sort_record*);
+
+	if (!m_max_records || m_max_records > m_size_memory / record_size / 2)
+		return false;
+
+	sortBuffer(tdbb);
+
+	// Save the first records (already diddled) aside
+
+	const ULONG length = m_longs - SIZEOF_SR_BCKPTR_IN_LONGS;
+
+	HalfStaticArray<SORTP, 1024> kept_buffer(m_owner->getPool());
+	SORTP* const kept = kept_buffer.getBuffer(m_max_records * length);
+	ULONG count = 0;
+
+	for (sort_record** ptr = m_first_pointer + 1; ptr < m_next_pointer && count < m_max_records; ptr++)
+	{
+		// Null pointer means record eliminated as a duplicate
+		if (*ptr)
+			memcpy(kept + count++ * length, *ptr, length << SHIFTLONG);
+	}
+
+	// And put them back into the empty buffer
+
+	init();
+
+	for (ULONG i = 0; i < count; i++)
+	{
+		SR* const record = NEXT_RECORD(m_last_record);
+		m_last_record = record;
+		record->sr_bckptr = m_next_pointer;
+		*m_next_pointer++ = reinterpret_cast<sort_record*>(record->sr_sort_record.sort_record_key);
+		memcpy(record->sr_sort_record.sort_record_key, kept + i * length, length << SHIFTLONG);
+	}
+
+	m_records = count;
+
+	return true;
+}
+
+
 void Sort::sortRunsBySeek(int n)
 {
 /**************************************
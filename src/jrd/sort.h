@@ -320,6 +320,7 @@ private:
 	void putRun(Jrd::thread_db*);
 	void sortBuffer(Jrd::thread_db*);
 	void sortRunsBySeek(int);
+	bool truncateBuffer(Jrd::thread_db*);
 
 #ifdef DEV_BUILD
 	void checkFile(const run_control*);
@@ -339,7 +340,7 @@ private:
 	ULONG m_key_length;							// Key length
 	ULONG m_unique_length;						// Unique key length, used when duplicates eliminated
 	FB_UINT64 m_records;						// Number of records
-	FB_UINT64 m_max_records;					// Maximum number of records to store, assigned but unused.
+	FB_UINT64 m_max_records;					// Number of first records needed by caller, zero if all
 	TempSpace* m_space;							// temporary space for scratch file
 	run_control* m_runs;						// ALLOC: Run on scratch file, if any
 	merge_control* m_merge;						// Top level merge block
@@ -0,0 +1,87 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../jrd/jrd.h"
+#include "../jrd/ext.h"
+#include "../jrd/ext_proto.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(ExternalFileSuite)
+
+
+BOOST_AUTO_TEST_SUITE(ExternalFileTests)
+
+BOOST_AUTO_TEST_CASE(ParseFormatTest)
+{
+	UCHAR delimiter;
+	USHORT flags;
+	string canonical;
+
+	BOOST_TEST(EXT_parse_format("fixed", delimiter, flags, &canonical));
+	BOOST_TEST(delimiter == 0);
+	BOOST_TEST(flags == 0);
+	BOOST_TEST((canonical == "FIXED"));
+
+	BOOST_TEST(EXT_parse_format("CSV", delimiter, flags, &canonical));
+	BOOST_TEST(delimiter == ',');
+	BOOST_TEST(flags == 0);
+	BOOST_TEST((canonical == "CSV"));
+
+	BOOST_TEST(EXT_parse_format("  tsv\theader ", delimiter, flags, &canonical));
+	BOOST_TEST(delimiter == '\t');
+	BOOST_TEST(flags == EXT_header);
+	BOOST_TEST((canonical == "TSV HEADER"));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidFormatTest)
+{
+	UCHAR delimiter;
+	USHORT flags;
+
+	BOOST_TEST(!EXT_parse_format("", delimiter, flags));
+	BOOST_TEST(!EXT_parse_format("json", delimiter, flags));
+	BOOST_TEST(!EXT_parse_format("fixed header", delimiter, flags));
+	BOOST_TEST(!EXT_parse_format("csv header header", delimiter, flags));
+	BOOST_TEST(!EXT_parse_format("csv footer", delimiter, flags));
+}
+
+BOOST_AUTO_TEST_CASE(FindEolTest)
+{
+	ULONG eol;
+
+	const char plain[] = "1,abc\n2,def\n";
+	BOOST_TEST(EXT_find_eol((const UCHAR*) plain, sizeof(plain) - 1, ',', eol));
+	BOOST_TEST(eol == 5u);
+
+	// Line feed inside the quoted value belongs to the record
+	const char quoted[] = "1,\"a\nb\",c\n";
+	BOOST_TEST(EXT_find_eol((const UCHAR*) quoted, sizeof(quoted) - 1, ',', eol));
+	BOOST_TEST(eol == 9u);
+
+	// Doubled quote inside the quoted value
+	const char doubled[] = "\"a\"\"\nb\"\n";
+	BOOST_TEST(EXT_find_eol((const UCHAR*) doubled, sizeof(doubled) - 1, ',', eol));
+	BOOST_TEST(eol == 7u);
+
+	// Quote inside the unquoted value is just a character
+	const char embedded[] = "1,12\" ruler,3\n2,\"x\"\n";
+	BOOST_TEST(EXT_find_eol((const UCHAR*) embedded, sizeof(embedded) - 1, ',', eol));
+	BOOST_TEST(eol == 13u);
+
+	const char tabbed[] = "12\" ruler\t\"a\tb\"\n";
+	BOOST_TEST(EXT_find_eol((const UCHAR*) tabbed, sizeof(tabbed) - 1, '\t', eol));
+	BOOST_TEST(eol == 15u);
+
+	// Record is not complete
+	const char partial[] = "1,\"abc\ndef";
+	BOOST_TEST(!EXT_find_eol((const UCHAR*) partial, sizeof(partial) - 1, ',', eol));
+	BOOST_TEST(eol == sizeof(partial) - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// ExternalFileTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// ExternalFileSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
@@ -0,0 +1,90 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../jrd/jrd.h"
+#include "../jrd/Attachment.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(GeneratorRangeSuite)
+
+
+BOOST_AUTO_TEST_SUITE(GeneratorRangeTests)
+
+BOOST_AUTO_TEST_CASE(AllocationTest)
+{
+	Attachment::GeneratorRangeMap ranges(*getDefaultMemoryPool());
+	SINT64 value;
+
+	BOOST_TEST(!ranges.getValue(1, 1, value));
+
+	// The sequence was advanced from 0 to 10 by the reservation of 10 values
+	BOOST_TEST(ranges.putRange(1, 10, 1, 10) == 1);
+
+	for (SINT64 expected = 2; expected <= 10; expected++)
+	{
+		BOOST_TEST(ranges.getValue(1, 1, value));
+		BOOST_TEST(value == expected);
+	}
+
+	// The range is exhausted
+	BOOST_TEST(!ranges.getValue(1, 1, value));
+
+	const Attachment::GeneratorRange* const range = ranges.get(1);
+	BOOST_TEST(range->count == 0);
+	BOOST_TEST(range->last == 10);
+
+	// The next reservation replaces the range
+	BOOST_TEST(ranges.putRange(1, 20, 1, 10) == 11);
+	BOOST_TEST(ranges.getValue(1, 1, value));
+	BOOST_TEST(value == 12);
+
+	// Ranges of other sequences are independent
+	BOOST_TEST(!ranges.getValue(2, 1, value));
+}
+
+BOOST_AUTO_TEST_CASE(StepTest)
+{
+	Attachment::GeneratorRangeMap ranges(*getDefaultMemoryPool());
+	SINT64 value;
+
+	// Negative increment, the sequence was advanced from 100 to 85
+	BOOST_TEST(ranges.putRange(1, 85, -5, 3) == 95);
+
+	BOOST_TEST(ranges.getValue(1, -5, value));
+	BOOST_TEST(value == 90);
+
+	// Values reserved with another increment are not used
+	BOOST_TEST(!ranges.getValue(1, 5, value));
+
+	BOOST_TEST(ranges.getValue(1, -5, value));
+	BOOST_TEST(value == 85);
+	BOOST_TEST(!ranges.getValue(1, -5, value));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidationTest)
+{
+	Attachment::GeneratorRangeMap ranges(*getDefaultMemoryPool());
+	SINT64 value;
+
+	BOOST_TEST(ranges.putRange(1, 100, 1, 100) == 1);
+	BOOST_TEST(ranges.putRange(2, 50, 10, 5) == 10);
+
+	// Changed sequence discards the ranges of all sequences
+	ranges.clear();
+
+	BOOST_TEST(!ranges.getValue(1, 1, value));
+	BOOST_TEST(!ranges.getValue(2, 10, value));
+
+	// Values are reserved from the new sequence value
+	BOOST_TEST(ranges.putRange(1, 1010, 1, 10) == 1001);
+	BOOST_TEST(ranges.getValue(1, 1, value));
+	BOOST_TEST(value == 1002);
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// GeneratorRangeTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// GeneratorRangeSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
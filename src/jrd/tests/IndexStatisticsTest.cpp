@@ -0,0 +1,315 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../jrd/jrd.h"
+#include "../jrd/btr.h"
+#include "../jrd/ods.h"
+#include <cmath>
+
+using namespace Firebird;
+using namespace Jrd;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(IndexStatisticsSuite)
+
+
+BOOST_AUTO_TEST_SUITE(IndexStatisticsTests)
+
+static void addEntry(Array<IndexStatistics::Entry>& entries, FB_UINT64 count, UCHAR value)
+{
+	IndexStatistics::Entry& entry = entries.add();
+	entry.count = count;
+	entry.length = 1;
+	entry.data[0] = value;
+}
+
+static temporary_key* makeKey(temporary_key& key, UCHAR value)
+{
+	key.key_length = 1;
+	key.key_data[0] = value;
+	return &key;
+}
+
+// 1000 keys with 100 distinct values 0..99, value 50 is repeated 300 times
+static void fill(IndexStatistics& statistics)
+{
+	statistics.selectivity = 0.01f;
+	statistics.keys = 1000;
+	statistics.distinct = 100;
+
+	for (unsigned i = 0; i < 10; i++)
+		addEntry(statistics.bounds, i * 100, (UCHAR) (i * 10));
+
+	addEntry(statistics.bounds, 999, 99);
+	addEntry(statistics.values, 300, 50);
+}
+
+BOOST_AUTO_TEST_CASE(SaveLoadTest)
+{
+	IndexStatistics original(*getDefaultMemoryPool());
+	fill(original);
+
+	UCharBuffer buffer;
+	original.save(buffer);
+
+	IndexStatistics loaded(*getDefaultMemoryPool());
+	loaded.load(buffer.begin(), buffer.getCount());
+
+	BOOST_TEST(loaded.hasData());
+	BOOST_TEST(loaded.selectivity == original.selectivity);
+	BOOST_TEST(loaded.keys == original.keys);
+	BOOST_TEST(loaded.distinct == original.distinct);
+	BOOST_TEST(loaded.bounds.getCount() == original.bounds.getCount());
+	BOOST_TEST(loaded.values.getCount() == 1u);
+	BOOST_TEST(loaded.values[0].count == 300u);
+	BOOST_TEST(loaded.values[0].data[0] == 50);
+
+	// Garbage is ignored
+	const UCHAR garbage[] = {1, 2, 3};
+	loaded.load(garbage, sizeof(garbage));
+	BOOST_TEST(!loaded.hasData());
+}
+
+BOOST_AUTO_TEST_CASE(EqualSelectivityTest)
+{
+	IndexStatistics statistics(*getDefaultMemoryPool());
+	fill(statistics);
+
+	temporary_key key;
+
+	double selectivity = 0;
+
+	// Most common value
+	BOOST_TEST(statistics.getEqualSelectivity(makeKey(key, 50), selectivity));
+	BOOST_TEST(selectivity == 0.3);
+
+	// Other values share the rest of keys
+	BOOST_TEST(statistics.getEqualSelectivity(makeKey(key, 51), selectivity));
+	BOOST_TEST(selectivity == 700.0 / 99 / 1000);
+
+	// Values outside the histogram are left to the default estimation
+	BOOST_TEST(!statistics.getEqualSelectivity(makeKey(key, 200), selectivity));
+
+	statistics.bounds[0].data[0] = 5;
+	BOOST_TEST(!statistics.getEqualSelectivity(makeKey(key, 1), selectivity));
+}
+
+BOOST_AUTO_TEST_CASE(RangeSelectivityTest)
+{
+	IndexStatistics statistics(*getDefaultMemoryPool());
+	fill(statistics);
+
+	temporary_key lower, upper;
+
+	double selectivity = 0;
+
+	// Between bounds
+	BOOST_TEST(statistics.getRangeSelectivity(makeKey(lower, 20), makeKey(upper, 40), selectivity));
+	BOOST_TEST(selectivity > 0.2);
+	BOOST_TEST(selectivity < 0.25);
+
+	// Inside a single bucket
+	BOOST_TEST(statistics.getRangeSelectivity(makeKey(lower, 21), makeKey(upper, 28), selectivity));
+	BOOST_TEST(selectivity < 0.05);
+
+	// Open ranges
+	BOOST_TEST(statistics.getRangeSelectivity(makeKey(lower, 90), nullptr, selectivity));
+	BOOST_TEST(selectivity == 0.1);
+
+	BOOST_TEST(statistics.getRangeSelectivity(nullptr, makeKey(upper, 200), selectivity));
+	BOOST_TEST(selectivity == 1.0);
+
+	// Range partially outside the histogram
+	BOOST_TEST(statistics.getRangeSelectivity(makeKey(lower, 90), makeKey(upper, 200), selectivity));
+	BOOST_TEST(selectivity == 0.1);
+
+	// Ranges outside the histogram are left to the default estimation
+	BOOST_TEST(!statistics.getRangeSelectivity(makeKey(lower, 150), nullptr, selectivity));
+	BOOST_TEST(!statistics.getRangeSelectivity(makeKey(lower, 150), makeKey(upper, 200), selectivity));
+
+	statistics.bounds[0].data[0] = 5;
+	BOOST_TEST(!statistics.getRangeSelectivity(nullptr, makeKey(upper, 1), selectivity));
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// IndexStatisticsTests
+
+
+BOOST_AUTO_TEST_SUITE(DistributionCollectorTests)
+
+static const temporary_key& makeKey(temporary_key& key, USHORT value)
+{
+	key.key_length = 2;
+	key.key_data[0] = (UCHAR) (value >> 8);
+	key.key_data[1] = (UCHAR) value;
+	return key;
+}
+
+static USHORT getValue(const IndexStatistics::Entry& entry)
+{
+	return (entry.data[0] << 8) | entry.data[1];
+}
+
+BOOST_AUTO_TEST_CASE(SamplingTest)
+{
+	const unsigned KEYS = 10000;
+
+	DistributionCollector collector(*getDefaultMemoryPool(), 1, false);
+	temporary_key key;
+
+	for (unsigned i = 0; i < KEYS; i++)
+	{
+		collector.add(makeKey(key, i));
+		BOOST_TEST(collector.getSampleCount() <= DistributionCollector::MAX_SAMPLES);
+	}
+
+	// Samples were thinned out a few times
+	const FB_UINT64 stride = collector.getStride();
+	BOOST_TEST(stride > 1u);
+	BOOST_TEST(!(stride & (stride - 1)));
+	BOOST_TEST(collector.getSampleCount() * stride >= KEYS);
+
+	IndexStatistics statistics(*getDefaultMemoryPool());
+	collector.finish(statistics);
+
+	BOOST_TEST(statistics.keys == KEYS);
+	BOOST_TEST(statistics.distinct == KEYS);
+	BOOST_TEST(statistics.values.isEmpty());
+
+	// Bounds are spread evenly and include the lowest and highest keys
+	const auto& bounds = statistics.bounds;
+	BOOST_TEST(bounds.getCount() == IndexStatistics::HISTOGRAM_BUCKETS + 1);
+	BOOST_TEST(bounds.front().count == 0u);
+	BOOST_TEST(bounds.back().count == KEYS - 1);
+
+	for (FB_SIZE_T i = 0; i < bounds.getCount(); i++)
+	{
+		// Every bound is the key at its position
+		BOOST_TEST(getValue(bounds[i]) == bounds[i].count);
+
+		if (i < IndexStatistics::HISTOGRAM_BUCKETS)
+		{
+			const double target = (double) (KEYS - 1) * i / IndexStatistics::HISTOGRAM_BUCKETS;
+			BOOST_TEST(std::fabs(bounds[i].count - target) <= stride);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(FewKeysTest)
+{
+	DistributionCollector collector(*getDefaultMemoryPool(), 1, false);
+	temporary_key key;
+
+	for (unsigned i = 0; i < 10; i++)
+		collector.add(makeKey(key, i));
+
+	BOOST_TEST(collector.getStride() == 1u);
+	BOOST_TEST(collector.getSampleCount() == 10u);
+
+	IndexStatistics statistics(*getDefaultMemoryPool());
+	collector.finish(statistics);
+
+	// Every key becomes a bound
+	BOOST_TEST(statistics.bounds.getCount() == 10u);
+
+	for (FB_SIZE_T i = 0; i < statistics.bounds.getCount(); i++)
+		BOOST_TEST(statistics.bounds[i].count == i);
+
+	// No keys, no distribution
+	DistributionCollector empty(*getDefaultMemoryPool(), 1, false);
+	empty.finish(statistics);
+	BOOST_TEST(!statistics.hasData());
+	BOOST_TEST(statistics.bounds.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(CommonValuesTest)
+{
+	DistributionCollector collector(*getDefaultMemoryPool(), 1, false);
+	temporary_key key;
+
+	// Values 0..19 are repeated 2..21 times, followed by 1000 unique values
+	USHORT value = 0;
+	FB_UINT64 keys = 0;
+
+	for (; value < 20; value++)
+	{
+		for (unsigned i = 0; i < value + 2u; i++, keys++)
+			collector.add(makeKey(key, value));
+	}
+
+	for (; value < 1020; value++, keys++)
+		collector.add(makeKey(key, value));
+
+	IndexStatistics statistics(*getDefaultMemoryPool());
+	collector.finish(statistics);
+
+	BOOST_TEST(statistics.keys == keys);
+	BOOST_TEST(statistics.distinct == 1020u);
+
+	// Only the most repeated runs are kept
+	BOOST_TEST(statistics.values.getCount() == IndexStatistics::MCV_COUNT);
+
+	for (const auto& entry : statistics.values)
+	{
+		BOOST_TEST(getValue(entry) >= 20u - IndexStatistics::MCV_COUNT);
+		BOOST_TEST(entry.count == getValue(entry) + 2u);
+	}
+
+	// The most common value is estimated by its run
+	double selectivity = 0;
+	BOOST_TEST(statistics.getEqualSelectivity(&makeKey(key, 19), selectivity));
+	BOOST_TEST(selectivity == 21.0 / keys);
+}
+
+BOOST_AUTO_TEST_CASE(LeadingLengthTest)
+{
+	// Every group of the compound key starts with the segment marker,
+	// the leading segment of two is marked with 2 (or 253 if descending)
+	const UCHAR data[] = {2, 'a', 'b', 'c', 'd', 2, 'e', 0, 0, 0, 1, 'x', 0, 0, 0};
+
+	temporary_key key;
+	key.key_length = sizeof(data);
+	memcpy(key.key_data, data, sizeof(data));
+
+	DistributionCollector single(*getDefaultMemoryPool(), 1, false);
+	BOOST_TEST(single.getLeadingLength(key) == sizeof(data));
+
+	DistributionCollector ascending(*getDefaultMemoryPool(), 2, false);
+	BOOST_TEST(ascending.getLeadingLength(key) == 2u * (Ods::STUFF_COUNT + 1));
+
+	// Truncated key
+	key.key_length = 7;
+	BOOST_TEST(ascending.getLeadingLength(key) == 7u);
+
+	// Leading segment is NULL
+	key.key_length = 0;
+	BOOST_TEST(ascending.getLeadingLength(key) == 0u);
+
+	DistributionCollector descending(*getDefaultMemoryPool(), 2, true);
+	key.key_length = sizeof(data);
+	BOOST_TEST(descending.getLeadingLength(key) == 0u);
+
+	for (FB_SIZE_T i = 0; i < sizeof(data); i += Ods::STUFF_COUNT + 1)
+		key.key_data[i] = 255 - key.key_data[i];
+
+	BOOST_TEST(descending.getLeadingLength(key) == 2u * (Ods::STUFF_COUNT + 1));
+
+	// Keys differing in the second segment only are the same leading value
+	for (UCHAR second = 'x'; second <= 'z'; second++)
+	{
+		memcpy(key.key_data, data, sizeof(data));
+		key.key_data[11] = second;
+		ascending.add(key);
+	}
+
+	IndexStatistics statistics(*getDefaultMemoryPool());
+	ascending.finish(statistics);
+
+	BOOST_TEST(statistics.keys == 3u);
+	BOOST_TEST(statistics.distinct == 1u);
+	BOOST_TEST(statistics.values.getCount() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// DistributionCollectorTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// IndexStatisticsSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
@@ -0,0 +1,167 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../jrd/trace/TraceRingBuffer.h"
+#include "../jrd/trace/TraceBinaryLog.h"
+#include <thread>
+#include <vector>
+
+using namespace Firebird;
+using namespace Jrd;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(TraceSuite)
+
+
+BOOST_AUTO_TEST_SUITE(TraceRingBufferTests)
+
+BOOST_AUTO_TEST_CASE(PutAndGetTest)
+{
+	TraceRingBuffer ring(*getDefaultMemoryPool(), 64);
+	Array<UCHAR> buffer;
+	UCHAR* const data = buffer.getBuffer(ring.getSize());
+
+	BOOST_TEST(ring.put("abc", 3));
+	BOOST_TEST(ring.put("defgh", 5));
+	BOOST_TEST(ring.get(data) == 8u);
+	BOOST_TEST(memcmp(data, "abcdefgh", 8) == 0);
+	BOOST_TEST(ring.get(data) == 0u);
+
+	// Records wrap around the end of buffer
+	for (unsigned i = 0; i < 10; i++)
+	{
+		BOOST_TEST(ring.put("0123456789abcdefghij", 20));
+		BOOST_TEST(ring.get(data) == 20u);
+		BOOST_TEST(memcmp(data, "0123456789abcdefghij", 20) == 0);
+	}
+
+	// No space left
+	BOOST_TEST(ring.put("0123456789abcdefghijklmnopqrstu", 31));
+	BOOST_TEST(ring.put("0123456789abcdefghijklmnopqrstu", 31) == false);
+	BOOST_TEST(ring.get(data) == 31u);
+	BOOST_TEST(ring.getUsed() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentPutTest)
+{
+	const unsigned THREADS = 4;
+	const unsigned RECORDS = 20000;
+
+	TraceRingBuffer ring(*getDefaultMemoryPool(), 4096);
+	Array<UCHAR> buffer;
+	UCHAR* const data = buffer.getBuffer(ring.getSize());
+
+	std::vector<std::thread> producers;
+	for (unsigned t = 0; t < THREADS; t++)
+	{
+		producers.emplace_back([&ring, t]() {
+			for (ULONG i = 0; i < RECORDS; i++)
+			{
+				const ULONG record[2] = {t, i};
+				while (!ring.put(record, sizeof(record)))
+					std::this_thread::yield();
+			}
+		});
+	}
+
+	// Records of every producer should come in order and nothing is lost
+	ULONG expected[THREADS] = {0};
+	unsigned total = 0;
+
+	while (total < THREADS * RECORDS)
+	{
+		const ULONG length = ring.get(data);
+		BOOST_REQUIRE(length % (2 * sizeof(ULONG)) == 0);
+
+		for (const ULONG* p = (ULONG*) data; p < (ULONG*) (data + length); p += 2)
+		{
+			BOOST_REQUIRE(p[0] < THREADS);
+			BOOST_REQUIRE(p[1] == expected[p[0]]);
+			++expected[p[0]];
+			++total;
+		}
+	}
+
+	for (auto& producer : producers)
+		producer.join();
+
+	BOOST_TEST(ring.get(data) == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// TraceRingBufferTests
+
+
+BOOST_AUTO_TEST_SUITE(TraceBinaryDecoderTests)
+
+BOOST_AUTO_TEST_CASE(DecodeTest)
+{
+	const char* const action = "EXECUTE_STATEMENT_FINISH";
+	const char* const text = "\tstatement text";
+
+	TraceBinaryHeader header;
+	header.actionLength = (USHORT) strlen(action);
+	header.length = TraceBinaryHeader::SIZE + header.actionLength + strlen(text);
+	header.timestamp.timestamp_date = 0;		// 1858-11-17
+	header.timestamp.timestamp_time = 36001234;	// 01:00:00.1234
+	header.processId = 123;
+	header.objectId = 0;
+
+	Array<UCHAR> stream;
+	stream.add((const UCHAR*) "text\n", 5);
+	UCHAR* const p = stream.getBuffer(stream.getCount() + header.length) + 5;
+	header.put(p);
+	memcpy(p + TraceBinaryHeader::SIZE, action, header.actionLength);
+	memcpy(p + TraceBinaryHeader::SIZE + header.actionLength, text, strlen(text));
+	stream.add((const UCHAR*) "tail", 4);
+
+	// Feed the stream by small pieces to check reassembling of records
+	TraceBinaryDecoder decoder(*getDefaultMemoryPool());
+	string output;
+
+	for (FB_SIZE_T pos = 0; pos < stream.getCount(); pos += 7)
+		decoder.decode(stream.begin() + pos, MIN(7, stream.getCount() - pos), output);
+
+	BOOST_TEST(!decoder.hasPending());
+	BOOST_TEST(output.find("text\n1858-11-17T01:00:00.1234 (123:") == 0u);
+	BOOST_TEST(output.find(") EXECUTE_STATEMENT_FINISH") != string::npos);
+	BOOST_TEST(output.find("\tstatement text") != string::npos);
+	BOOST_TEST(output.find("tail") == output.length() - 4);
+}
+
+BOOST_AUTO_TEST_CASE(ResyncTest)
+{
+	const char* const action = "ATTACH_DATABASE";
+
+	TraceBinaryHeader header;
+	header.actionLength = (USHORT) strlen(action);
+	header.length = TraceBinaryHeader::SIZE + header.actionLength;
+	header.timestamp.timestamp_date = 0;
+	header.timestamp.timestamp_time = 0;
+	header.processId = 1;
+	header.objectId = 0;
+
+	UCHAR record[TraceBinaryHeader::SIZE + 32];
+	header.put(record);
+	memcpy(record + TraceBinaryHeader::SIZE, action, header.actionLength);
+
+	// Stray zero byte, record with a corrupted version and a valid record
+	Array<UCHAR> stream;
+	stream.add((const UCHAR*) "a\0b", 3);
+	stream.add(record, header.length);
+	stream[3 + TraceBinaryHeader::MARKER_SIZE] = TraceBinaryHeader::VERSION + 1;
+	stream.add(record, header.length);
+
+	TraceBinaryDecoder decoder(*getDefaultMemoryPool());
+	string output;
+	decoder.decode(stream.begin(), stream.getCount(), output);
+
+	BOOST_TEST(!decoder.hasPending());
+	BOOST_TEST(output.find("ab") == 0u);
+	BOOST_TEST(output.find("1858-11-17T00:00:00.0000 (1:") != string::npos);
+	BOOST_TEST(output.find(") ATTACH_DATABASE") == output.rfind(") ATTACH_DATABASE"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// TraceBinaryDecoderTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// TraceSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
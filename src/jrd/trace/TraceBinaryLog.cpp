@@ -0,0 +1,107 @@
+/*
+ *	PROGRAM:	Firebird Trace Services
+ *	MODULE:		TraceBinaryLog.cpp
+ *	DESCRIPTION:	Binary trace log records
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include <string.h>
+
+#include "../../common/classes/timestamp.h"
+#include "../../jrd/trace/TraceBinaryLog.h"
+
+using namespace Firebird;
+
+#ifdef WIN_NT
+#define NEWLINE "\r\n"
+#else
+#define NEWLINE "\n"
+#endif
+
+namespace Jrd {
+
+void TraceBinaryDecoder::decode(const void* data, FB_SIZE_T length, string& output)
+{
+	const UCHAR* p = static_cast<const UCHAR*>(data);
+	const bool continued = m_pending.hasData();
+
+	if (continued)
+	{
+		m_pending.add(p, length);
+		p = m_pending.begin();
+		length = m_pending.getCount();
+	}
+
+	FB_SIZE_T pos = 0;
+	while (pos < length)
+	{
+		if (p[pos] != TraceBinaryHeader::SIGNATURE)
+		{
+			// Pass the text up to the next binary record as is
+			const void* next = memchr(p + pos, TraceBinaryHeader::SIGNATURE, length - pos);
+			const FB_SIZE_T textLength = next ?
+				static_cast<const UCHAR*>(next) - (p + pos) : length - pos;
+
+			output.append(reinterpret_cast<const char*>(p + pos), textLength);
+			pos += textLength;
+			continue;
+		}
+
+		TraceBinaryHeader header;
+		const auto status = header.get(p + pos, length - pos);
+
+		if (status == TraceBinaryHeader::HEADER_INVALID)
+		{
+			// Not a record or a corrupted one, look for the next marker
+			pos++;
+			continue;
+		}
+
+		if (status == TraceBinaryHeader::HEADER_INCOMPLETE || length - pos < header.length)
+			break;
+
+		decodeRecord(header, p + pos, output);
+		pos += header.length;
+	}
+
+	if (continued)
+		m_pending.removeCount(0, pos);
+	else
+		m_pending.add(p + pos, length - pos);
+}
+
+void TraceBinaryDecoder::decodeRecord(const TraceBinaryHeader& header, const UCHAR* data, string& output)
+{
+	struct tm times;
+	TimeStamp(header.timestamp).decode(&times);
+
+	const char* const action = reinterpret_cast<const char*>(data + TraceBinaryHeader::SIZE);
+	const char* const text = action + header.actionLength;
+
+	string line;
+	line.printf("%04d-%02d-%02dT%02d:%02d:%02d.%04d (%u:%p) %.*s" NEWLINE,
+		times.tm_year + 1900, times.tm_mon + 1, times.tm_mday, times.tm_hour,
+		times.tm_min, times.tm_sec, (int) (header.timestamp.timestamp_time % ISC_TIME_SECONDS_PRECISION),
+		header.processId, (void*) (IPTR) header.objectId, (int) header.actionLength, action);
+
+	output.append(line);
+	output.append(text, header.length - TraceBinaryHeader::SIZE - header.actionLength);
+	output.append(NEWLINE);
+}
+
+} // namespace Jrd
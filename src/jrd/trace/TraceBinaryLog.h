@@ -0,0 +1,139 @@
+/*
+ *	PROGRAM:	Firebird Trace Services
+ *	MODULE:		TraceBinaryLog.h
+ *	DESCRIPTION:	Binary trace log records
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#ifndef TRACE_BINARY_LOG
+#define TRACE_BINARY_LOG
+
+#include "../../common/classes/fb_string.h"
+#include "../../common/classes/array.h"
+
+namespace Jrd {
+
+// Trace plugin with log_format = binary writes every event as a single record
+// with fixed header followed by the action name and event text. Header fields
+// are stored little-endian, so records may be decoded on another host.
+// Header starts with the marker which first byte is zero and thus never appears
+// in the text trace output, it allows to mix text and binary records in the same
+// stream. Decoder skips the data which doesn't look like a valid header and
+// resynchronizes on the next marker.
+
+struct TraceBinaryHeader
+{
+	static const UCHAR SIGNATURE = 0;			// first byte of the marker
+	static const ULONG MARKER = 0x54424600;		// "\0FBT" when stored
+	static const UCHAR VERSION = 1;
+	static const FB_SIZE_T MARKER_SIZE = 4;
+	static const FB_SIZE_T SIZE = 31;
+	static const ULONG MAX_LENGTH = 16 * 1024 * 1024;
+
+	enum Status { HEADER_INVALID, HEADER_INCOMPLETE, HEADER_VALID };
+
+	ULONG length;			// whole record, including header
+	USHORT actionLength;
+	ISC_TIMESTAMP timestamp;
+	ULONG processId;
+	FB_UINT64 objectId;		// trace plugin instance
+
+	void put(UCHAR* p) const
+	{
+		p = putInt(p, MARKER, MARKER_SIZE);
+		*p++ = VERSION;
+		p = putInt(p, actionLength, sizeof(actionLength));
+		p = putInt(p, length, sizeof(length));
+		p = putInt(p, (ULONG) timestamp.timestamp_date, sizeof(ULONG));
+		p = putInt(p, timestamp.timestamp_time, sizeof(ULONG));
+		p = putInt(p, processId, sizeof(processId));
+		putInt(p, objectId, sizeof(objectId));
+	}
+
+	// Data may be shorter than the header, then only its available part is checked
+	Status get(const UCHAR* p, FB_SIZE_T available)
+	{
+		UCHAR marker[MARKER_SIZE + 1];
+		putInt(marker, MARKER, MARKER_SIZE);
+		marker[MARKER_SIZE] = VERSION;
+
+		if (memcmp(p, marker, MIN(available, sizeof(marker))))
+			return HEADER_INVALID;
+
+		if (available < SIZE)
+			return HEADER_INCOMPLETE;
+
+		p += sizeof(marker);
+		actionLength = (USHORT) getInt(p, sizeof(actionLength));
+		length = (ULONG) getInt(p, sizeof(length));
+		timestamp.timestamp_date = (ISC_DATE) (ULONG) getInt(p, sizeof(ULONG));
+		timestamp.timestamp_time = (ISC_TIME) getInt(p, sizeof(ULONG));
+		processId = (ULONG) getInt(p, sizeof(processId));
+		objectId = getInt(p, sizeof(objectId));
+
+		return (length >= SIZE + actionLength && length <= MAX_LENGTH) ? HEADER_VALID : HEADER_INVALID;
+	}
+
+private:
+	static UCHAR* putInt(UCHAR* p, FB_UINT64 value, unsigned size)
+	{
+		for (unsigned i = 0; i < size; i++, value >>= 8)
+			*p++ = (UCHAR) value;
+
+		return p;
+	}
+
+	static FB_UINT64 getInt(const UCHAR*& p, unsigned size)
+	{
+		FB_UINT64 value = 0;
+		for (unsigned i = 0; i < size; i++)
+			value |= ((FB_UINT64) *p++) << (i * 8);
+
+		return value;
+	}
+};
+
+
+// Converts the mix of text and binary records back into the text trace output.
+// Input could be fed by arbitrary pieces, incomplete record is kept until the
+// rest of it arrives.
+
+class TraceBinaryDecoder
+{
+public:
+	explicit TraceBinaryDecoder(Firebird::MemoryPool& pool)
+		: m_pending(pool)
+	{}
+
+	// Append decoded text to the output, corrupted records are skipped
+	void decode(const void* data, FB_SIZE_T length, Firebird::string& output);
+
+	// True if the input stopped in the middle of the binary record
+	bool hasPending() const
+	{
+		return m_pending.hasData();
+	}
+
+private:
+	void decodeRecord(const TraceBinaryHeader& header, const UCHAR* data, Firebird::string& output);
+
+	Firebird::HalfStaticArray<UCHAR, 1024> m_pending;
+};
+
+} // namespace Jrd
+
+#endif // TRACE_BINARY_LOG
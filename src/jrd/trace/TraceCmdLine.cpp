@@ -35,6 +35,9 @@
 #include "../common/classes/Switches.h"
 #include "../../jrd/trace/traceswi.h"
 #include "../../jrd/trace/TraceService.h"
+#include "../../jrd/trace/TraceBinaryLog.h"
+#include "../../common/classes/auto.h"
+#include "../../common/os/os_utils.h"
 #include "../common/classes/MsgPrint.h"
 #include "../common/classes/ClumpletReader.h"
 #include "../jrd/license.h"
@@ -94,23 +97,64 @@ namespace
 
 		// If the items aren't contiguous, a scheme like in nbackup.cpp will have to be used.
 		// ASF: This is message codes!
-		const int MAIN_USAGE[] = {3, 21};
+		const int MAIN_USAGE[] = {3, 11};
+		const int DECODE_USAGE = 41;
+		const int PARAM_USAGE[] = {12, 21};
 		const int EXAMPLES[] = {22, 27};
+		const int DECODE_EXAMPLE = 42;
 		const int NOTES[] = {28, 29};
 
 		for (int i = MAIN_USAGE[0]; i <= MAIN_USAGE[1]; ++i)
 			printMsg(i);
 
+		printMsg(DECODE_USAGE);
+
+		for (int i = PARAM_USAGE[0]; i <= PARAM_USAGE[1]; ++i)
+			printMsg(i);
+
 		printf("\n");
 		for (int i = EXAMPLES[0]; i <= EXAMPLES[1]; ++i)
 			printMsg(i);
 
+		printMsg(DECODE_EXAMPLE);
+
 		printf("\n");
 		for (int i = NOTES[0]; i <= NOTES[1]; ++i)
 			printMsg(i);
 
 		exit(FINI_ERROR);
 	}
+
+	// Print the binary trace log file as text
+	void decodeFile(const PathName& fileName)
+	{
+		AutoPtr<FILE> file(os_utils::fopen(fileName.c_str(), "rb"));
+		if (!file)
+		{
+			(Arg::Gds(isc_io_error) << Arg::Str("fopen") << Arg::Str(fileName) <<
+				Arg::Gds(isc_io_open_err) << Arg::OsError()).raise();
+		}
+
+		Jrd::TraceBinaryDecoder decoder(*getDefaultMemoryPool());
+		string text;
+		char buffer[BUFFER_XLARGE];
+
+		size_t length;
+		while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		{
+			decoder.decode(buffer, length, text);
+			fwrite(text.c_str(), 1, text.length(), stdout);
+			text.erase();
+		}
+
+		if (ferror(file))
+		{
+			(Arg::Gds(isc_io_error) << Arg::Str("fread") << Arg::Str(fileName) <<
+				Arg::Gds(isc_io_read_err) << Arg::OsError()).raise();
+		}
+
+		// Incomplete record at the end of file is still being written, ignore it
+	}
 }
 
 
@@ -129,6 +173,7 @@ void fbtrace(UtilSvc* uSvc, TraceSvcIntf* traceSvc)
 								false, true);
 
 	const Switches::in_sw_tab_t* action_sw = NULL;
+	PathName decodeName;
 	for (int itr = 1; itr < argc; ++itr)
 	{
 		if (!uSvc->isService() && strcmp(argv[itr], "-?") == 0)
@@ -153,6 +198,20 @@ void fbtrace(UtilSvc* uSvc, TraceSvcIntf* traceSvc)
 				action_sw = sw;
 
 			argv[itr] = NULL;
+
+			if (sw->in_sw == IN_SW_TRACE_DECODE)
+			{
+				if (uSvc->isService())
+					usage(uSvc, isc_trace_switch_user_only, sw->in_sw_name);
+
+				itr++;
+				if (itr < argc && argv[itr])
+					decodeName = argv[itr];
+				else
+					usage(uSvc, isc_trace_param_val_miss, sw->in_sw_name);
+
+				argv[itr] = NULL;
+			}
 		}
 	}
 
@@ -195,6 +254,7 @@ void fbtrace(UtilSvc* uSvc, TraceSvcIntf* traceSvc)
 				case IN_SW_TRACE_SUSPEND:
 				case IN_SW_TRACE_RESUME:
 				case IN_SW_TRACE_LIST:
+				case IN_SW_TRACE_DECODE:
 					usage(uSvc, isc_trace_param_act_notcompat, sw->in_sw_name, action_sw->in_sw_name);
 					break;
 			}
@@ -216,6 +276,7 @@ void fbtrace(UtilSvc* uSvc, TraceSvcIntf* traceSvc)
 				case IN_SW_TRACE_SUSPEND:
 				case IN_SW_TRACE_RESUME:
 				case IN_SW_TRACE_LIST:
+				case IN_SW_TRACE_DECODE:
 					usage(uSvc, isc_trace_param_act_notcompat, sw->in_sw_name, action_sw->in_sw_name);
 					break;
 			}
@@ -235,6 +296,7 @@ void fbtrace(UtilSvc* uSvc, TraceSvcIntf* traceSvc)
 			{
 				case IN_SW_TRACE_START:
 				case IN_SW_TRACE_LIST:
+				case IN_SW_TRACE_DECODE:
 					usage(uSvc, isc_trace_param_act_notcompat, sw->in_sw_name, action_sw->in_sw_name);
 					break;
 			}
@@ -372,6 +434,13 @@ void fbtrace(UtilSvc* uSvc, TraceSvcIntf* traceSvc)
 		}
 	}
 
+	// decoding of the log file doesn't need the service
+	if (action_sw->in_sw == IN_SW_TRACE_DECODE)
+	{
+		decodeFile(decodeName);
+		return;
+	}
+
 	// validate missed action's parameters and perform action
 	if (!uSvc->isService() && svc_name.isEmpty()) {
 		usage(uSvc, isc_trace_mandatory_switch_miss, "SERVICE");
@@ -32,6 +32,10 @@
 #include "../../jrd/trace/TraceManager.h"
 #include "../../jrd/trace/TraceLog.h"
 #include "../../jrd/trace/TraceObjects.h"
+#include "../../jrd/trace/TraceBinaryLog.h"
+#include "../../jrd/trace/TraceRingBuffer.h"
+#include "../../common/ThreadStart.h"
+#include "../../common/classes/semaphore.h"
 #include "../../common/isc_proto.h"
 #include "../../common/isc_s_proto.h"
 #include "../../jrd/jrd.h"
@@ -477,29 +481,233 @@ void TraceDscFromMsg::fillParams()
 
 /// TraceLogWriterImpl
 
+class TraceLogQueue;
+
 class TraceLogWriterImpl final :
 	public RefCntIface<ITraceLogWriterImpl<TraceLogWriterImpl, CheckStatusWrapper> >
 {
 public:
 	TraceLogWriterImpl(const TraceSession& session) :
 		m_log(getPool(), session.ses_logfile, false),
-		m_sesId(session.ses_id)
+		m_logFile(getPool(), session.ses_logfile),
+		m_sesId(session.ses_id),
+		m_queue(NULL)
 	{
 		string s;
 		s.printf("\n--- Session %d is suspended as its log is full ---\n", session.ses_id);
 		m_log.setFullMsg(s.c_str());
 	}
 
+	~TraceLogWriterImpl();
+
 	// TraceLogWriter implementation
 	FB_SIZE_T write(const void* buf, FB_SIZE_T size);
 	FB_SIZE_T write_s(CheckStatusWrapper* status, const void* buf, FB_SIZE_T size);
 
+	// Write into the shared log bypassing the queue
+	FB_SIZE_T writeLog(const void* buf, FB_SIZE_T size);
+
 private:
 	TraceLog m_log;
+	const PathName m_logFile;
 	ULONG m_sesId;
+	TraceLogQueue* m_queue;
 };
 
+
+/// TraceLogQueue
+
+// Binary trace records written by all attachments of the current process are
+// put into the lock-free ring buffer and moved into the shared log by the
+// dedicated thread, thus traced attachments don't contend for the log mutex.
+// There is one queue per trace session in a process.
+
+const ULONG TRACE_QUEUE_SIZE = 1024 * 1024;	// 1MB, the same as initial log size
+const int TRACE_QUEUE_FLUSH_INTERVAL = 100;	// ms
+
+class TraceLogQueue
+{
+public:
+	static TraceLogQueue* attach(ULONG sesId, const PathName& logFile);
+	static void detach(TraceLogQueue* queue);
+
+	void put(const void* buf, FB_SIZE_T size);
+
+	void exceptionHandler(const Exception& ex, ThreadFinishSync<TraceLogQueue*>::ThreadRoutine*);
+
+private:
+	TraceLogQueue(MemoryPool& pool, ULONG sesId, const PathName& logFile);
+	~TraceLogQueue();
+
+	static void flushThread(TraceLogQueue* queue)
+	{
+		queue->flushThread();
+	}
+
+	void flushThread();
+	void flush(UCHAR* buffer);
+
+	RefPtr<TraceLogWriterImpl> m_writer;
+	TraceRingBuffer m_ring;
+	Semaphore m_wakeup;
+	ThreadFinishSync<TraceLogQueue*> m_cleanupSync;
+	std::atomic<ULONG> m_lost;
+	const ULONG m_sesId;
+	ULONG m_users;			// guarded by queuesMutex
+	bool m_exiting;
+};
+
+namespace
+{
+	GlobalPtr<Mutex> queuesMutex;
+	GlobalPtr<Array<TraceLogQueue*> > queues;
+}
+
+TraceLogQueue::TraceLogQueue(MemoryPool& pool, ULONG sesId, const PathName& logFile)
+	: m_ring(pool, TRACE_QUEUE_SIZE),
+	  m_cleanupSync(pool, flushThread, THREAD_medium),
+	  m_lost(0),
+	  m_sesId(sesId),
+	  m_users(1),
+	  m_exiting(false)
+{
+	TraceSession session(pool);
+	session.ses_id = sesId;
+	session.ses_logfile = logFile;
+
+	m_writer.assignRefNoIncr(FB_NEW TraceLogWriterImpl(session));
+
+	m_cleanupSync.run(this);
+}
+
+TraceLogQueue::~TraceLogQueue()
+{
+	m_exiting = true;
+	m_wakeup.release();
+	m_cleanupSync.waitForCompletion();
+}
+
+TraceLogQueue* TraceLogQueue::attach(ULONG sesId, const PathName& logFile)
+{
+	MutexLockGuard guard(queuesMutex, FB_FUNCTION);
+
+	for (auto iter = queues->begin(); iter != queues->end(); ++iter)
+	{
+		const auto queue = *iter;
+
+		if (queue->m_sesId == sesId)
+		{
+			queue->m_users++;
+			return queue;
+		}
+	}
+
+	const auto queue = FB_NEW_POOL(*getDefaultMemoryPool())
+		TraceLogQueue(*getDefaultMemoryPool(), sesId, logFile);
+	queues->add(queue);
+
+	return queue;
+}
+
+void TraceLogQueue::detach(TraceLogQueue* queue)
+{
+	{	// scope
+		MutexLockGuard guard(queuesMutex, FB_FUNCTION);
+
+		if (--queue->m_users)
+			return;
+
+		FB_SIZE_T pos;
+		if (queues->find(queue, pos))
+			queues->remove(pos);
+	}
+
+	// Flush the rest of records and stop the thread
+	delete queue;
+}
+
+void TraceLogQueue::put(const void* buf, FB_SIZE_T size)
+{
+	if (!m_ring.put(buf, size))
+	{
+		++m_lost;
+		return;
+	}
+
+	// Don't wait for the next flush if the queue is half full already
+	if (m_ring.getUsed() > m_ring.getSize() / 2)
+		m_wakeup.release();
+}
+
+void TraceLogQueue::flushThread()
+{
+	HalfStaticArray<UCHAR, BUFFER_TINY> buffer;
+	UCHAR* const data = buffer.getBuffer(m_ring.getSize());
+
+	while (true)
+	{
+		// Records put before exit flag is set must be flushed
+		const bool exiting = m_exiting;
+
+		try
+		{
+			flush(data);
+		}
+		catch (const Exception& ex)
+		{
+			iscLogException("TraceLogQueue: cannot write into the trace log", ex);
+		}
+
+		if (exiting)
+			break;
+
+		m_wakeup.tryEnter(0, TRACE_QUEUE_FLUSH_INTERVAL);
+	}
+}
+
+void TraceLogQueue::flush(UCHAR* buffer)
+{
+	ULONG length;
+	while ((length = m_ring.get(buffer)))
+		m_writer->writeLog(buffer, length);
+
+	const ULONG lost = m_lost.exchange(0);
+	if (lost)
+	{
+		string s;
+		s.printf("\n--- %u records of session %u are lost as the trace queue is full ---\n",
+			lost, m_sesId);
+		m_writer->writeLog(s.c_str(), s.length());
+	}
+}
+
+void TraceLogQueue::exceptionHandler(const Exception& ex, ThreadFinishSync<TraceLogQueue*>::ThreadRoutine*)
+{
+	iscLogException("Error closing trace log queue thread\n", ex);
+}
+
+
+TraceLogWriterImpl::~TraceLogWriterImpl()
+{
+	if (m_queue)
+		TraceLogQueue::detach(m_queue);
+}
+
 FB_SIZE_T TraceLogWriterImpl::write(const void* buf, FB_SIZE_T size)
+{
+	if (size && *static_cast<const UCHAR*>(buf) == TraceBinaryHeader::SIGNATURE)
+	{
+		if (!m_queue)
+			m_queue = TraceLogQueue::attach(m_sesId, m_logFile);
+
+		m_queue->put(buf, size);
+		return size;
+	}
+
+	return writeLog(buf, size);
+}
+
+FB_SIZE_T TraceLogWriterImpl::writeLog(const void* buf, FB_SIZE_T size)
 {
 	const FB_SIZE_T written = m_log.write(buf, size);
 	if (written == size)
@@ -0,0 +1,128 @@
+/*
+ *	PROGRAM:	Firebird Trace Services
+ *	MODULE:		TraceRingBuffer.cpp
+ *	DESCRIPTION:	Lock-free in-process queue of trace records
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include <string.h>
+
+#include "../../jrd/trace/TraceRingBuffer.h"
+
+using namespace Firebird;
+
+namespace Jrd {
+
+TraceRingBuffer::TraceRingBuffer(MemoryPool& pool, ULONG size)
+	: m_size(size),
+	  m_mask(size - 1),
+	  m_data(FB_NEW_POOL(pool) UCHAR[size]),
+	  m_head(0),
+	  m_tail(0)
+{
+	fb_assert(size >= ALIGNMENT && !(size & m_mask));
+	memset(m_data, 0, size);
+}
+
+TraceRingBuffer::~TraceRingBuffer()
+{
+	delete[] m_data;
+}
+
+bool TraceRingBuffer::put(const void* data, ULONG length)
+{
+	fb_assert(length);
+
+	const ULONG space = FB_ALIGN(LENGTH_SIZE + length, ALIGNMENT);
+	if (space > m_size)
+		return false;
+
+	FB_UINT64 head = m_head.load(std::memory_order_relaxed);
+	do
+	{
+		if (head + space - m_tail.load(std::memory_order_acquire) > m_size)
+			return false;
+	} while (!m_head.compare_exchange_weak(head, head + space, std::memory_order_relaxed));
+
+	copyIn(head + LENGTH_SIZE, static_cast<const UCHAR*>(data), length);
+
+	// Length word is aligned and never wraps, publish it after the data
+	lengthAt(head)->store(length, std::memory_order_release);
+
+	return true;
+}
+
+ULONG TraceRingBuffer::get(void* buffer)
+{
+	UCHAR* dst = static_cast<UCHAR*>(buffer);
+	ULONG copied = 0;
+
+	const FB_UINT64 start = m_tail.load(std::memory_order_relaxed);
+	FB_UINT64 tail = start;
+
+	while (true)
+	{
+		const ULONG length = lengthAt(tail)->load(std::memory_order_acquire);
+		if (!length || copied + length > m_size)
+			break;
+
+		copyOut(tail + LENGTH_SIZE, dst + copied, length);
+		copied += length;
+
+		// Clear the space right away, the whole ring could be read in one pass
+		const ULONG space = FB_ALIGN(LENGTH_SIZE + length, ALIGNMENT);
+		clear(tail, space);
+		tail += space;
+	}
+
+	if (tail != start)
+		m_tail.store(tail, std::memory_order_release);
+
+	return copied;
+}
+
+void TraceRingBuffer::copyIn(FB_UINT64 pos, const UCHAR* src, ULONG length)
+{
+	const ULONG offset = (ULONG) (pos & m_mask);
+	const ULONG first = MIN(length, m_size - offset);
+
+	memcpy(m_data + offset, src, first);
+	memcpy(m_data, src + first, length - first);
+}
+
+void TraceRingBuffer::copyOut(FB_UINT64 pos, UCHAR* dst, ULONG length) const
+{
+	const ULONG offset = (ULONG) (pos & m_mask);
+	const ULONG first = MIN(length, m_size - offset);
+
+	memcpy(dst, m_data + offset, first);
+	memcpy(dst + first, m_data, length - first);
+}
+
+void TraceRingBuffer::clear(FB_UINT64 pos, ULONG length)
+{
+	// Only the words where the length of some next record could be published
+	// must be zero. Producers access them atomically, so reset them the same way.
+
+	fb_assert(!(pos % ALIGNMENT) && !(length % ALIGNMENT));
+
+	for (ULONG offset = 0; offset < length; offset += ALIGNMENT)
+		lengthAt(pos + offset)->store(0, std::memory_order_relaxed);
+}
+
+} // namespace Jrd
@@ -0,0 +1,85 @@
+/*
+ *	PROGRAM:	Firebird Trace Services
+ *	MODULE:		TraceRingBuffer.h
+ *	DESCRIPTION:	Lock-free in-process queue of trace records
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#ifndef TRACE_RING_BUFFER
+#define TRACE_RING_BUFFER
+
+#include "../../common/classes/alloc.h"
+#include <atomic>
+
+namespace Jrd {
+
+// Multiple producers / single consumer ring of variable length records.
+// Producer reserves the space moving the head with CAS, copies the record
+// and then publishes its length word. Consumer copies published records in
+// order and clears the space behind it, so a zero length word always means
+// "not published yet".
+
+class TraceRingBuffer
+{
+public:
+	// Size must be a power of two
+	TraceRingBuffer(Firebird::MemoryPool& pool, ULONG size);
+	~TraceRingBuffer();
+
+	TraceRingBuffer(const TraceRingBuffer&) = delete;
+	TraceRingBuffer& operator=(const TraceRingBuffer&) = delete;
+
+	// Called by any thread, returns false if there is not enough free space
+	bool put(const void* data, ULONG length);
+
+	// Called by the single reader only, copies as many whole records as fit
+	// into buffer of at least getSize() bytes, returns number of bytes copied
+	ULONG get(void* buffer);
+
+	ULONG getSize() const
+	{
+		return m_size;
+	}
+
+	ULONG getUsed() const
+	{
+		return (ULONG) (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed));
+	}
+
+private:
+	static const ULONG LENGTH_SIZE = sizeof(ULONG);
+	static const ULONG ALIGNMENT = 8;
+
+	std::atomic<ULONG>* lengthAt(FB_UINT64 pos) const
+	{
+		return reinterpret_cast<std::atomic<ULONG>*>(m_data + (pos & m_mask));
+	}
+
+	void copyIn(FB_UINT64 pos, const UCHAR* src, ULONG length);
+	void copyOut(FB_UINT64 pos, UCHAR* dst, ULONG length) const;
+	void clear(FB_UINT64 pos, ULONG length);
+
+	const ULONG m_size;
+	const ULONG m_mask;
+	UCHAR* const m_data;
+	std::atomic<FB_UINT64> m_head;		// reserved by producers
+	std::atomic<FB_UINT64> m_tail;		// released by consumer
+};
+
+} // namespace Jrd
+
+#endif // TRACE_RING_BUFFER
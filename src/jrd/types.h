@@ -153,6 +153,27 @@ TYPE("TRANSACTION", stat_transaction, nam_mon_stat_group)
 TYPE("STATEMENT", stat_statement, nam_mon_stat_group)
 TYPE("CALL", stat_call, nam_mon_stat_group)
 
+TYPE("PAGE_READ", wait_page_read, nam_mon_wait_type)
+TYPE("PAGE_WRITE", wait_page_write, nam_mon_wait_type)
+TYPE("PAGE_LATCH", wait_page_latch, nam_mon_wait_type)
+TYPE("LOCK_DATABASE", wait_lock_database, nam_mon_wait_type)
+TYPE("LOCK_METADATA", wait_lock_metadata, nam_mon_wait_type)
+TYPE("LOCK_BUFFER", wait_lock_buffer, nam_mon_wait_type)
+TYPE("LOCK_TRANSACTION", wait_lock_transaction, nam_mon_wait_type)
+TYPE("RECORD_CONFLICT", wait_record_conflict, nam_mon_wait_type)
+TYPE("GARBAGE_COLLECT", wait_garbage_collect, nam_mon_wait_type)
+TYPE("BACKOUT", wait_backout, nam_mon_wait_type)
+TYPE("SORT_SPILL", wait_sort_spill, nam_mon_wait_type)
+
+TYPE("DATABASE", io_file_database, nam_mon_file_type)
+TYPE("SHADOW", io_file_shadow, nam_mon_file_type)
+TYPE("DELTA", io_file_delta, nam_mon_file_type)
+TYPE("TEMPORARY", io_file_temporary, nam_mon_file_type)
+
+TYPE("READ", io_operation_read, nam_mon_io_operation)
+TYPE("WRITE", io_operation_write, nam_mon_io_operation)
+TYPE("SYNC", io_operation_sync, nam_mon_io_operation)
+
 TYPE("ALWAYS", IDENT_TYPE_ALWAYS, nam_identity_type)
 TYPE("BY DEFAULT", IDENT_TYPE_BY_DEFAULT, nam_identity_type)
 
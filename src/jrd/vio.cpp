@@ -691,8 +691,13 @@ inline void check_gbak_cheating_delete(thread_db* tdbb, const jrd_rel* relation)
 inline int wait(thread_db* tdbb, jrd_tra* transaction, const record_param* rpb, bool probe)
 {
 	if (!probe && transaction->getLockWait())
+	{
 		tdbb->bumpRelStats(RuntimeStatistics::RECORD_WAITS, rpb->rpb_relation->rel_id);
 
+		RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_RECORD_CONFLICT);
+		return TRA_wait(tdbb, transaction, rpb->rpb_transaction_nr, jrd_tra::tra_wait);
+	}
+
 	return TRA_wait(tdbb, transaction, rpb->rpb_transaction_nr,
 		probe ? jrd_tra::tra_probe : jrd_tra::tra_wait);
 }
@@ -826,6 +831,8 @@ void VIO_backout(thread_db* tdbb, record_param* rpb, const jrd_tra* transaction)
 
 	fb_assert(assert_gc_enabled(transaction, rpb->rpb_relation));
 
+	RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_BACKOUT);
+
 	jrd_rel* const relation = rpb->rpb_relation;
 
 #ifdef VIO_DEBUG
@@ -2565,6 +2572,8 @@ void VIO_intermediate_gc(thread_db* tdbb, record_param* rpb, jrd_tra* transactio
 	Database *dbb = tdbb->getDatabase();
 	Attachment* att = tdbb->getAttachment();
 
+	RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_GARBAGE_COLLECT);
+
 	// If current record is not a primary version, release it and fetch primary version
 	if (rpb->rpb_flags & rpb_chained)
 	{
@@ -5103,6 +5112,8 @@ static void expunge(thread_db* tdbb, record_param* rpb, const jrd_tra* transacti
 	if (attachment->att_flags & ATT_no_cleanup)
 		return;
 
+	RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_GARBAGE_COLLECT);
+
 	// Re-fetch the record
 
 	if (!DPM_get(tdbb, rpb, LCK_write))
@@ -6501,6 +6512,8 @@ static void purge(thread_db* tdbb, record_param* rpb)
 		rpb->rpb_f_page, rpb->rpb_f_line);
 #endif
 
+	RuntimeStatistics::WaitTimer waitTimer(tdbb, RuntimeStatistics::WAIT_GARBAGE_COLLECT);
+
 	// Release and re-fetch the page for write.  Make sure it's still the
 	// same record (give up if not).  Then zap the back pointer and release
 	// the record.
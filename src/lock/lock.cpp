@@ -166,6 +166,42 @@ static const bool compatibility[LCK_max][LCK_max] =
 namespace Jrd {
 
 
+// Wait statistics accounting the waits for the lock series (see enum lck_t)
+
+static RuntimeStatistics::StatType getWaitType(UCHAR series)
+{
+	switch (series)
+	{
+	case LCK_bdb:
+	case LCK_btr_dont_gc:
+		return RuntimeStatistics::WAIT_LOCK_BUFFER;
+
+	case LCK_tra:
+	case LCK_record_gc:
+		return RuntimeStatistics::WAIT_LOCK_TRANSACTION;
+
+	case LCK_relation:
+	case LCK_rel_exist:
+	case LCK_idx_exist:
+	case LCK_expression:
+	case LCK_prc_exist:
+	case LCK_rel_partners:
+	case LCK_dsql_cache:
+	case LCK_tt_exist:
+	case LCK_rel_gc:
+	case LCK_fun_exist:
+	case LCK_rel_rescan:
+	case LCK_repl_tables:
+	case LCK_dsql_statement_cache:
+	case LCK_gen_ranges:
+		return RuntimeStatistics::WAIT_LOCK_METADATA;
+
+	default:
+		return RuntimeStatistics::WAIT_LOCK_DATABASE;
+	}
+}
+
+
 LockManager::LockManager(const string& id, const Config* conf)
 	: PID(getpid()),
 	  m_bugcheck(false),
@@ -3726,6 +3762,9 @@ void LockManager::wait_for_request(thread_db* tdbb, lrq* request, SSHORT lck_wai
  **************************************/
 	ASSERT_ACQUIRED;
 
+	RuntimeStatistics::WaitTimer waitTimer(tdbb,
+		getWaitType(((lbl*) SRQ_ABS_PTR(request->lrq_lock))->lbl_series));
+
 	++(m_sharedMemory->getHeader()->lhb_waits);
 	const ULONG scan_interval = m_sharedMemory->getHeader()->lhb_scan_interval;
 
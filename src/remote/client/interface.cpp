@@ -38,6 +38,7 @@
 #include "../common/gdsassert.h"
 #include "../common/isc_proto.h"
 #include <stdarg.h>
+#include <functional>
 
 #ifndef NO_NFS
 #include <sys/param.h>
@@ -336,6 +337,8 @@ public:
 			outputFormat = outFmt;
 	}
 
+	void sendFirstFetch();
+
 private:
 	bool fetch(CheckStatusWrapper* status, void* message, P_FETCH operation, int position = 0);
 	void releaseStatement();
@@ -730,6 +733,10 @@ public:
 		return dialect;
 	}
 
+	ResultSet* internalOpenCursor(CheckStatusWrapper* status, ITransaction* tra,
+		IMessageMetadata* inMetadata, void* inBuffer, IMessageMetadata* outFormat,
+		unsigned int flags, const std::function<void ()>& pipelinedPrepare);
+
 private:
 	void freeClientData(CheckStatusWrapper* status, bool force = false);
 	void internalFree(CheckStatusWrapper* status);
@@ -931,6 +938,10 @@ public:
 	Replicator* replicator;
 
 private:
+	ResultSet* openPipelinedCursor(CheckStatusWrapper* status, ITransaction* transaction,
+		unsigned int stmtLength, const char* sqlStmt, unsigned dialect,
+		IMessageMetadata* inMetadata, void* inBuffer, IMessageMetadata* outMetadata,
+		unsigned int cursorFlags, Statement*& stmt);
 	void execWithCheck(CheckStatusWrapper* status, const string& stmt);
 	void freeClientData(CheckStatusWrapper* status, bool force = false);
 	void internalDetach(Firebird::CheckStatusWrapper* status);
@@ -1998,11 +2009,16 @@ void Attachment::getInfo(CheckStatusWrapper* status,
 		string version;
 		port->versionInfo(version);
 
+		FB_UINT64 wireStats[WIRE_STATS_COUNT];
+		const bool needStats = memchr(items, fb_info_wire_stats, item_length);
+		if (needStats)
+			port->wireStats(wireStats);
+
 		MERGE_database_info(temp_buffer, buffer, buffer_length,
 							DbImplementation::current.backwardCompatibleImplementation(), 3, 1,
 							reinterpret_cast<const UCHAR*>(version.c_str()),
 							reinterpret_cast<const UCHAR*>(port->port_host->str_data),
-							protocol);
+							protocol, needStats ? wireStats : NULL);
 	}
 	catch (const Exception& ex)
 	{
@@ -3375,6 +3391,9 @@ ITransaction* Statement::execute(CheckStatusWrapper* status, ITransaction* apiTr
  *
  * Functional description
  *	Execute a non-SELECT dynamic SQL statement.
+ *	The statement is already prepared by the caller, which got
+ *	its metadata or error back, so the execution can't be sent
+ *	along with the prepare and takes its own round trip.
  *
  **************************************/
 
@@ -3541,6 +3560,14 @@ ITransaction* Statement::execute(CheckStatusWrapper* status, ITransaction* apiTr
 
 ResultSet* Statement::openCursor(CheckStatusWrapper* status, Firebird::ITransaction* apiTra,
 	IMessageMetadata* inMetadata, void* inBuffer, IMessageMetadata* outFormat, unsigned int flags)
+{
+	return internalOpenCursor(status, apiTra, inMetadata, inBuffer, outFormat, flags, nullptr);
+}
+
+
+ResultSet* Statement::internalOpenCursor(CheckStatusWrapper* status, Firebird::ITransaction* apiTra,
+	IMessageMetadata* inMetadata, void* inBuffer, IMessageMetadata* outFormat, unsigned int flags,
+	const std::function<void ()>& pipelinedPrepare)
 {
 /**************************************
  *
@@ -3550,6 +3577,9 @@ ResultSet* Statement::openCursor(CheckStatusWrapper* status, Firebird::ITransact
  *
  * Functional description
  *	Execute a non-SELECT dynamic SQL statement.
+ *	If pipelinedPrepare is passed, it's called to send the
+ *	allocate and prepare requests in front of op_execute
+ *	and the response is left on the wire for the caller.
  *
  **************************************/
 
@@ -3643,6 +3673,11 @@ ResultSet* Statement::openCursor(CheckStatusWrapper* status, Firebird::ITransact
 		statement->rsr_format = statement->rsr_bind_format;
 		statement->clearException();
 
+		// Everything is validated, now the statement may be allocated and prepared
+
+		if (pipelinedPrepare)
+			pipelinedPrepare();
+
 		// set up the packet for the other guy...
 
 		PACKET* packet = &rdb->rdb_packet;
@@ -3665,7 +3700,11 @@ ResultSet* Statement::openCursor(CheckStatusWrapper* status, Firebird::ITransact
 				message->msg_address = NULL;
 			});
 
-			if (statement->rsr_flags.test(Rsr::DEFER_EXECUTE))
+			if (pipelinedPrepare)
+			{
+				send_partial_packet(port, packet);
+			}
+			else if (statement->rsr_flags.test(Rsr::DEFER_EXECUTE))
 			{
 				send_partial_packet(port, packet);
 				defer_packet(port, packet, true);
@@ -3693,18 +3732,40 @@ IResultSet* Attachment::openCursor(CheckStatusWrapper* status, ITransaction* tra
 		IMessageMetadata* inMetadata, void* inBuffer, IMessageMetadata* outMetadata,
 		const char* cursorName, unsigned int cursorFlags)
 {
-	Statement* stmt = prepare(status, transaction, stmtLength, sqlStmt, dialect,
-		(outMetadata ? 0 : IStatement::PREPARE_PREFETCH_OUTPUT_PARAMETERS));
-	if (status->getState() & Firebird::IStatus::STATE_ERRORS)
+	Statement* stmt = NULL;
+	ResultSet* rc = NULL;
+
+	// When the output format is known in advance, the whole prepare - open - fetch
+	// sequence may be sent at once. Scrollable cursors are not prefetched.
+
+	const rem_port* const port = rdb ? rdb->rdb_port : NULL;
+
+	if (outMetadata && port && (port->port_flags & PORT_lazy) &&
+		port->port_protocol >= PROTOCOL_PIPELINED_CURSOR &&
+		!(cursorFlags & IStatement::CURSOR_TYPE_SCROLLABLE))
 	{
-		return NULL;
+		rc = openPipelinedCursor(status, transaction, stmtLength, sqlStmt, dialect,
+			inMetadata, inBuffer, outMetadata, cursorFlags, stmt);
+		if (status->getState() & Firebird::IStatus::STATE_ERRORS)
+		{
+			return NULL;
+		}
 	}
-
-	ResultSet* rc = stmt->openCursor(status, transaction, inMetadata, inBuffer, outMetadata, cursorFlags);
-	if (status->getState() & Firebird::IStatus::STATE_ERRORS)
+	else
 	{
-		stmt->release();
-		return NULL;
+		stmt = prepare(status, transaction, stmtLength, sqlStmt, dialect,
+			(outMetadata ? 0 : IStatement::PREPARE_PREFETCH_OUTPUT_PARAMETERS));
+		if (status->getState() & Firebird::IStatus::STATE_ERRORS)
+		{
+			return NULL;
+		}
+
+		rc = stmt->openCursor(status, transaction, inMetadata, inBuffer, outMetadata, cursorFlags);
+		if (status->getState() & Firebird::IStatus::STATE_ERRORS)
+		{
+			stmt->release();
+			return NULL;
+		}
 	}
 
 	if (cursorName)
@@ -3723,6 +3784,199 @@ IResultSet* Attachment::openCursor(CheckStatusWrapper* status, ITransaction* tra
 }
 
 
+ResultSet* Attachment::openPipelinedCursor(CheckStatusWrapper* status, ITransaction* apiTra,
+	unsigned int stmtLength, const char* sqlStmt, unsigned int dialect,
+	IMessageMetadata* inMetadata, void* inBuffer, IMessageMetadata* outMetadata,
+	unsigned int cursorFlags, Statement*& stmt)
+{
+/**************************************
+ *
+ * Functional description
+ *	Prepare a statement, open a cursor and request the first
+ *	batch of rows in a single round trip. op_allocate_statement,
+ *	op_prepare_statement, op_execute and op_fetch are sent at once
+ *	and their responses are received in the same order.
+ *
+ **************************************/
+
+	ResultSet* rs = NULL;
+
+	try
+	{
+		reset(status);
+
+		// Check and validate handles, etc.
+
+		CHECK_HANDLE(rdb, isc_bad_db_handle);
+		rem_port* port = rdb->rdb_port;
+		RefMutexGuard portGuard(*port->port_sync, FB_FUNCTION);
+
+		Rtr* transaction = NULL;
+		if (apiTra)
+		{
+			transaction = remoteTransaction(apiTra);
+			CHECK_HANDLE(transaction, isc_bad_trans_handle);
+		}
+
+		if (sqlStmt && !stmtLength)
+			stmtLength = static_cast<ULONG>(strlen(sqlStmt));
+
+		// Validate string length
+
+		CHECK_LENGTH(port, stmtLength);
+
+		if (dialect > 10)
+		{
+			// dimitr: adjust dialect received after
+			//		   a multi-hop transmission to be
+			//		   redirected in its original value.
+			dialect /= 10;
+		}
+
+		// create new statement, it's always lazy here
+
+		stmt = createStatement(status, dialect);
+		Rsr* statement = stmt->getStatement();
+		fb_assert(statement->rsr_flags.test(Rsr::LAZY));
+
+		// reset current statement
+
+		clear_queue(port);
+		REMOTE_reset_statement(statement);
+
+		Array<UCHAR> items, buffer;
+		buffer.resize(StatementMetadata::buildInfoItems(items, 0));
+
+		// Validate data length
+
+		CHECK_LENGTH(port, items.getCount());
+		CHECK_LENGTH(port, buffer.getCount());
+
+		// Messages of the statement are mapped by XDR before its handle is known
+
+		port->port_pipelined_statement = statement;
+		Firebird::Cleanup pipelineClean([port] {
+			port->port_pipelined_statement = NULL;
+		});
+
+		PACKET* packet = &rdb->rdb_packet;
+
+		rs = stmt->internalOpenCursor(status, apiTra, inMetadata, inBuffer, outMetadata, cursorFlags,
+			[&] {
+				packet->p_operation = op_allocate_statement;
+				packet->p_rlse.p_rlse_object = rdb->rdb_id;
+
+				send_partial_packet(port, packet);
+
+				packet->p_operation = op_prepare_statement;
+				P_SQLST* prepare = &packet->p_sqlst;
+				prepare->p_sqlst_transaction = transaction ? transaction->rtr_id : 0;
+				prepare->p_sqlst_statement = statement->rsr_id;
+				prepare->p_sqlst_SQL_dialect = dialect;
+				prepare->p_sqlst_SQL_str.cstr_length = stmtLength;
+				prepare->p_sqlst_SQL_str.cstr_address = reinterpret_cast<const UCHAR*>(sqlStmt);
+				prepare->p_sqlst_items.cstr_length = (ULONG) items.getCount();
+				prepare->p_sqlst_items.cstr_address = items.begin();
+				prepare->p_sqlst_buffer_length = (ULONG) buffer.getCount();
+				prepare->p_sqlst_flags = 0;
+
+				send_partial_packet(port, packet);
+			});
+
+		if (status->getState() & Firebird::IStatus::STATE_ERRORS)
+		{
+			// Nothing was sent, just drop the client side statement
+			stmt->release();
+			stmt = NULL;
+			return NULL;
+		}
+
+		// Request the first batch of rows and push everything over the wire
+
+		rs->sendFirstFetch();
+
+		// Receive the responses in order. The first error is saved within
+		// the statement, the rest are likely caused by it and thus ignored.
+
+		const auto checkResponse = [&]() -> bool
+		{
+			try
+			{
+				LocalStatus ls;
+				CheckStatusWrapper warning(&ls);
+				REMOTE_check_response(&warning, rdb, packet);
+				return true;
+			}
+			catch (const Exception& ex)
+			{
+				statement->saveException(ex, false);
+			}
+
+			return false;
+		};
+
+		// op_allocate_statement
+
+		receive_packet_noqueue(port, packet);
+		if (checkResponse())
+		{
+			statement->rsr_id = packet->p_resp.p_resp_object;
+			SET_OBJECT(rdb, statement, statement->rsr_id);
+
+			statement->rsr_flags.clear(Rsr::LAZY);
+		}
+
+		// op_prepare_statement
+
+		P_RESP* response = &packet->p_resp;
+		{
+			UsePreallocatedBuffer temp(response->p_resp_data, buffer.getCount(), buffer.begin());
+
+			receive_packet_noqueue(port, packet);
+			if (checkResponse())
+				stmt->parseMetadata(buffer);
+		}
+
+		statement->rsr_flags.clear(Rsr::DEFER_EXECUTE);
+		if (response->p_resp_object & STMT_DEFER_EXECUTE)
+			statement->rsr_flags.set(Rsr::DEFER_EXECUTE);
+
+		// op_execute
+
+		receive_packet_noqueue(port, packet);
+		if (checkResponse())
+			statement->rsr_rtr = transaction;
+
+		// op_fetch - rows are received when the application asks for them
+
+		enqueue_receive(port, batch_dsql_fetch, rdb, statement, NULL);
+
+		if (statement->haveException())
+		{
+			clear_stmt_que(port, statement);
+			statement->raiseException();
+		}
+
+		return rs;
+	}
+	catch (const Exception& ex)
+	{
+		ex.stuffException(status);
+	}
+
+	if (rs)
+		rs->release();
+
+	if (stmt)
+	{
+		stmt->release();
+		stmt = NULL;
+	}
+
+	return NULL;
+}
+
+
 ITransaction* Attachment::execute(CheckStatusWrapper* status, ITransaction* apiTra,
 	unsigned int stmtLength, const char* sqlStmt, unsigned int dialect,
 	IMessageMetadata* inMetadata, void* inBuffer, IMessageMetadata* outMetadata, void* outBuffer)
@@ -3735,6 +3989,8 @@ ITransaction* Attachment::execute(CheckStatusWrapper* status, ITransaction* apiT
  *
  * Functional description
  *	Prepare and execute a statement.
+ *	Both are done by a single op_exec_immediate(2) packet, so
+ *	unlike openCursor() there is nothing left to pipeline here.
  *
  **************************************/
 
@@ -4946,6 +5202,88 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 }
 
 
+void ResultSet::sendFirstFetch()
+{
+/**************************************
+ *
+ * Functional description
+ *	Request the first batch of rows right after the cursor
+ *	open without waiting for the response. The caller is in
+ *	charge of queueing receipt of the rows.
+ *
+ **************************************/
+
+	Rsr* const statement = stmt->getStatement();
+	Rdb* const rdb = statement->rsr_rdb;
+	rem_port* const port = rdb->rdb_port;
+
+	BlrFromMessage outBlr(outputFormat, stmt->getDialect(), port->port_protocol);
+	const unsigned int blr_length = outBlr.getLength();
+	const UCHAR* const blr = outBlr.getBytes();
+
+	// Reset the stream like the first fetch does
+
+	statement->rsr_flags.clear(Rsr::STREAM_END | Rsr::PAST_END | Rsr::STREAM_ERR);
+	statement->rsr_flags.set(Rsr::FETCHED);
+	statement->rsr_fetch_operation = fetch_next;
+	statement->rsr_fetch_position = 0;
+
+	RMessage* message = statement->rsr_message;
+	if (message)
+	{
+		statement->rsr_buffer = message;
+
+		while (true)
+		{
+			message->msg_address = NULL;
+			message = message->msg_next;
+
+			if (message == statement->rsr_message)
+				break;
+		}
+	}
+
+	if (statement->rsr_user_select_format &&
+		statement->rsr_user_select_format != statement->rsr_select_format)
+	{
+		delete statement->rsr_user_select_format;
+	}
+
+	delete statement->rsr_select_format;
+	statement->rsr_select_format = statement->rsr_user_select_format =
+		blr_length ? PARSE_msg_format(blr, blr_length) : NULL;
+
+	if (!statement->rsr_buffer)
+	{
+		statement->rsr_buffer = FB_NEW RMessage(0);
+		statement->rsr_message = statement->rsr_buffer;
+		statement->rsr_message->msg_next = statement->rsr_message;
+		statement->rsr_fmt_length = 0;
+	}
+
+	PACKET* packet = &rdb->rdb_packet;
+	packet->p_operation = op_fetch;
+	P_SQLDATA* sqldata = &packet->p_sqldata;
+	sqldata->p_sqldata_statement = statement->rsr_id;
+	sqldata->p_sqldata_blr.cstr_length = blr_length;
+	sqldata->p_sqldata_blr.cstr_address = const_cast<unsigned char*>(blr);
+	sqldata->p_sqldata_message_number = 0;	// msg_type
+	sqldata->p_sqldata_messages = statement->rsr_select_format ?
+		REMOTE_compute_batch_size(port, 0, op_fetch_response, statement->rsr_select_format) : 0;
+
+	// Reorder data when the local buffer is half empty
+
+	statement->rsr_reorder_level = sqldata->p_sqldata_messages / 2;
+	statement->rsr_rows_pending = sqldata->p_sqldata_messages;
+
+	// Make the batch request - and force the packet over the wire
+
+	send_packet(port, packet);
+
+	statement->rsr_batch_count++;
+}
+
+
 int ResultSet::fetchNext(CheckStatusWrapper* user_status, void* buffer)
 {
 	try
@@ -8367,7 +8705,7 @@ static void authReceiveResponse(bool havePacket, ClntAuthBlock& cBlock, rem_port
 				n->cstr_length, n->cstr_address, n->cstr_address ? n->cstr_address[0] : 0));
 			if (packet->p_acpd.p_acpt_type & pflag_compress)
 			{
-				port->initCompression();
+				port->initCompression(packet->p_acpd.p_acpt_type);
 				port->port_flags |= PORT_compressed;
 			}
 			packet->p_acpd.p_acpt_type &= ptype_MASK;
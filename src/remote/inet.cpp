@@ -698,6 +698,12 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 
 	bool compression = config && (*config)->getWireCompression();
 
+	// Old servers ignore frame flags and fall back to plain zlib stream
+
+	USHORT compressFlags = pflag_compress | pflag_compress_frame;
+	if (compression && NoCaseString((*config)->getWireCompressionMethod()) == "LZ4")
+		compressFlags |= pflag_compress_lz4;
+
 	// Establish connection to server
 	// If we want user verification, we can't speak anything less than version 7
 
@@ -717,7 +723,8 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 		REMOTE_PROTOCOL(PROTOCOL_VERSION16, ptype_lazy_send, 7),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION17, ptype_lazy_send, 8),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION18, ptype_lazy_send, 9),
-		REMOTE_PROTOCOL(PROTOCOL_VERSION19, ptype_lazy_send, 10)
+		REMOTE_PROTOCOL(PROTOCOL_VERSION19, ptype_lazy_send, 10),
+		REMOTE_PROTOCOL(PROTOCOL_VERSION20, ptype_lazy_send, 11)
 	};
 	fb_assert(FB_NELEM(protocols_to_try) <= FB_NELEM(cnct->p_cnct_versions));
 	cnct->p_cnct_count = FB_NELEM(protocols_to_try);
@@ -727,7 +734,7 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 		if (compression && cnct->p_cnct_versions[i].p_cnct_version >= PROTOCOL_VERSION13 &&
 			rem_port::checkCompression())
 		{
-			cnct->p_cnct_versions[i].p_cnct_max_type |= pflag_compress;
+			cnct->p_cnct_versions[i].p_cnct_max_type |= compressFlags;
 		}
 	}
 
@@ -839,7 +846,7 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 		port->port_flags |= PORT_symmetric;
 	}
 
-	bool compress = accept->p_acpt_type & pflag_compress;
+	const USHORT compress = accept->p_acpt_type & pflag_compress ? accept->p_acpt_type : 0;
 	accept->p_acpt_type &= ptype_MASK;
 
 	if (accept->p_acpt_type != ptype_out_of_band) {
@@ -852,7 +859,7 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 
 	if (compress)
 	{
-		port->initCompression();
+		port->initCompression(compress);
 		port->port_flags |= PORT_compressed;
 	}
 
@@ -2963,6 +2970,8 @@ static bool packet_receive(rem_port* port, UCHAR* buffer, SSHORT buffer_length,
 		return false;
 	}
 
+	PortWaitTimer waitTimer(port->port_rcv_time);
+
 	timeval timeout;
 	timeout.tv_usec = 0;
 	timeval* time_ptr = NULL;
@@ -3152,6 +3161,8 @@ static bool packet_send( rem_port* port, const SCHAR* buffer, SSHORT buffer_leng
  *
  **************************************/
 
+	PortWaitTimer waitTimer(port->port_snd_time);
+
 	SSHORT length = buffer_length;
 	const char* data = buffer;
 
@@ -35,6 +35,12 @@ inline void PUT_WORD(UCHAR*& ptr, USHORT value)
 	*ptr++ = static_cast<UCHAR>(value >> 8);
 }
 
+inline void PUT_INT64(UCHAR*& ptr, FB_UINT64 value)
+{
+	for (unsigned i = 0; i < sizeof(value); ++i, value >>= 8)
+		*ptr++ = static_cast<UCHAR>(value);
+}
+
 #define PUT(ptr, value)		*(ptr)++ = value;
 
 static ISC_STATUS merge_setup(const Firebird::ClumpletReader&, UCHAR**, const UCHAR* const, FB_SIZE_T);
@@ -48,7 +54,8 @@ USHORT MERGE_database_info(const UCHAR* const in,
 							USHORT base_level,
 							const UCHAR* version,
 							const UCHAR* id,
-							USHORT protocol)
+							USHORT protocol,
+							const FB_UINT64* wire_stats)
 {
 /**************************************
  *
@@ -60,6 +67,10 @@ USHORT MERGE_database_info(const UCHAR* const in,
  *	Merge server / remote interface / Y-valve information into
  *	database block.  Return the actual length of the packet.
  *	See also jrd/utl.cpp for decoding of this block.
+ *	Wire statistics are bytes sent before compression, sent over
+ *	the wire, received after decompression and received over the wire,
+ *	followed by packets sent, send time, packets received and receive
+ *	wait time (in microseconds).
  *
  **************************************/
 	SSHORT l;
@@ -99,15 +110,29 @@ USHORT MERGE_database_info(const UCHAR* const in,
 		switch (input.getClumpTag())
 		{
 		case isc_info_end:
-			if (protocol)
+			if (protocol || wire_stats)
 			{
 				--out;
-				if (out + (1 + 2 + 2 + 1) <= end)
+				const FB_SIZE_T length = (protocol ? 1 + 2 + 2 : 0) +
+					(wire_stats ? 1 + 2 + WIRE_STATS_COUNT * sizeof(FB_UINT64) : 0) + 1;
+
+				if (out + length <= end)
 				{
-					PUT(out, (UCHAR)fb_info_protocol_version);
-					PUT_WORD(out, 2u);
-					PUT_WORD(out, protocol);
-					protocol = 0;
+					if (protocol)
+					{
+						PUT(out, (UCHAR)fb_info_protocol_version);
+						PUT_WORD(out, 2u);
+						PUT_WORD(out, protocol);
+						protocol = 0;
+					}
+
+					if (wire_stats)
+					{
+						PUT(out, (UCHAR)fb_info_wire_stats);
+						PUT_WORD(out, WIRE_STATS_COUNT * sizeof(FB_UINT64));
+						for (unsigned i = 0; i < WIRE_STATS_COUNT; ++i)
+							PUT_INT64(out, wire_stats[i]);
+					}
 
 					PUT(out, (UCHAR)isc_info_end);
 				}
@@ -161,6 +186,7 @@ USHORT MERGE_database_info(const UCHAR* const in,
 			break;
 
 		case fb_info_protocol_version:
+		case fb_info_wire_stats:
 			--out;
 			break;
 
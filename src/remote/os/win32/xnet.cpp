@@ -308,7 +308,8 @@ rem_port* XNET_analyze(ClntAuthBlock* cBlock,
 		REMOTE_PROTOCOL(PROTOCOL_VERSION16, ptype_batch_send, 7),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION17, ptype_batch_send, 8),
 		REMOTE_PROTOCOL(PROTOCOL_VERSION18, ptype_batch_send, 9),
-		REMOTE_PROTOCOL(PROTOCOL_VERSION19, ptype_batch_send, 10)
+		REMOTE_PROTOCOL(PROTOCOL_VERSION19, ptype_batch_send, 10),
+		REMOTE_PROTOCOL(PROTOCOL_VERSION20, ptype_batch_send, 11)
 	};
 	fb_assert(FB_NELEM(protocols_to_try) <= FB_NELEM(cnct->p_cnct_versions));
 	cnct->p_cnct_count = FB_NELEM(protocols_to_try);
@@ -1964,6 +1965,8 @@ static bool_t xnet_read(RemoteXdr* xdrs)
 	if (xnet_shutdown)
 		return FALSE;
 
+	PortWaitTimer waitTimer(port->port_rcv_time);
+
 	if (!SetEvent(xcc->xcc_event_recv_channel_empted))
 	{
 		xnet_error(port, isc_net_read_err, ERRNO);
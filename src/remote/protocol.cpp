@@ -121,6 +121,7 @@ static bool_t xdr_trrq_message(RemoteXdr*, USHORT);
 static bool_t xdr_bytes(RemoteXdr*, void*, ULONG);
 static bool_t xdr_blob_stream(RemoteXdr*, SSHORT, CSTRING*);
 static Rsr* getStatement(RemoteXdr*, USHORT);
+static Rsr* getPipelinedStatement(rem_port*);
 
 
 inline void fixupLength(const RemoteXdr* xdrs, ULONG& length)
@@ -1876,7 +1877,12 @@ static bool_t xdr_sql_blr(RemoteXdr* xdrs,
 
 	Rsr* statement;
 
-	if (statement_id >= 0)
+	if (statement_id == INVALID_OBJECT && (port->port_flags & PORT_lazy))
+	{
+		if (!(statement = getPipelinedStatement(port)))
+			return FALSE;
+	}
+	else if (statement_id >= 0)
 	{
 		if (static_cast<ULONG>(statement_id) >= port->port_objects.getCount())
 			return FALSE;
@@ -1975,7 +1981,11 @@ static bool_t xdr_sql_message( RemoteXdr* xdrs, SLONG statement_id)
 
 	rem_port* port = xdrs->x_public;
 
-	if (statement_id >= 0)
+	if (statement_id == INVALID_OBJECT && (port->port_flags & PORT_lazy))
+	{
+		statement = getPipelinedStatement(port);
+	}
+	else if (statement_id >= 0)
 	{
 		if (static_cast<ULONG>(statement_id) >= port->port_objects.getCount())
 			return FALSE;
@@ -2271,6 +2281,28 @@ static Rsr* getStatement(RemoteXdr* xdrs, USHORT statement_id)
 	return port->port_statement;
 }
 
+static Rsr* getPipelinedStatement(rem_port* port)
+{
+	// The statement is referenced in the same batch of packets as its
+	// op_allocate_statement, so the client does not know its handle yet.
+	// The server uses the last allocated handle, the client - the statement
+	// it's pipelining right now.
+
+	if (!(port->port_flags & PORT_server))
+		return port->port_pipelined_statement;
+
+	try
+	{
+		Rsr* statement;
+		port->getHandle(statement, INVALID_OBJECT);
+		return statement;
+	}
+	catch (const status_exception&)
+	{
+		return nullptr;
+	}
+}
+
 static bool_t xdr_blob_stream(RemoteXdr* xdrs, SSHORT statement_id, CSTRING* strmPortion)
 {
 	if (xdrs->x_op == XDR_FREE)
@@ -109,6 +109,14 @@ const USHORT PROTOCOL_FETCH_SCROLL = PROTOCOL_VERSION18;
 
 const USHORT PROTOCOL_VERSION19 = (FB_PROTOCOL_FLAG | 19);
 
+// Protocol 20:
+//	- supports op_execute and op_fetch referencing the statement whose
+//	  op_allocate_statement is not answered yet (INVALID_OBJECT), thus
+//	  allowing to prepare, open and fetch a cursor in a single round trip
+
+const USHORT PROTOCOL_VERSION20 = (FB_PROTOCOL_FLAG | 20);
+const USHORT PROTOCOL_PIPELINED_CURSOR = PROTOCOL_VERSION20;
+
 // Architecture types
 
 enum P_ARCH
@@ -143,6 +151,21 @@ const USHORT ptype_MASK			= 0xFF;	// Mask - up to 255 types of protocol
 // upper byte is used for protocol flags
 const USHORT pflag_compress			= 0x100;	// Turn on compression if possible
 const USHORT pflag_win_sspi_nego	= 0x200;	// Win_SSPI supports Negotiate security package
+const USHORT pflag_compress_frame	= 0x400;	// Compressed data is sent as separate frames
+const USHORT pflag_compress_lz4		= 0x800;	// Frames are compressed by LZ4 instead of zlib
+
+// Framed wire compression (pflag_compress_frame)
+// Each frame starts with a header: method (1 byte), unpacked length (2 bytes)
+// and packed length (2 bytes), both lengths are in network byte order.
+// Data smaller than compression threshold is sent in stored frames.
+
+const UCHAR WIRE_FRAME_STORED	= 0;
+const UCHAR WIRE_FRAME_ZLIB		= 1;
+const UCHAR WIRE_FRAME_LZ4		= 2;
+
+const ULONG WIRE_FRAME_HEADER	= 5;
+const ULONG WIRE_FRAME_DATA		= 16384;	// max unpacked length of a frame
+const ULONG WIRE_FRAME_PACKED	= WIRE_FRAME_DATA + WIRE_FRAME_DATA / 16;	// max packed length of a frame
 
 // Generic object id
 
@@ -388,7 +411,7 @@ typedef struct p_cnct
 		USHORT	p_cnct_min_type;		// Minimum type (unused)
 		USHORT	p_cnct_max_type;		// Maximum type
 		USHORT	p_cnct_weight;			// Preference weight
-	}		p_cnct_versions[10];
+	}		p_cnct_versions[11];
 } P_CNCT;
 
 #ifdef ASYMMETRIC_PROTOCOLS_ONLY
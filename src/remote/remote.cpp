@@ -38,6 +38,8 @@
 #include "../common/os/mod_loader.h"
 #include "../jrd/license.h"
 #include "../common/classes/ImplementHelper.h"
+#include "../common/classes/Lz4.h"
+#include "../common/utils_proto.h"
 
 #ifdef DEV_BUILD
 Firebird::AtomicCounter rem_port::portCounter;
@@ -1368,6 +1370,275 @@ void rem_port::versionInfo(Firebird::string& version) const
 
 #ifdef WIRE_COMPRESS_SUPPORT
 static Firebird::InitInstance<Firebird::ZLib> zlib;
+
+namespace {
+
+// Frames are packed by zlib stream with sync flush after each frame.
+// Stream state is kept between frames to preserve compression dictionary,
+// therefore data fed to deflate must always reach the other side.
+
+class ZLibCodec : public WireCodec
+{
+public:
+	ZLibCodec()
+	{
+		sendStream.zalloc = Firebird::ZLib::allocFunc;
+		sendStream.zfree = Firebird::ZLib::freeFunc;
+		sendStream.opaque = Z_NULL;
+		int ret = zlib().deflateInit(&sendStream, Z_DEFAULT_COMPRESSION);
+		if (ret != Z_OK)
+			(Firebird::Arg::Gds(isc_deflate_init) << Firebird::Arg::Num(ret)).raise();
+
+		recvStream.zalloc = Firebird::ZLib::allocFunc;
+		recvStream.zfree = Firebird::ZLib::freeFunc;
+		recvStream.opaque = Z_NULL;
+		recvStream.avail_in = 0;
+		recvStream.next_in = Z_NULL;
+		ret = zlib().inflateInit(&recvStream);
+		if (ret != Z_OK)
+		{
+			zlib().deflateEnd(&sendStream);
+			(Firebird::Arg::Gds(isc_inflate_init) << Firebird::Arg::Num(ret)).raise();
+		}
+	}
+
+	~ZLibCodec()
+	{
+		zlib().deflateEnd(&sendStream);
+		zlib().inflateEnd(&recvStream);
+	}
+
+	UCHAR getMethod() const override
+	{
+		return WIRE_FRAME_ZLIB;
+	}
+
+	bool pack(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength,
+		ULONG* packedLength) override
+	{
+		sendStream.next_in = const_cast<Bytef*>(from);
+		sendStream.avail_in = fromLength;
+		sendStream.next_out = to;
+		sendStream.avail_out = toLength;
+
+		const int ret = zlib().deflate(&sendStream, Z_SYNC_FLUSH);
+		if ((ret != Z_OK && ret != Z_BUF_ERROR) || sendStream.avail_in || !sendStream.avail_out)
+			return false;
+
+		*packedLength = toLength - sendStream.avail_out;
+		return true;
+	}
+
+	bool unpack(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength) override
+	{
+		recvStream.next_in = const_cast<Bytef*>(from);
+		recvStream.avail_in = fromLength;
+		recvStream.next_out = to;
+		recvStream.avail_out = toLength;
+
+		const int ret = zlib().inflate(&recvStream, Z_SYNC_FLUSH);
+		return (ret == Z_OK || ret == Z_BUF_ERROR) && !recvStream.avail_in && !recvStream.avail_out;
+	}
+
+private:
+	z_stream sendStream, recvStream;
+};
+
+// Stateless LZ4 blocks - much less CPU than zlib at the cost of compression ratio
+
+class Lz4Codec : public WireCodec
+{
+public:
+	UCHAR getMethod() const override
+	{
+		return WIRE_FRAME_LZ4;
+	}
+
+	bool pack(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength,
+		ULONG* packedLength) override
+	{
+		// Packed data not smaller than original is useless
+		*packedLength = Firebird::Lz4::compress(from, fromLength, to, MIN(toLength, fromLength - 1));
+		return true;
+	}
+
+	bool unpack(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength) override
+	{
+		ULONG length;
+		return Firebird::Lz4::decompress(from, fromLength, to, toLength, &length) && length == toLength;
+	}
+};
+
+// Layout of port_compressed when frames are used: single outgoing frame,
+// space for incoming frames and unpacked data of current incoming frame
+const ULONG FRAME_SIZE = WIRE_FRAME_HEADER + WIRE_FRAME_PACKED;
+const ULONG FRAME_SEND_OFFSET = 0;
+const ULONG FRAME_RECV_OFFSET = FRAME_SIZE;
+const ULONG FRAME_RECV_SIZE = FRAME_SIZE * 2;
+const ULONG FRAME_OUT_OFFSET = FRAME_RECV_OFFSET + FRAME_RECV_SIZE;
+const ULONG FRAME_BUFFER_SIZE = FRAME_OUT_OFFSET + WIRE_FRAME_DATA;
+
+inline void putFrameWord(UCHAR* p, ULONG value)
+{
+	p[0] = (UCHAR) (value >> 8);
+	p[1] = (UCHAR) value;
+}
+
+inline ULONG getFrameWord(const UCHAR* p)
+{
+	return (p[0] << 8) | p[1];
+}
+
+// Returns length of the first frame in receive buffer or 0 if it's not received completely
+ULONG completeFrame(const rem_port* port)
+{
+	if (port->port_z_in_length < WIRE_FRAME_HEADER)
+		return 0;
+
+	const UCHAR* const frame = &port->port_compressed[FRAME_RECV_OFFSET];
+	const ULONG length = WIRE_FRAME_HEADER + getFrameWord(frame + 3);
+
+	return port->port_z_in_length >= length ? length : 0;
+}
+
+bool inflateFrames(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer,
+	SSHORT buffer_length, SSHORT* length)
+{
+	UCHAR* const input = &port->port_compressed[FRAME_RECV_OFFSET];
+	UCHAR* const output = &port->port_compressed[FRAME_OUT_OFFSET];
+
+	while (!port->port_z_out_length)
+	{
+		const ULONG frameLength = completeFrame(port);
+
+		if (frameLength)
+		{
+			const UCHAR method = input[0];
+			const ULONG rawLength = getFrameWord(input + 1);
+			const ULONG packedLength = frameLength - WIRE_FRAME_HEADER;
+			const UCHAR* const data = input + WIRE_FRAME_HEADER;
+
+			bool ok = rawLength <= WIRE_FRAME_DATA;
+			if (ok)
+			{
+				if (method == WIRE_FRAME_STORED)
+				{
+					ok = packedLength == rawLength;
+					if (ok)
+						memcpy(output, data, rawLength);
+				}
+				else
+				{
+					ok = method == port->port_z_codec->getMethod() &&
+						port->port_z_codec->unpack(data, packedLength, output, rawLength);
+				}
+			}
+
+			if (!ok)
+			{
+#ifdef COMPRESS_DEBUG
+				fprintf(stderr, "Invalid frame method %d length %u/%u\n", method, rawLength, packedLength);
+#endif
+				port->port_z_data = false;
+				return false;
+			}
+
+			port->port_z_out_offset = 0;
+			port->port_z_out_length = rawLength;
+
+			port->port_z_in_length -= frameLength;
+			if (port->port_z_in_length)
+				memmove(input, input + frameLength, port->port_z_in_length);
+
+			continue;
+		}
+
+		if (port->port_z_data)		// Was called from select_multi() but nothing unpacked
+		{
+			port->port_z_data = false;
+			return false;
+		}
+
+		if (port->port_z_in_length >= WIRE_FRAME_HEADER &&
+			getFrameWord(input + 3) > WIRE_FRAME_PACKED)
+		{
+			// Such frame never fits into receive buffer
+			port->port_z_data = false;
+			return false;
+		}
+
+		SSHORT l = (SSHORT) MIN(FRAME_RECV_SIZE - port->port_z_in_length, MAX_SSHORT);
+		if (!packet_receive(port, input + port->port_z_in_length, l, &l) || l <= 0)
+		{
+			port->port_z_data = false;
+			return false;
+		}
+
+		port->port_z_in_length += l;
+	}
+
+	const ULONG l = MIN(port->port_z_out_length, (ULONG) buffer_length);
+	memcpy(buffer, output + port->port_z_out_offset, l);
+	port->port_z_out_offset += l;
+	port->port_z_out_length -= l;
+	port->port_z_rcv_bytes += l;
+
+	*length = (SSHORT) l;
+	port->port_z_data = port->port_z_out_length || completeFrame(port);
+
+	return true;
+}
+
+bool deflateFrames(rem_port* port, PacketSend* packet_send, const UCHAR* data, ULONG length)
+{
+	UCHAR* const frame = &port->port_compressed[FRAME_SEND_OFFSET];
+
+	while (length)
+	{
+		const ULONG rawLength = MIN(length, WIRE_FRAME_DATA);
+		ULONG packedLength = 0;
+		UCHAR method = WIRE_FRAME_STORED;
+
+		// Don't waste CPU on small packets like op_response
+		if (rawLength >= port->port_z_threshold)
+		{
+			if (!port->port_z_codec->pack(data, rawLength, frame + WIRE_FRAME_HEADER, WIRE_FRAME_PACKED,
+					&packedLength))
+			{
+#ifdef COMPRESS_DEBUG
+				fprintf(stderr, "Frame pack error\n");
+#endif
+				return false;
+			}
+
+			if (packedLength)
+				method = port->port_z_codec->getMethod();
+		}
+
+		if (!packedLength)
+		{
+			memcpy(frame + WIRE_FRAME_HEADER, data, rawLength);
+			packedLength = rawLength;
+		}
+
+		frame[0] = method;
+		putFrameWord(frame + 1, rawLength);
+		putFrameWord(frame + 3, packedLength);
+
+#ifdef COMPRESS_DEBUG
+		fprintf(stderr, "Send frame method %d length %u/%u\n", method, rawLength, packedLength);
+#endif
+		if (!packet_send(port, (SCHAR*) frame, (SSHORT) (WIRE_FRAME_HEADER + packedLength)))
+			return false;
+
+		data += rawLength;
+		length -= rawLength;
+	}
+
+	return true;
+}
+
+} // anonymous namespace
 #endif // WIRE_COMPRESS_SUPPORT
 
 rem_port::~rem_port()
@@ -1396,7 +1667,7 @@ rem_port::~rem_port()
 #endif
 
 #ifdef WIRE_COMPRESS_SUPPORT
-	if (port_compressed)
+	if (port_compressed && !port_z_codec)
 	{
 		zlib().deflateEnd(&port_send_stream);
 		zlib().inflateEnd(&port_recv_stream);
@@ -1409,7 +1680,16 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 {
 #ifdef WIRE_COMPRESS_SUPPORT
 	if (!port->port_compressed)
-		return packet_receive(port, buffer, buffer_length, length);
+	{
+		if (!packet_receive(port, buffer, buffer_length, length))
+			return false;
+
+		port->port_z_rcv_bytes += *length;
+		return true;
+	}
+
+	if (port->port_z_codec)
+		return inflateFrames(port, packet_receive, buffer, buffer_length, length);
 
 	z_stream& strm = port->port_recv_stream;
 	strm.avail_out = buffer_length;
@@ -1472,6 +1752,7 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 	}
 
 	*length = (SSHORT) (buffer_length - strm.avail_out);
+	port->port_z_rcv_bytes += *length;
 	if (strm.avail_in)	// Z-buffer still has some data - probably can call inflate() once more on them
 		port->port_z_data = true;
 	else
@@ -1483,17 +1764,34 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 
 	return true;
 #else
-	return packet_receive(port, buffer, buffer_length, length);
+	if (!packet_receive(port, buffer, buffer_length, length))
+		return false;
+
+	port->port_z_rcv_bytes += *length;
+	return true;
 #endif
 }
 
 bool REMOTE_deflate(RemoteXdr* xdrs, ProtoWrite* proto_write, PacketSend* packet_send, bool flush)
 {
-#ifdef WIRE_COMPRESS_SUPPORT
 	rem_port* port = xdrs->x_public;
+	port->port_z_snd_bytes += xdrs->x_private - xdrs->x_base;
+
+#ifdef WIRE_COMPRESS_SUPPORT
 	if (!(port->port_compressed && (port->port_flags & PORT_compressed)))
 		return proto_write(xdrs);
 
+	if (port->port_z_codec)
+	{
+		if (!deflateFrames(port, packet_send, (UCHAR*) xdrs->x_base, xdrs->x_private - xdrs->x_base))
+			return false;
+
+		xdrs->x_private = xdrs->x_base;
+		xdrs->x_handy = port->port_buff_size;
+
+		return true;
+	}
+
 	z_stream& strm = port->port_send_stream;
 	strm.avail_in = xdrs->x_private - xdrs->x_base;
 	strm.next_in = (Bytef*) xdrs->x_base;
@@ -1570,11 +1868,29 @@ bool rem_port::checkCompression()
 #endif
 }
 
-void rem_port::initCompression()
+void rem_port::initCompression(USHORT type)
 {
 #ifdef WIRE_COMPRESS_SUPPORT
 	if (port_protocol >= PROTOCOL_VERSION13 && !port_compressed && zlib())
 	{
+		if (type & pflag_compress_frame)
+		{
+			if (type & pflag_compress_lz4)
+				port_z_codec = FB_NEW_POOL(getPool()) Lz4Codec;
+			else
+				port_z_codec = FB_NEW_POOL(getPool()) ZLibCodec;
+
+			port_z_threshold = getPortConfig()->getWireCompressionThreshold();
+			port_z_in_length = port_z_out_offset = port_z_out_length = 0;
+
+			port_compressed.reset(FB_NEW_POOL(getPool()) UCHAR[FRAME_BUFFER_SIZE]);
+
+#ifdef COMPRESS_DEBUG
+			fprintf(stderr, "Completed frames init port %p method %d\n", this, port_z_codec->getMethod());
+#endif
+			return;
+		}
+
 		port_send_stream.zalloc = Firebird::ZLib::allocFunc;
 		port_send_stream.zfree = Firebird::ZLib::freeFunc;
 		port_send_stream.opaque = Z_NULL;
@@ -1616,6 +1932,34 @@ void rem_port::initCompression()
 #endif
 }
 
+void rem_port::wireStats(FB_UINT64* stats) const
+{
+	// XNET does not pass data through REMOTE_deflate() / REMOTE_inflate()
+	const bool counted = port_type == INET;
+
+	stats[0] = counted ? port_z_snd_bytes : port_snd_bytes;
+	stats[1] = port_snd_bytes;
+	stats[2] = counted ? port_z_rcv_bytes : port_rcv_bytes;
+	stats[3] = port_rcv_bytes;
+	stats[4] = port_snd_packets;
+	stats[5] = port_snd_time;
+	stats[6] = port_rcv_packets;
+	stats[7] = port_rcv_time;
+}
+
+
+PortWaitTimer::PortWaitTimer(FB_UINT64& total)
+	: m_total(total), m_start(fb_utils::query_performance_counter())
+{ }
+
+PortWaitTimer::~PortWaitTimer()
+{
+	const SINT64 frequency = fb_utils::query_performance_frequency();
+	const SINT64 elapsed = fb_utils::query_performance_counter() - m_start;
+
+	m_total += elapsed / frequency * 1000000 + elapsed % frequency * 1000000 / frequency;
+}
+
 
 void InternalCryptKey::setSymmetric(Firebird::CheckStatusWrapper* status, const char* type,
 	unsigned keyLength, const void* key)
@@ -1067,6 +1067,41 @@ const USHORT PORT_released		= 0x2000;	// release(), complementary to the first a
 // forward decl
 class RemotePortGuard;
 
+#ifdef WIRE_COMPRESS_SUPPORT
+// Codec used to pack and unpack frames when framed wire compression is negotiated
+
+class WireCodec
+{
+public:
+	virtual ~WireCodec() { }
+
+	// Method stored in the frame header
+	virtual UCHAR getMethod() const = 0;
+
+	// When packedLength is set to 0 the frame should rather be sent stored
+	virtual bool pack(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength,
+		ULONG* packedLength) = 0;
+	virtual bool unpack(const UCHAR* from, ULONG fromLength, UCHAR* to, ULONG toLength) = 0;
+};
+#endif // WIRE_COMPRESS_SUPPORT
+
+// Number of values returned by rem_port::wireStats()
+const unsigned WIRE_STATS_COUNT = 8;
+
+// Accumulates the time (in microseconds) spent in its scope,
+// used to account network send and receive waits of the port
+
+class PortWaitTimer
+{
+public:
+	explicit PortWaitTimer(FB_UINT64& total);
+	~PortWaitTimer();
+
+private:
+	FB_UINT64& m_total;
+	SINT64 m_start;
+};
+
 // Port itself
 
 typedef rem_port* (*t_port_connect)(rem_port*, PACKET*);
@@ -1151,6 +1186,7 @@ struct rem_port : public Firebird::GlobalStorage, public Firebird::RefCounted
 	Firebird::string port_address;			// Protocol-specific address string for the port
 	Rpr*			port_rpr;				// port stored procedure reference
 	Rsr*			port_statement;			// Statement for execute immediate
+	Rsr*			port_pipelined_statement;	// Client statement with op_allocate_statement in flight
 	rmtque*			port_receive_rmtque;	// for client, responses waiting
 	Firebird::AtomicCounter	port_requests_queued;	// requests currently queued
 	xcc*			port_xcc;				// interprocess structure
@@ -1182,10 +1218,19 @@ struct rem_port : public Firebird::GlobalStorage, public Firebird::RefCounted
 	FB_UINT64 port_rcv_packets;
 	FB_UINT64 port_snd_bytes;
 	FB_UINT64 port_rcv_bytes;
+	FB_UINT64 port_z_snd_bytes;		// bytes sent before compression
+	FB_UINT64 port_z_rcv_bytes;		// bytes received after decompression
+	FB_UINT64 port_snd_time;		// microseconds spent sending packets
+	FB_UINT64 port_rcv_time;		// microseconds spent waiting for packets
 
 #ifdef WIRE_COMPRESS_SUPPORT
 	z_stream port_send_stream, port_recv_stream;
 	UCharArrayAutoPtr	port_compressed;
+	Firebird::AutoPtr<WireCodec> port_z_codec;	// frames codec, not used with plain zlib stream
+	ULONG			port_z_threshold;	// data smaller than it is sent in stored frames
+	ULONG			port_z_in_length;	// received but not unpacked frames data
+	ULONG			port_z_out_offset;	// unpacked frame data not passed to caller yet
+	ULONG			port_z_out_length;
 #endif
 
 public:
@@ -1213,7 +1258,7 @@ public:
 		port_connection(0), port_client_arch(arch_generic), port_login(getPool()),
 		port_user_name(getPool()), port_peer_name(getPool()),
 		port_protocol_id(getPool()), port_address(getPool()),
-		port_rpr(0), port_statement(0), port_receive_rmtque(0),
+		port_rpr(0), port_statement(0), port_pipelined_statement(0), port_receive_rmtque(0),
 		port_requests_queued(0), port_xcc(0), port_deferred_packets(0), port_last_object_id(0),
 		port_queue(getPool()), port_qoffset(0),
 		port_srv_auth(NULL), port_srv_auth_block(NULL),
@@ -1221,7 +1266,11 @@ public:
 		port_known_server_keys(getPool()), port_crypt_plugin(NULL),
 		port_client_crypt_callback(NULL), port_server_crypt_callback(NULL), port_crypt_name(getPool()),
 		port_replicator(NULL), port_buffer(FB_NEW_POOL(getPool()) UCHAR[rpt]),
-		port_snd_packets(0), port_rcv_packets(0), port_snd_bytes(0), port_rcv_bytes(0)
+		port_snd_packets(0), port_rcv_packets(0), port_snd_bytes(0), port_rcv_bytes(0),
+		port_z_snd_bytes(0), port_z_rcv_bytes(0), port_snd_time(0), port_rcv_time(0)
+#ifdef WIRE_COMPRESS_SUPPORT
+		, port_z_threshold(0), port_z_in_length(0), port_z_out_offset(0), port_z_out_length(0)
+#endif
 	{
 		addRef();
 		memset(&port_linger, 0, sizeof port_linger);
@@ -1243,13 +1292,14 @@ private:
 	friend class Firebird::RefPtr<rem_port>;
 
 public:
-	void initCompression();
+	void initCompression(USHORT type);
 	static bool checkCompression();
 	void linkParent(rem_port* const parent);
 	void unlinkParent();
 	Firebird::RefPtr<const Firebird::Config> getPortConfig();
 	const Firebird::RefPtr<const Firebird::Config>& getPortConfig() const;
 	void versionInfo(Firebird::string& version) const;
+	void wireStats(FB_UINT64* stats) const;
 
 	bool extractNewKeys(CSTRING* to, bool flagPlugList = false)
 	{
@@ -32,6 +32,7 @@
 #include "../common/os/path_utils.h"
 #include "../common/isc_proto.h"
 #include "../common/classes/ClumpletWriter.h"
+#include "../common/config/config.h"
 #include "../common/ThreadStart.h"
 #include "../common/utils_proto.h"
 #include "../common/classes/ParsedList.h"
@@ -75,6 +76,9 @@ namespace
 	const USHORT CTL_VERSION1 = 1;
 	const USHORT CTL_CURRENT_VERSION = CTL_VERSION1;
 
+	// Number of blocks applied in parallel between synchronization points
+	const ULONG PARALLEL_SYNC_INTERVAL = 1024;
+
 	volatile bool shutdownFlag = false;
 	AtomicCounter activeThreads;
 	Semaphore shutdownSemaphore;
@@ -373,6 +377,9 @@ namespace
 			dpb.insertString(isc_dpb_user_name, DBA_USER_NAME);
 			dpb.insertString(isc_dpb_config, ParsedList::getNonLoopbackProviders(m_config->dbName));
 
+			if (isParallel())
+				dpb.insertInt(isc_dpb_parallel_workers, (int) getParallelism());
+
 #ifndef NO_DATABASE
 			DispatcherPtr provider;
 			FbLocalStatus localStatus;
@@ -387,6 +394,10 @@ namespace
 			localStatus.check();
 			m_replicator.assignRefNoIncr(repl);
 
+			// Let the replica know that blocks may be applied asynchronously
+			if (isParallel())
+				synchronize(0, 0);
+
 			fb_assert(!m_sequence);
 
 			RefPtr<ITransaction> transaction(REF_NO_INCR,
@@ -432,6 +443,37 @@ namespace
 #endif
 		}
 
+		// Blocks are applied asynchronously until the synchronization point
+		void synchronize(FB_UINT64 sequence, ULONG offset)
+		{
+#ifndef NO_DATABASE
+			fb_assert(m_replicator);
+
+			Block block;
+			memset(&block, 0, sizeof(Block));
+			block.protocol = PROTOCOL_CURRENT_VERSION;
+			block.flags = BLOCK_SYNC_POINT;
+
+			FbLocalStatus localStatus;
+			m_replicator->process(&localStatus, sizeof(Block), (const UCHAR*) &block);
+			checkCompletion(localStatus, sequence, offset);
+#endif
+		}
+
+		// Replica uses no more workers than MaxParallelWorkers allows,
+		// otherwise the blocks are applied serially and progress is saved after every block
+
+		ULONG getParallelism() const
+		{
+			const auto maxWorkers = Firebird::Config::getMaxParallelWorkers();
+			return (maxWorkers > 0) ? MIN(m_config->applyParallelism, (ULONG) maxWorkers) : 1;
+		}
+
+		bool isParallel() const
+		{
+			return (getParallelism() > 1);
+		}
+
 		bool isShutdown() const
 		{
 			return (m_attachment == NULL);
@@ -560,8 +602,11 @@ namespace
 		if (strcmp(header->hdr_signature, CHANGELOG_SIGNATURE))
 			return false;
 
-		if (header->hdr_version != CHANGELOG_CURRENT_VERSION)
+		if (header->hdr_version < CHANGELOG_VERSION_1 ||
+			header->hdr_version > CHANGELOG_CURRENT_VERSION)
+		{
 			return false;
+		}
 
 		if (header->hdr_state != SEGMENT_STATE_FREE &&
 			header->hdr_state != SEGMENT_STATE_USED &&
@@ -828,7 +873,12 @@ namespace
 				if (memcmp(&header, &segment->header, sizeof(SegmentHeader)))
 					raiseError("Journal file %s was unexpectedly changed", segment->filename.c_str());
 
+				const bool parallel = target->isParallel();
+				ULONG pendingBlocks = 0;
+
 				ULONG totalLength = sizeof(SegmentHeader);
+				FB_UINT64 rawLength = totalLength;
+
 				while (totalLength < segment->header.hdr_length)
 				{
 					if (shutdownFlag)
@@ -854,13 +904,42 @@ namespace
 
 						replicate(target, transactions, sequence, totalLength,
 								  length, data, rewind);
+
+						// Compressed blocks are unpacked by the replica itself,
+						// here we only account their original size
+
+						if ((header.flags & BLOCK_COMPRESSED) && blockLength >= sizeof(ULONG))
+						{
+							ULONG orgLength;
+							memcpy(&orgLength, data + sizeof(Block), sizeof(ULONG));
+							rawLength += sizeof(Block) + orgLength;
+						}
+						else
+							rawLength += length;
 					}
+					else
+						rawLength += length;
 
 					totalLength += length;
 
+					// Progress of the parallel replication can be saved
+					// only after all the preceding blocks are applied
+
+					if (parallel)
+					{
+						if (++pendingBlocks < PARALLEL_SYNC_INTERVAL)
+							continue;
+
+						target->synchronize(sequence, totalLength);
+						pendingBlocks = 0;
+					}
+
 					control.savePartial(sequence, totalLength, transactions);
 				}
 
+				if (pendingBlocks)
+					target->synchronize(sequence, totalLength);
+
 				control.saveComplete(sequence, transactions);
 
 				file.release();
@@ -884,8 +963,19 @@ namespace
 					extra = "deleting";
 				}
 
-				target->verbose("Segment %" UQUADFORMAT " (%u bytes) is replicated in %s, %s",
-								sequence, totalLength, interval.c_str(), extra.c_str());
+				if (rawLength > totalLength)
+				{
+					target->verbose("Segment %" UQUADFORMAT " (%u bytes, %" UQUADFORMAT
+									" bytes uncompressed, ratio %.2lf) is replicated in %s, %s",
+									sequence, totalLength, rawLength,
+									(double) rawLength / totalLength,
+									interval.c_str(), extra.c_str());
+				}
+				else
+				{
+					target->verbose("Segment %" UQUADFORMAT " (%u bytes) is replicated in %s, %s",
+									sequence, totalLength, interval.c_str(), extra.c_str());
+				}
 
 				if (!oldest_sequence)
 					segment->remove();
@@ -742,7 +742,7 @@ public:
 				}
 
 				if (send->p_acpt.p_acpt_type & pflag_compress)
-					authPort->initCompression();
+					authPort->initCompression(send->p_acpt.p_acpt_type);
 				authPort->send(send);
 				if (send->p_acpt.p_acpt_type & pflag_compress)
 					authPort->port_flags |= PORT_compressed;
@@ -1955,7 +1955,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 	P_ARCH architecture = arch_generic;
 	USHORT version = 0;
 	USHORT type = 0;
-	bool compress = false;
+	USHORT compress = 0;
 	bool accepted = false;
 	USHORT weight = 0;
 	const p_cnct::p_cnct_repeat* protocol = connect->p_cnct_versions;
@@ -1965,7 +1965,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 	{
 		if ((protocol->p_cnct_version == PROTOCOL_VERSION10 ||
 			 (protocol->p_cnct_version >= PROTOCOL_VERSION11 &&
-			  protocol->p_cnct_version <= PROTOCOL_VERSION19)) &&
+			  protocol->p_cnct_version <= PROTOCOL_VERSION20)) &&
 			 (protocol->p_cnct_architecture == arch_generic ||
 			  protocol->p_cnct_architecture == ARCHITECTURE) &&
 			protocol->p_cnct_weight >= weight)
@@ -1975,7 +1975,8 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 			version = protocol->p_cnct_version;
 			architecture = protocol->p_cnct_architecture;
 			type = MIN(protocol->p_cnct_max_type & ptype_MASK, ptype_lazy_send);
-			compress = protocol->p_cnct_max_type & pflag_compress;
+			compress = (protocol->p_cnct_max_type & pflag_compress) ?
+				protocol->p_cnct_max_type & (pflag_compress | pflag_compress_frame | pflag_compress_lz4) : 0;
 		}
 	}
 
@@ -1984,7 +1985,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 
 	send->p_acpd.p_acpt_version = port->port_protocol = version;
 	send->p_acpd.p_acpt_architecture = architecture;
-	send->p_acpd.p_acpt_type = type | (compress ? pflag_compress : 0);
+	send->p_acpd.p_acpt_type = type | compress;
 #ifdef TRUSTED_AUTH
 	send->p_acpd.p_acpt_type |= pflag_win_sspi_nego;
 #endif
@@ -1992,7 +1993,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 
 	send->p_acpt.p_acpt_version = port->port_protocol = version;
 	send->p_acpt.p_acpt_architecture = architecture;
-	send->p_acpt.p_acpt_type = type | (compress ? pflag_compress : 0);
+	send->p_acpt.p_acpt_type = type | compress;
 
 	// modify the version string to reflect the chosen protocol
 	string buffer;
@@ -2186,7 +2187,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 
 	send->p_operation = returnData ? op_accept_data : op_accept;
 	if (send->p_acpt.p_acpt_type & pflag_compress)
-		port->initCompression();
+		port->initCompression(send->p_acpt.p_acpt_type);
 	port->send(send);
 	if (send->p_acpt.p_acpt_type & pflag_compress)
 		port->port_flags |= PORT_compressed;
@@ -2215,7 +2216,7 @@ void ConnectAuth::accept(PACKET* send, Auth::WriterImplementation*)
 		authPort->extractNewKeys(s);
 		send->p_acpd.p_acpt_authenticated = 1;
 		if (send->p_acpt.p_acpt_type & pflag_compress)
-			authPort->initCompression();
+			authPort->initCompression(send->p_acpt.p_acpt_type);
 		authPort->send(send);
 		if (send->p_acpt.p_acpt_type & pflag_compress)
 			authPort->port_flags |= PORT_compressed;
@@ -2263,6 +2264,9 @@ static ISC_STATUS allocate_statement( rem_port* port, /*P_RLSE* allocate,*/ PACK
 
 	if (bad_db(&status_vector, rdb))
 	{
+		// Don't let the pipelined packets reach the previously allocated object
+		port->port_last_object_id = INVALID_OBJECT;
+
 		return port->send_response(send, 0, 0, &status_vector, true);
 	}
 
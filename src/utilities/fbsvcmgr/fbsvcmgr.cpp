@@ -518,6 +518,7 @@ const SvcSwitches statisticsOptions[] =
 	{"sts_idx_pages", putOption, 0, isc_spb_sts_idx_pages, 0},
 	{"sts_sys_relations", putOption, 0, isc_spb_sts_sys_relations, 0},
 	{"sts_encryption", putOption, 0, isc_spb_sts_encryption, 0},
+	{"sts_io_stats", putOption, 0, isc_spb_sts_io_stats, 0},
 	{0, 0, 0, 0, 0}
 };
 
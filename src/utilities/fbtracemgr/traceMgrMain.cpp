@@ -34,6 +34,7 @@
 #include "../../common/utils_proto.h"
 #include "../../common/os/os_utils.h"
 #include "../../jrd/trace/TraceService.h"
+#include "../../jrd/trace/TraceBinaryLog.h"
 #include "../ibase.h"
 
 #ifdef HAVE_LOCALE_H
@@ -225,6 +226,10 @@ void TraceSvcUtil::runService(size_t spbSize, const UCHAR* spb)
 
 	const USHORT sendSize = (p - send);
 
+	// binary trace records are formatted here
+	Jrd::TraceBinaryDecoder decoder(*getDefaultMemoryPool());
+	string text;
+
 	char results[MAXBUF];
 	bool noData;
 	do
@@ -256,10 +261,9 @@ void TraceSvcUtil::runService(size_t spbSize, const UCHAR* spb)
 					p += sizeof(l);
 					if (l)
 					{
-						const char ch = p[l];
-						p[l] = 0;
-						fprintf(stdout, "%s", p);
-						p[l] = ch;
+						decoder.decode(p, l, text);
+						fwrite(text.c_str(), 1, text.length(), stdout);
+						text.erase();
 						p += l;
 						dirty = true;
 					}
@@ -51,6 +51,9 @@ const int IN_SW_DBA_FETCH_PASS		= 14;	// fetch password from file
 const int IN_SW_DBA_ENCRYPTION		= 15;	// analyze pages encryption
 const int IN_SW_DBA_HELP			= 16;	// show help
 const int IN_SW_DBA_ROLE			= 17;	// SQL role
+const int IN_SW_DBA_SAMPLE			= 18;	// analyze a sample of pages
+const int IN_SW_DBA_IO_STATS		= 19;	// print file I/O latencies
+const int IN_SW_DBA_PARALLEL		= 20;	// analyze by parallel readers
 
 const static struct Switches::in_sw_tab_t dba_in_sw_table[] =
 {
@@ -59,15 +62,18 @@ const static struct Switches::in_sw_tab_t dba_in_sw_table[] =
     {IN_SW_DBA_ENCRYPTION,		isc_spb_sts_encryption,	  "ENCRYPTION",	0,0,0,	false,	true,	51,	1, NULL},	// msg 51: -e      analyze database encryption
     {IN_SW_DBA_HEADER,			isc_spb_sts_hdr_pages,		"HEADER",	0,0,0,	false,	true,	24,	1, NULL},	// msg 24: -h      analyze header page
     {IN_SW_DBA_INDEX,			isc_spb_sts_idx_pages,		"INDEX",	0,0,0,	false,	true,	25,	1, NULL},	// msg 25: -i      analyze index leaf pages
+    {IN_SW_DBA_IO_STATS,		isc_spb_sts_io_stats,		"IO",		0,0,0,	false,	true,	65,	2, NULL},	// msg 65: -io     print file I/O latencies
 //  {IN_SW_DBA_LOG,				isc_spb_sts_db_log,			"LOG",		0,0,0,	false,	true,	26,	1, NULL},	// msg 26: -l      analyze log page
     {IN_SW_DBA_SYSTEM,			isc_spb_sts_sys_relations,	"SYSTEM",	0,0,0,	false,	true,	27,	1, NULL},	// msg 27: -s      analyze system relations
     {IN_SW_DBA_USERNAME,		0,							"USERNAME",	0,0,0,	false,	false,	32,	1, NULL},	// msg 32: -u      username
+    {IN_SW_DBA_PARALLEL,		0,							"PARALLEL",	0,0,0,	false,	false,	73,	3, NULL},	// msg 73: -par    analyze by parallel readers
     {IN_SW_DBA_PASSWORD,		0,							"PASSWORD",	0,0,0,	false,	false,	33,	1, NULL},	// msg 33: -p      password
     {IN_SW_DBA_FETCH_PASS,		0,					"FETCH_PASSWORD",	0,0,0,	false,	false,	37,	2, NULL},	// msg 37: -fetch  fetch password from file
     {IN_SW_DBA_RECORD,			isc_spb_sts_record_versions,"RECORD",	0,0,0,	false,	true,	34,	1, NULL},	// msg 34: -r      analyze average record and version length
     {IN_SW_DBA_RELATION,		isc_spb_sts_table,			"TABLE",	0,0,0,	false,	false,	35,	1, NULL},	// msg 35: -t      tablename
     {IN_SW_DBA_RELATION,		isc_spb_sts_table,			"TABLE",	0,0,0,	false,	true,	0,	1, NULL},	// no msg: let run old buggy code
     {IN_SW_DBA_ROLE,			0,							"ROLE",		0,0,0,	false,	false,	57,	1, NULL},	// msg 57: -role   SQL role name
+    {IN_SW_DBA_SAMPLE,			0,							"SAMPLE",	0,0,0,	false,	false,	63,	2, NULL},	// msg 63: -sample analyze percentage of pages
 	// special switch to avoid including creation date, only for tests (no message)
     {IN_SW_DBA_NOCREATION,		isc_spb_sts_nocreation,	"NOCREATION",	0,0,0,	false,	true,	0,	1, NULL},	// msg (ignored) -n suppress creation date
 #ifdef TRUSTED_AUTH
@@ -256,6 +256,12 @@ const char localhost[] = "localhost";
 const char backup_signature[4] = {'N','B','A','K'};
 const SSHORT BACKUP_VERSION = 2;
 
+// Adjacent pages are read from the database using a single call
+const ULONG MAX_RUN_SIZE = 1024 * 1024;
+// Unchanged pages between changed ones are read rather than skipped
+// if there are no more than this number of them
+const ULONG MAX_RUN_GAP = 8;
+
 struct inc_header
 {
 	char signature[4];		// 'NBAK'
@@ -1433,6 +1439,27 @@ void NBackup::backup_database(int level, const string& guidStr, const PathName&
 		Ods::scns_page* scns_buf = reinterpret_cast<Ods::scns_page*>
 			(scns_buffer.getAlignedBuffer(header->hdr_page_size, ioBlockSize));
 
+		// Pages to be copied are read in runs of adjacent pages. For incremental
+		// backup the changed pages are known from the SCN pages maintained
+		// by the engine, thus the database is scanned using a few large reads.
+
+		const ULONG pageSize = header->hdr_page_size;
+		const ULONG maxRunPages = MAX(MAX_RUN_SIZE / pageSize, 1u);
+
+		Array<UCHAR> run_buffer;
+		UCHAR* const run_data = run_buffer.getAlignedBuffer(maxRunPages * pageSize, ioBlockSize);
+		ULONG runStart = 0, runPages = 0;
+
+		// Whether the page is changed, as far as known from the current SCN page
+		auto isChanged = [&](ULONG page) -> bool
+		{
+			if (!level || !scns)
+				return true;
+
+			const ULONG slot = scnsSlot + (page - curPage);
+			return (slot >= pagesPerSCN || scns->scn_pages[slot] > prev_scn);
+		};
+
 		while (true)
 		{
 			if (curPage && page_buff->pag_scn > backup_scn)
@@ -1469,7 +1496,6 @@ void NBackup::backup_database(int level, const string& guidStr, const PathName&
 						curPage == nextSCN ||
 						curPage == lastPage)
 					{
-						seek_file(dbase, (SINT64) curPage * header->hdr_page_size);
 						break;
 					}
 				}
@@ -1488,13 +1514,44 @@ void NBackup::backup_database(int level, const string& guidStr, const PathName&
 				curPage++;
 
 
-			const FB_SIZE_T bytesDone = read_file(dbase, page_buff, header->hdr_page_size);
+			if (curPage < runStart || curPage >= runStart + runPages)
+			{
+				// Collect the following pages to be copied. Pages after the next
+				// SCN or PIP page are unknown until that page is processed.
+
+				ULONG nextSCN = MAX_ULONG;
+				if (level)
+					nextSCN = scns ? (scns->scn_sequence + 1) * pagesPerSCN : MAX(curPage, FIRST_SCN_PAGE);
+
+				ULONG count = 1;
+				for (ULONG page = curPage + 1, gap = 0;
+					 page - curPage < maxRunPages && page <= lastPage && page <= nextSCN;
+					 page++)
+				{
+					if (isChanged(page) || page == nextSCN || page == lastPage)
+					{
+						count = page - curPage + 1;
+						gap = 0;
+					}
+					else if (++gap > MAX_RUN_GAP)
+						break;
+				}
+
+				seek_file(dbase, (SINT64) curPage * pageSize);
+				const FB_SIZE_T bytesDone = read_file(dbase, run_data, count * pageSize);
+
+				runStart = curPage;
+				runPages = bytesDone / pageSize;
+				page_reads += runPages;
+
+				if (bytesDone == 0)
+					break;
+				if (!runPages)
+					status_exception::raise(Arg::Gds(isc_nbackup_dbsize_inconsistent));
+			}
+
+			memcpy(page_buff, run_data + (curPage - runStart) * pageSize, pageSize);
 			--db_size;
-			page_reads++;
-			if (bytesDone == 0)
-				break;
-			if (bytesDone != header->hdr_page_size)
-				status_exception::raise(Arg::Gds(isc_nbackup_dbsize_inconsistent));
 
 			if (level && page_buff->pag_type == pag_scns)
 			{
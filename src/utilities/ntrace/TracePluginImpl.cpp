@@ -31,6 +31,7 @@
 
 #include "TracePluginImpl.h"
 #include "PluginLogWriter.h"
+#include "../../jrd/trace/TraceBinaryLog.h"
 #include "os/platform.h"
 #include "firebird/impl/consts_pub.h"
 #include "../../common/isc_f_proto.h"
@@ -93,6 +94,7 @@ TracePluginImpl::TracePluginImpl(IPluginBase* plugin,
 	session_name(*getDefaultMemoryPool()),
 	logWriter(initInfo->getLogWriter()),
 	config(configuration),
+	logFormat(lfText),
 	record(*getDefaultMemoryPool()),
 	connections(getDefaultMemoryPool()),
 	transactions(getDefaultMemoryPool()),
@@ -173,6 +175,18 @@ TracePluginImpl::TracePluginImpl(IPluginBase* plugin,
 	if (!config.exclude_gds_codes.isEmpty())
 		str2Array(config.exclude_gds_codes, exclude_codes);
 
+	ConfigFile::String format(config.log_format);
+	format.upper();
+
+	if (format == "BINARY")
+		logFormat = lfBinary;
+	else if (format != "TEXT")
+	{
+		fatal_exception::raiseFmt(
+			"unknown log format \"%s\", \"text\" or \"binary\" is expected",
+			config.log_format.c_str());
+	}
+
 	operational = true;
 	log_init();
 }
@@ -260,19 +274,39 @@ void TracePluginImpl::logRecord(const char* action)
 	// We use atomic file appends for logging. Do not try to break logging
 	// to multiple separate file operations
 	const Firebird::TimeStamp stamp(Firebird::TimeStamp::getCurrentTimeStamp());
-	struct tm times;
-	stamp.decode(&times);
 
-	char buffer[100];
-	SNPRINTF(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%04d (%d:%p) %s" NEWLINE,
-		times.tm_year + 1900, times.tm_mon + 1, times.tm_mday, times.tm_hour,
-		times.tm_min, times.tm_sec, (int) (stamp.value().timestamp_time % ISC_TIME_SECONDS_PRECISION),
-		get_process_id(), this, action);
+	if (logFormat == lfBinary)
+	{
+		// Leave the formatting of the record header to the decoder
+		TraceBinaryHeader header;
+		header.actionLength = (USHORT) MIN(strlen(action), MAX_USHORT);
+		header.length = TraceBinaryHeader::SIZE + header.actionLength + record.length();
+		header.timestamp = stamp.value();
+		header.processId = get_process_id();
+		header.objectId = (IPTR) this;
 
-	record.insert(0, buffer);
-	record.append(NEWLINE);
-	// TODO: implement adjusting of line breaks
-	// line.adjustLineBreaks();
+		UCHAR buffer[TraceBinaryHeader::SIZE];
+		header.put(buffer);
+
+		record.insert(0, action, header.actionLength);
+		record.insert(0, reinterpret_cast<const char*>(buffer), sizeof(buffer));
+	}
+	else
+	{
+		struct tm times;
+		stamp.decode(&times);
+
+		char buffer[100];
+		SNPRINTF(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%04d (%d:%p) %s" NEWLINE,
+			times.tm_year + 1900, times.tm_mon + 1, times.tm_mday, times.tm_hour,
+			times.tm_min, times.tm_sec, (int) (stamp.value().timestamp_time % ISC_TIME_SECONDS_PRECISION),
+			get_process_id(), this, action);
+
+		record.insert(0, buffer);
+		record.append(NEWLINE);
+		// TODO: implement adjusting of line breaks
+		// line.adjustLineBreaks();
+	}
 
 	LocalStatus ls;
 	CheckStatusWrapper status(&ls);
@@ -661,6 +695,55 @@ void TracePluginImpl::appendGlobalCounts(const PerformanceInfo* info)
 	}
 
 	record.append(NEWLINE);
+
+	const ntrace_counter_t hits = info->pin_counters[PerformanceInfo::FUNCTION_CACHE_HITS];
+	const ntrace_counter_t misses = info->pin_counters[PerformanceInfo::FUNCTION_CACHE_MISSES];
+
+	if (hits || misses)
+	{
+		temp.printf("function cache: %" QUADFORMAT"d hit(s), %" QUADFORMAT"d miss(es)",
+			hits, misses);
+		record.append(temp);
+		record.append(NEWLINE);
+	}
+
+	if (!config.print_waits)
+		return;
+
+	static const struct
+	{
+		PerformanceInfo::WaitCounters counter;
+		const char* name;
+	} waits[] =
+	{
+		{PerformanceInfo::PAGE_READ_WAITS, "page read"},
+		{PerformanceInfo::PAGE_WRITE_WAITS, "page write"},
+		{PerformanceInfo::PAGE_LATCH_WAITS, "page latch"},
+		{PerformanceInfo::LOCK_DATABASE_WAITS, "database lock"},
+		{PerformanceInfo::LOCK_METADATA_WAITS, "metadata lock"},
+		{PerformanceInfo::LOCK_BUFFER_WAITS, "buffer lock"},
+		{PerformanceInfo::LOCK_TRANSACTION_WAITS, "transaction lock"},
+		{PerformanceInfo::RECORD_CONFLICT_WAITS, "record conflict"},
+		{PerformanceInfo::GARBAGE_COLLECT_WAITS, "garbage collection"},
+		{PerformanceInfo::BACKOUT_WAITS, "backout"},
+		{PerformanceInfo::SORT_SPILL_WAITS, "sort spill"}
+	};
+
+	bool first = true;
+
+	for (const auto& wait : waits)
+	{
+		if ((cnt = info->pin_counters[wait.counter]) == 0)
+			continue;
+
+		temp.printf("%s%s: %" QUADFORMAT"d wait(s), %" QUADFORMAT"d us",
+			first ? "" : ", ", wait.name, cnt, info->pin_counters[wait.counter + 1]);
+		record.append(temp);
+		first = false;
+	}
+
+	if (!first)
+		record.append(NEWLINE);
 }
 
 void TracePluginImpl::appendTableCounts(const PerformanceInfo *info)
@@ -154,6 +154,7 @@ private:
 	Firebird::string session_name;		// trace session name, set by Firebird
 	Firebird::ITraceLogWriter* logWriter;
 	TracePluginConfig config;	// Immutable, thus thread-safe
+	LogFormat logFormat;
 	Firebird::string record;
 
 	// Data for currently active connections, transactions, statements
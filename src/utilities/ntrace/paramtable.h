@@ -42,6 +42,7 @@ STR_PARAMETER(exclude_gds_codes, "")
 BOOL_PARAMETER(log_initfini, true)
 BOOL_PARAMETER(enabled, false)
 UINT_PARAMETER(max_log_size, 0)
+STR_PARAMETER(log_format, "text")
 
 #ifdef DATABASE_PARAMS
 BOOL_PARAMETER(log_connections, false)
@@ -63,6 +64,7 @@ BOOL_PARAMETER(log_trigger_finish, false)
 BOOL_PARAMETER(print_plan, false)
 BOOL_PARAMETER(explain_plan, false)
 BOOL_PARAMETER(print_perf, false)
+BOOL_PARAMETER(print_waits, false)
 BOOL_PARAMETER(log_context, false)
 BOOL_PARAMETER(log_blr_requests, false)
 BOOL_PARAMETER(print_blr, false)
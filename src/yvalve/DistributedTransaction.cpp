@@ -35,13 +35,172 @@
 #include "../common/classes/ClumpletReader.h"
 #include "firebird/impl/inf_pub.h"
 #include "../common/isc_proto.h"
+#include "../common/status.h"
+#include "../common/Task.h"
+#include "../common/utils_proto.h"
 #include "../jrd/acl.h"
 
+#include <atomic>
+
 using namespace Firebird;
 using namespace Why;
 
 namespace {
 
+// Runs prepare or commit of all sub-transactions concurrently. Each of them
+// typically costs a network round trip plus fsync at the database side, with
+// sequential loop the costs are summed up. Like the sequential loop, prepare
+// stops at the first failure - sub-transactions not started yet are skipped.
+
+class SubTransactionTask final : public Task
+{
+public:
+	enum Operation {PREPARE, COMMIT};
+
+	SubTransactionTask(MemoryPool& pool, Operation op, ITransaction* const* sub, unsigned count,
+			unsigned msgLength = 0, const unsigned char* message = NULL)
+		: m_items(pool),
+		  m_operation(op),
+		  m_msgLength(msgLength),
+		  m_message(message),
+		  m_next(0),
+		  m_failed(false)
+	{
+		for (unsigned i = 0; i < count; ++i)
+		{
+			if (sub[i])
+				m_items.add(FB_NEW_POOL(pool) Item(this, i, sub[i]));
+		}
+	}
+
+	~SubTransactionTask()
+	{
+		for (Item** p = m_items.begin(); p < m_items.end(); p++)
+			delete *p;
+	}
+
+	bool handler(WorkItem& _item) override
+	{
+		Item& item = static_cast<Item&>(_item);
+
+		switch (m_operation)
+		{
+		case PREPARE:
+			item.m_transaction->prepare(&item.m_status, m_msgLength, m_message);
+			break;
+
+		case COMMIT:
+			item.m_transaction->commit(&item.m_status);
+			break;
+		}
+
+		if (item.m_status->getState() & IStatus::STATE_ERRORS)
+			m_failed = true;
+
+		item.m_done = true;
+		return true;
+	}
+
+	bool getWorkItem(WorkItem** pItem) override
+	{
+		if (m_operation == PREPARE && m_failed)
+			return false;
+
+		const FB_SIZE_T n = (FB_SIZE_T) m_next.exchangeAdd(1);
+		if (n >= m_items.getCount())
+			return false;
+
+		*pItem = m_items[n];
+		return true;
+	}
+
+	// Returns error of the first failed sub-transaction - the same one sequential loop would report,
+	// and warnings of all of them
+	bool getResult(IStatus* status) override
+	{
+		const Item* failed = NULL;
+		HalfStaticArray<ISC_STATUS, ISC_STATUS_LENGTH> warnings;
+
+		for (Item** p = m_items.begin(); p < m_items.end(); p++)
+		{
+			const unsigned state = (*p)->m_status->getState();
+
+			if (!failed && (state & IStatus::STATE_ERRORS))
+				failed = *p;
+
+			if (state & IStatus::STATE_WARNINGS)
+			{
+				const ISC_STATUS* const w = (*p)->m_status->getWarnings();
+				warnings.add(w, fb_utils::statusLength(w));
+			}
+		}
+
+		if (status)
+		{
+			status->init();
+
+			if (failed)
+				status->setErrors(failed->m_status->getErrors());
+
+			if (warnings.hasData())
+			{
+				warnings.add(isc_arg_end);
+				status->setWarnings(warnings.begin());
+			}
+		}
+
+		return !failed;
+	}
+
+	int getMaxWorkers() override
+	{
+		return MIN(m_items.getCount(), MAX_WORKERS);
+	}
+
+	bool isCompleted(unsigned index) const
+	{
+		for (Item* const* p = m_items.begin(); p < m_items.end(); p++)
+		{
+			if ((*p)->m_index == index)
+				return (*p)->m_done && !((*p)->m_status->getState() & IStatus::STATE_ERRORS);
+		}
+
+		return false;
+	}
+
+	void run(MemoryPool& pool)
+	{
+		Coordinator coord(&pool);
+		coord.runSync(this);
+	}
+
+private:
+	class Item : public Task::WorkItem
+	{
+	public:
+		Item(SubTransactionTask* task, unsigned index, ITransaction* transaction)
+			: Task::WorkItem(task),
+			  m_index(index),
+			  m_transaction(transaction),
+			  m_done(false)
+		{ }
+
+		const unsigned m_index;
+		ITransaction* const m_transaction;
+		FbLocalStatus m_status;
+		bool m_done;
+	};
+
+	static const unsigned MAX_WORKERS = 32;
+
+	HalfStaticArray<Item*, 8> m_items;
+	const Operation m_operation;
+	const unsigned m_msgLength;
+	const unsigned char* const m_message;
+	AtomicCounter m_next;
+	std::atomic<bool> m_failed;
+};
+
 class DTransaction final : public RefCntIface<ITransactionImpl<DTransaction, CheckStatusWrapper> >
 {
 public:
@@ -224,15 +383,26 @@ void DTransaction::prepare(CheckStatusWrapper* status,
 			message = tdr.begin();
 		}
 
-		for (unsigned int i = 0; i < sub.getCount(); ++i)
+		SubTransactionTask task(getPool(), SubTransactionTask::PREPARE,
+			sub.begin(), sub.getCount(), msgLength, message);
+		task.run(getPool());
+
+		if (!task.getResult(status))
 		{
-			if (sub[i])
+			// Do not leave already prepared sub-transactions in limbo
+			for (unsigned int i = 0; i < sub.getCount(); ++i)
 			{
-				sub[i]->prepare(status, msgLength, message);
+				if (sub[i] && task.isCompleted(i))
+				{
+					FbLocalStatus localStatus;
+					sub[i]->rollback(&localStatus);
 
-				if (status->getState() & IStatus::STATE_ERRORS)
-					return;
+					if (!(localStatus->getState() & IStatus::STATE_ERRORS))
+						sub[i] = NULL;
+				}
 			}
+
+			return;
 		}
 
 		limbo = true;
@@ -258,17 +428,17 @@ void DTransaction::internalCommit(CheckStatusWrapper* status)
 		{	// guard scope
 			WriteLockGuard guard(rwLock, FB_FUNCTION);
 
+			SubTransactionTask task(getPool(), SubTransactionTask::COMMIT, sub.begin(), sub.getCount());
+			task.run(getPool());
+
+			// Committed sub-transactions are gone, failed ones stay in limbo
 			for (unsigned int i = 0; i < sub.getCount(); ++i)
 			{
-				if (sub[i])
-				{
-					sub[i]->commit(status);
-					if (status->getState() & IStatus::STATE_ERRORS)
-						return;
-
+				if (sub[i] && task.isCompleted(i))
 					sub[i] = NULL;
-				}
 			}
+
+			task.getResult(status);
 		}
 	}
 	catch (const Exception& ex)